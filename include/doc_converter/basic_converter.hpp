@@ -9,16 +9,21 @@
  * - 支持基本的文档转换
  * - 维护转换器名称和支持的格式
  * - 提供基本的转换逻辑
+ *
+ * 输出经 OutputSink 写出：写文件时使用带大缓冲区的 FileSink，也可以写入内存或 NullSink。
  */
 
 #pragma once
 
 #include "document.hpp"
 #include "document_elements.hpp"
+#include "element_cursor.hpp"
+#include "flat_document.hpp"
+#include "output_sink.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
-#include <fstream>
 
 namespace doc_converter {
 
@@ -38,52 +43,123 @@ public:
     BasicConverter(const std::string& name, const std::vector<std::string>& supportedFormats)
         : name_(name), supportedFormats_(supportedFormats) {}
 
+    using Converter::convert;
+
+    /**
+     * @brief 转换文档并写入输出层
+     * @param doc 要转换的文档
+     * @param sink 输出层
+     * @return bool 转换是否成功
+     *
+     * 目前仅支持简单的文本输出。写入文件时使用 convert(const Document&, const std::string&)。
+     */
+    bool convert(const Document& doc, OutputSink& sink) override {
+        try {
+            // 写入标题
+            sink << doc.getTitle() << "\n\n";
+
+            // 写入文档元素
+            TextWriter writer(sink);
+            doc.visitElements(writer);
+
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    /**
+     * @brief 边加载边转换文档
+     * @param cursor 正在加载的文档的元素游标
+     * @param outputPath 输出文件路径
+     * @return bool 加载和转换是否都成功
+     */
+    bool convert(ElementCursor& cursor, const std::string& outputPath) override {
+        try {
+            FileSink sink(outputPath);
+            bool converted = convert(cursor, sink);
+            sink.close();
+            return converted;
+        } catch (...) {
+            cursor.finish();
+            return false;
+        }
+    }
+
+    /**
+     * @brief 边加载边转换文档并写入输出层
+     * @param cursor 正在加载的文档的元素游标
+     * @param sink 输出层
+     * @return bool 加载和转换是否都成功
+     *
+     * 输出与 convert(const Document&, ...) 相同，每拿到一个元素就写出，不等待解析结束。
+     */
+    bool convert(ElementCursor& cursor, OutputSink& sink) override {
+        try {
+            // 写入标题
+            sink << cursor.getTitle() << "\n\n";
+
+            // 写入文档元素
+            TextWriter writer(sink);
+            while (auto element = cursor.next()) {
+                element->accept(writer);
+            }
+
+            return cursor.finish();
+        } catch (...) {
+            cursor.finish();
+            return false;
+        }
+    }
+
     /**
-     * @brief 转换文档
+     * @brief 转换列式文档
      * @param doc 要转换的文档
      * @param outputPath 输出文件路径
      * @return bool 转换是否成功
-     * 
-     * 目前仅支持简单的文本输出，将文档内容写入文本文件。
      */
-    bool convert(const Document& doc, const std::string& outputPath) override {
+    bool convert(const FlatDocument& doc, const std::string& outputPath) {
         try {
-            std::ofstream file(outputPath);
-            if (!file.is_open()) {
+            FileSink sink(outputPath);
+            if (!convert(doc, sink)) {
                 return false;
             }
+            sink.close();
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
 
+    /**
+     * @brief 转换列式文档并写入输出层
+     * @param doc 要转换的文档
+     * @param sink 输出层
+     * @return bool 转换是否成功
+     *
+     * 输出与 convert(const Document&, ...) 相同，按顺序扫描 FlatDocument 的连续数组。
+     */
+    bool convert(const FlatDocument& doc, OutputSink& sink) {
+        try {
             // 写入标题
-            file << doc.getTitle() << "\n\n";
+            sink << doc.getTitle() << "\n\n";
 
             // 写入文档元素
-            for (const auto& element : doc.getElements()) {
-                switch (element->getType()) {
-                    case ElementType::Heading: {
-                        auto heading = std::dynamic_pointer_cast<HeadingElement>(element);
-                        if (heading) {
-                            file << std::string(heading->getLevel(), '#') << " "
-                                 << heading->getText() << "\n\n";
-                        }
+            for (const auto& element : doc) {
+                switch (element.type()) {
+                    case ElementType::Heading:
+                        sink.fill('#', static_cast<size_t>(element.headingLevel()));
+                        sink << ' ' << element.text() << "\n\n";
                         break;
-                    }
-                    case ElementType::Paragraph: {
-                        auto para = std::dynamic_pointer_cast<ParagraphElement>(element);
-                        if (para) {
-                            for (const auto& text : para->getTexts()) {
-                                file << text->getText() << " ";
-                            }
-                            file << "\n\n";
+                    case ElementType::Paragraph:
+                        for (std::string_view text : element.runs()) {
+                            sink << text << ' ';
                         }
+                        sink << "\n\n";
                         break;
-                    }
-                    case ElementType::Text: {
-                        auto text = std::dynamic_pointer_cast<TextElement>(element);
-                        if (text) {
-                            file << text->getText() << "\n\n";
-                        }
+                    case ElementType::Text:
+                        sink << element.text() << "\n\n";
                         break;
-                    }
                     default:
                         break;
                 }
@@ -112,6 +188,35 @@ public:
     }
 
 private:
+    /**
+     * @brief 把元素写成纯文本的访问者
+     */
+    class TextWriter : public ElementVisitor {
+    public:
+        explicit TextWriter(OutputSink& out) : out_(out) {}
+
+        using ElementVisitor::visit;
+
+        void visit(const HeadingElement& heading) override {
+            out_.fill('#', static_cast<size_t>(heading.getLevel()));
+            out_ << ' ' << heading.getText() << "\n\n";
+        }
+
+        void visit(const ParagraphElement& para) override {
+            for (std::string_view text : para.getTexts()) {
+                out_ << text << ' ';
+            }
+            out_ << "\n\n";
+        }
+
+        void visit(const TextElement& text) override {
+            out_ << text.getText() << "\n\n";
+        }
+
+    private:
+        OutputSink& out_;
+    };
+
     std::string name_;                                      ///< 转换器名称
     std::vector<std::string> supportedFormats_;            ///< 支持的格式列表
 };
@@ -14,11 +14,15 @@
 #pragma once
 
 #include "document.hpp"
+#include "document_builder.hpp"
 #include "document_elements.hpp"
+#include "element_arena.hpp"
+#include "logger.hpp"
+#include "mapped_file.hpp"
+#include <cstring>
 #include <string>
 #include <vector>
 #include <memory>
-#include <fstream>
 
 namespace doc_converter {
 
@@ -42,29 +46,56 @@ public:
      * @return bool 加载是否成功
      * 
      * 目前仅支持简单的文本文件，每行作为一个段落。
-     * 第一行作为文档标题。
+     * 第一行作为文档标题。超出内存预算时返回 false。
      */
     bool loadFromFile(const std::string& filePath) override {
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
+        if (storage_ == ElementStorage::Arena && !arena_) {
+            arena_ = std::make_shared<ElementArena>();
+        }
+
+        MappedFile file;
+        try {
+            file = MappedFile(filePath);
+        } catch (const std::exception&) {
             return false;
         }
 
-        // 读取第一行作为标题
-        std::string line;
-        if (std::getline(file, line)) {
-            title_ = line;
-            auto heading = std::make_shared<HeadingElement>(line, 1);
-            elements_.push_back(heading);
+        std::unique_ptr<MemoryBudget> budget;
+        if (memoryBudget_ > 0) {
+            budget = std::make_unique<MemoryBudget>(memoryBudget_, getMemoryUsage().total());
         }
 
-        // 读取剩余行作为段落
-        while (std::getline(file, line)) {
-            if (!line.empty()) {
-                auto paragraph = std::make_shared<ParagraphElement>();
-                paragraph->addText(line);
-                elements_.push_back(paragraph);
+        // 在映射的字节上按'\n'切分，行的划分与std::getline一致
+        DocumentBuilder builder(elements_, arena_.get());
+        builder.setBudget(budget.get());
+        try {
+            const char* p = reinterpret_cast<const char*>(file.data());
+            const char* end = p + file.size();
+            bool isTitle = true;
+            while (p < end) {
+                const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+                const char* lineEnd = newline ? newline : end;
+                if (isTitle) {
+                    // 第一行作为标题
+                    title_.assign(p, lineEnd);
+                    builder.emplace<HeadingElement>(title_, 1);
+                    isTitle = false;
+                } else if (lineEnd != p) {
+                    // 其余非空行作为段落
+                    std::string_view line(p, static_cast<size_t>(lineEnd - p));
+                    auto& paragraph = builder.emplace<ParagraphElement>();
+                    if (arena_) {
+                        paragraph.addTextView(arena_->text().store(line));
+                    } else {
+                        paragraph.addText(std::string(line));
+                    }
+                }
+                p = newline ? newline + 1 : end;
             }
+            builder.flush();
+        } catch (const MemoryBudgetExceeded& e) {
+            Logger::getInstance().error("Failed to load document: " + std::string(e.what()));
+            return false;
         }
 
         return true;
@@ -91,12 +122,41 @@ public:
      * @param element 要添加的元素
      */
     void addElement(std::shared_ptr<DocumentElement> element) override {
-        elements_.push_back(element);
+        elements_.push_back(std::move(element));
+    }
+
+    /**
+     * @brief 设置加载文件时元素的存储方式
+     * @param storage 存储方式
+     *
+     * 使用 ElementStorage::Arena 时，加载的元素及其文本位于共享的存储区中，
+     * getElements() 返回的指针使存储区在文档销毁后继续有效。
+     */
+    void setElementStorage(ElementStorage storage) { storage_ = storage; }
+
+    /**
+     * @brief 获取元素的存储方式
+     * @return ElementStorage 存储方式
+     */
+    ElementStorage getElementStorage() const { return storage_; }
+
+    /**
+     * @brief 获取文档的内存占用
+     * @return MemoryUsage 元素、元素列表和存储区文本的内存占用
+     */
+    MemoryUsage getMemoryUsage() const override {
+        MemoryUsage usage = Document::getMemoryUsage();
+        if (arena_) {
+            usage.containerBytes += arena_->text().bytesStored();
+        }
+        return usage;
     }
 
 private:
     std::string title_;                                      ///< 文档标题
     std::vector<std::shared_ptr<DocumentElement>> elements_; ///< 文档元素列表
+    ElementStorage storage_ = ElementStorage::Shared;        ///< 元素的存储方式
+    std::shared_ptr<ElementArena> arena_;                    ///< 元素存储区（Arena模式）
 };
 
 } // namespace doc_converter 
\ No newline at end of file
@@ -14,6 +14,38 @@ enum class ElementType {
     List        ///< 列表元素
 };
 
+class DocumentElement;
+class TextElement;
+class ParagraphElement;
+class HeadingElement;
+class TableElement;
+class ImageElement;
+struct MemoryUsage;
+
+/**
+ * @brief 元素访问者
+ *
+ * 通过 DocumentElement::accept() 双重分派，直接得到具体类型的常量引用，
+ * 不需要 getType() 加 dynamic_pointer_cast，也不产生引用计数操作。
+ * 默认实现什么也不做，子类只需重写关心的元素类型。
+ */
+class ElementVisitor {
+public:
+    virtual ~ElementVisitor() = default;
+
+    virtual void visit(const TextElement& /*text*/) {}
+    virtual void visit(const ParagraphElement& /*paragraph*/) {}
+    virtual void visit(const HeadingElement& /*heading*/) {}
+    virtual void visit(const TableElement& /*table*/) {}
+    virtual void visit(const ImageElement& /*image*/) {}
+
+    /**
+     * @brief 访问没有专门重载的元素（如尚未实现的列表元素或外部定义的元素）
+     * @param element 元素
+     */
+    virtual void visitOther(const DocumentElement& /*element*/) {}
+};
+
 /**
  * @brief 文档元素基类
  * 
@@ -28,6 +60,22 @@ public:
      * @return ElementType 返回当前元素的类型
      */
     virtual ElementType getType() const = 0;
+
+    /**
+     * @brief 接受访问者
+     * @param visitor 访问者
+     *
+     * 具体元素类重写为调用 visitor.visit(*this)；默认调用 visitOther()。
+     */
+    virtual void accept(ElementVisitor& visitor) const { visitor.visitOther(*this); }
+
+    /**
+     * @brief 把元素的内存占用累加到统计中
+     * @param usage 内存占用统计
+     *
+     * 具体元素类重写为计入对象大小和自己持有的数据；默认只计入元素数和基类对象大小。
+     */
+    virtual void addMemoryUsage(MemoryUsage& usage) const;
 };
 
 } // namespace doc_converter 
\ No newline at end of file
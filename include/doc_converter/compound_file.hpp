@@ -0,0 +1,109 @@
+/**
+ * @file compound_file.hpp
+ * @brief OLE2复合文档（Compound File Binary）读取器
+ *
+ * .doc文件是一个CFB容器，文本和格式分别存放在WordDocument流和0Table/1Table流中。
+ * 本文件提供进程内的读取实现：
+ * - 解析文件头、DIFAT、FAT和迷你FAT
+ * - 遍历根存储下的目录树
+ * - 按名称读取流（支持普通扇区和迷你流）
+ */
+
+#pragma once
+
+#include "doc_converter/mapped_file.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief CFB复合文档类
+ *
+ * 构造时解析扇区分配表和目录，之后的只读访问是线程安全的。
+ */
+class CompoundFile {
+public:
+    /**
+     * @brief 从文件打开复合文档
+     * @param filePath 文件路径
+     *
+     * 文件无法读取或不是合法的CFB时抛出 std::runtime_error。
+     */
+    explicit CompoundFile(const std::string& filePath);
+
+    /**
+     * @brief 从内存数据打开复合文档
+     * @param data 文件的完整字节
+     */
+    explicit CompoundFile(std::vector<uint8_t> data);
+
+    /**
+     * @brief 判断数据是否以CFB签名开始
+     * @param data 数据起始地址
+     * @param size 数据大小
+     * @return bool 是否为CFB数据
+     */
+    static bool isCompoundFile(const void* data, size_t size);
+
+    /**
+     * @brief 判断根存储下是否存在指定的流
+     * @param name 流名称（如 "WordDocument"）
+     * @return bool 是否存在
+     */
+    bool hasStream(const std::string& name) const;
+
+    /**
+     * @brief 读取根存储下的流
+     * @param name 流名称
+     * @return vector<uint8_t> 流内容，流不存在或扇区链损坏时抛出 std::runtime_error
+     */
+    std::vector<uint8_t> readStream(const std::string& name) const;
+
+private:
+    /**
+     * @brief 目录项
+     */
+    struct DirectoryEntry {
+        std::u16string name;      ///< 名称（UTF-16）
+        uint8_t type = 0;         ///< 类型（1 = 存储，2 = 流，5 = 根）
+        uint32_t left = 0;        ///< 左兄弟
+        uint32_t right = 0;       ///< 右兄弟
+        uint32_t child = 0;       ///< 第一个子节点
+        uint32_t startSector = 0; ///< 起始扇区
+        uint64_t size = 0;        ///< 流大小
+    };
+
+    /**
+     * @brief 解析文件头、分配表和目录
+     */
+    void parse();
+
+    /**
+     * @brief 读取普通扇区链
+     * @param start 起始扇区
+     * @param size 需要读取的字节数（UINT64_MAX 表示读到链尾）
+     * @return vector<uint8_t> 链上的数据
+     */
+    std::vector<uint8_t> readChain(uint32_t start, uint64_t size) const;
+
+    /**
+     * @brief 在根存储的子节点中按名称查找
+     * @param name 流名称
+     * @return const DirectoryEntry* 目录项，找不到时返回nullptr
+     */
+    const DirectoryEntry* findRootChild(const std::string& name) const;
+
+    MappedFile data_;                         ///< 文件字节（内存映射或自有缓冲区）
+    uint32_t sectorSize_ = 512;               ///< 扇区大小
+    uint32_t miniSectorSize_ = 64;            ///< 迷你扇区大小
+    uint32_t miniStreamCutoff_ = 4096;        ///< 小于该大小的流存放在迷你流中
+    size_t sectorCount_ = 0;                  ///< 文件中的扇区数（链长度的上限）
+    std::vector<uint32_t> fat_;               ///< 扇区分配表
+    std::vector<uint32_t> miniFat_;           ///< 迷你扇区分配表
+    std::vector<DirectoryEntry> directory_;   ///< 目录项
+    std::vector<uint8_t> miniStream_;         ///< 迷你流（根目录项的数据）
+};
+
+} // namespace doc_converter
@@ -6,11 +6,14 @@
  * - Document：文档的基类接口
  * - Converter：文档转换器的基类接口
  * - ConverterFactory：转换器工厂类
+ *
+ * 边解析边转换使用的 ElementCursor 定义在 element_cursor.hpp 中。
  */
 
 #pragma once
 
 #include "doc_converter/common.hpp"
+#include "doc_converter/memory_usage.hpp"
 #include <string>
 #include <vector>
 #include <memory>
@@ -18,6 +21,10 @@
 
 namespace doc_converter {
 
+class ElementQueue;
+class ElementCursor;
+class OutputSink;
+
 /**
  * @brief 文档类
  * 
@@ -53,19 +60,69 @@ public:
      * @return bool 加载是否成功
      */
     virtual bool loadFromFile(const std::string& filePath) = 0;
-    
+
+    /**
+     * @brief 从文件加载文档，同时按文档顺序把元素送入队列
+     * @param filePath 文档文件路径
+     * @param queue 接收元素的队列（由 ElementCursor 在加载线程上传入）
+     * @return bool 加载是否成功
+     *
+     * 默认实现在 loadFromFile() 完成后一次送出全部元素。能边解析边输出的子类应重写此函数，
+     * 并保证第一个元素送出时标题已经确定。元素同样保存在文档中。
+     */
+    virtual bool streamFromFile(const std::string& filePath, ElementQueue& queue);
+
     /**
      * @brief 获取文档标题
      * @return string 文档标题
      */
     virtual std::string getTitle() const = 0;
+
+    /**
+     * @brief 获取文档的内存占用
+     * @return MemoryUsage 按类别统计的内存占用
+     *
+     * 默认实现统计 getElements() 中的元素和元素列表本身；持有存储区等额外数据的子类应重写。
+     * 不能与加载或读取图片数据的线程同时调用。
+     */
+    virtual MemoryUsage getMemoryUsage() const;
+
+    /**
+     * @brief 设置加载文档时的内存预算
+     * @param bytes 预算字节数，0 表示不限制
+     *
+     * 加载过程中文档的内存占用（以元素引用的全部文本计，尚未加载的图片不计）超过预算时，
+     * loadFromFile() 立即中止并返回 false，错误信息写入日志；已解析的元素保留在文档中。
+     */
+    void setMemoryBudget(size_t bytes) { memoryBudget_ = bytes; }
+
+    /**
+     * @brief 获取加载文档时的内存预算
+     * @return size_t 预算字节数，0 表示不限制
+     */
+    size_t getMemoryBudget() const { return memoryBudget_; }
+
+    /**
+     * @brief 按文档顺序让访问者访问所有元素
+     * @param visitor 访问者
+     */
+    void visitElements(ElementVisitor& visitor) const {
+        for (const auto& element : getElements()) {
+            if (element) {
+                element->accept(visitor);
+            }
+        }
+    }
+
+protected:
+    size_t memoryBudget_ = 0;  ///< 加载时的内存预算（0 = 不限制）
 };
 
 /**
  * @brief 转换器基类
  * 
  * 定义了文档转换器的基本操作接口，包括：
- * - 转换文档
+ * - 转换文档（写入文件或 OutputSink）
  * - 获取转换器名称
  * - 获取支持的文件格式
  */
@@ -78,8 +135,41 @@ public:
      * @param doc 要转换的文档
      * @param outputPath 输出文件路径
      * @return bool 转换是否成功
+     *
+     * 默认实现打开 FileSink 后调用 convert(const Document&, OutputSink&)。
      */
-    virtual bool convert(const Document& doc, const std::string& outputPath) = 0;
+    virtual bool convert(const Document& doc, const std::string& outputPath);
+
+    /**
+     * @brief 转换文档并写入输出层
+     * @param doc 要转换的文档
+     * @param sink 输出层（文件、内存或 NullSink）
+     * @return bool 转换是否成功
+     *
+     * 转换器应重写此函数；默认实现记录错误并返回 false。
+     */
+    virtual bool convert(const Document& doc, OutputSink& sink);
+
+    /**
+     * @brief 边加载边转换文档
+     * @param cursor 正在加载的文档的元素游标
+     * @param outputPath 输出文件路径
+     * @return bool 加载和转换是否都成功
+     *
+     * 默认实现等待加载完成后调用 convert(const Document&, ...)；
+     * 能按元素顺序输出的转换器应重写此函数，在解析的同时写出已经拿到的元素。
+     */
+    virtual bool convert(ElementCursor& cursor, const std::string& outputPath);
+
+    /**
+     * @brief 边加载边转换文档并写入输出层
+     * @param cursor 正在加载的文档的元素游标
+     * @param sink 输出层
+     * @return bool 加载和转换是否都成功
+     *
+     * 默认实现等待加载完成后调用 convert(const Document&, OutputSink&)。
+     */
+    virtual bool convert(ElementCursor& cursor, OutputSink& sink);
     
     /**
      * @brief 获取转换器名称
@@ -94,11 +184,23 @@ public:
     virtual std::vector<std::string> getSupportedExtensions() const = 0;
 };
 
+/**
+ * @brief 转换器实例的复用方式（ConverterFactory::getConverter() 使用）
+ */
+enum class ConverterReuse {
+    None,       ///< 每次创建新实例
+    PerThread,  ///< 每个线程复用一个实例（适用于无状态、但不能在线程间共享的转换器）
+    Shared      ///< 所有线程共用一个实例（适用于可以在多个线程中同时使用的转换器）
+};
+
 /**
  * @brief 转换器工厂类
  * 
  * 负责管理和创建各种文档转换器，使用工厂模式实现。
  * 提供了注册和创建转换器的静态方法。
+ *
+ * 所有方法都是线程安全的。注册表以不可变快照的形式发布：查找只读取当前快照，
+ * 不加锁；注册时复制快照、修改后整体替换，工作线程运行期间也可以注册。
  */
 class ConverterFactory {
 public:
@@ -106,10 +208,14 @@ public:
      * @brief 注册转换器创建函数
      * @param name 转换器名称
      * @param creator 创建转换器的函数对象
+     * @param reuse getConverter() 复用实例的方式
+     *
+     * 名称已注册时替换原来的注册，之后 getConverter() 不再返回原来的实例。
      */
     static void registerConverter(
         const std::string& name,
-        std::function<std::shared_ptr<Converter>()> creator);
+        std::function<std::shared_ptr<Converter>()> creator,
+        ConverterReuse reuse = ConverterReuse::None);
     
     /**
      * @brief 创建转换器实例
@@ -117,6 +223,16 @@ public:
      * @return shared_ptr<Converter> 创建的转换器实例
      */
     static std::shared_ptr<Converter> createConverter(const std::string& name);
+
+    /**
+     * @brief 获取转换器实例，按注册时指定的方式复用
+     * @param name 转换器名称
+     * @return shared_ptr<Converter> 转换器实例，名称未注册时返回 nullptr
+     *
+     * 返回的实例可能被复用，调用方不能修改其设置；需要修改设置时使用 createConverter()。
+     * 内置的转换器为 ConverterReuse::Shared。
+     */
+    static std::shared_ptr<Converter> getConverter(const std::string& name);
 };
 
 } // namespace doc_converter 
\ No newline at end of file
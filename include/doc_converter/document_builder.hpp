@@ -0,0 +1,163 @@
+/**
+ * @file document_builder.hpp
+ * @brief 解析器输出元素使用的构建器
+ *
+ * 解析器通过 DocumentBuilder 创建元素并按文档顺序移交给元素列表：
+ * - 元素按所选存储方式创建（单独分配或位于 ElementArena 中）
+ * - emit() 只接受右值，元素指针移入列表，不做额外的引用计数
+ * - reserve() 接收由已知大小（部件解压后大小、段落数等）估算的容量，避免列表反复扩容
+ * - 设置了元素队列时，输出的元素同时送入队列，供 ElementCursor 边解析边转换
+ * - 设置了内存预算时，输出的元素计入预算，超出时抛出 MemoryBudgetExceeded
+ */
+
+#pragma once
+
+#include "doc_converter/common.hpp"
+#include "doc_converter/element_arena.hpp"
+#include "doc_converter/element_cursor.hpp"
+#include "doc_converter/memory_usage.hpp"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief 文档构建器
+ *
+ * 只引用外部的元素列表和存储区，不持有它们。非线程安全，并行解析时每个分块使用各自的构建器。
+ */
+class DocumentBuilder {
+public:
+    /**
+     * @brief 构造函数
+     * @param elements 接收元素的列表
+     * @param arena 元素存储区，为空时元素单独分配
+     */
+    explicit DocumentBuilder(std::vector<std::shared_ptr<DocumentElement>>& elements,
+                             ElementArena* arena = nullptr)
+        : elements_(elements), arena_(arena) {}
+
+    DocumentBuilder(const DocumentBuilder&) = delete;
+    DocumentBuilder& operator=(const DocumentBuilder&) = delete;
+
+    /**
+     * @brief 设置元素存储区
+     * @param arena 元素存储区，为空时元素单独分配
+     */
+    void setArena(ElementArena* arena) { arena_ = arena; }
+
+    /**
+     * @brief 获取元素存储区
+     * @return ElementArena* 元素存储区，未设置时为 nullptr
+     */
+    ElementArena* arena() const { return arena_; }
+
+    /**
+     * @brief 设置元素队列
+     * @param queue 接收已输出元素的队列，为空时元素只进入元素列表
+     */
+    void setQueue(ElementQueue* queue) {
+        queue_ = queue;
+        committed_ = elements_.size();
+    }
+
+    /**
+     * @brief 设置内存预算
+     * @param budget 计入已输出元素占用的预算，为空时不计
+     *
+     * 计入的是元素的 total() 加上引用的外部文本，驻留池中去重的文本会被重复计入。
+     */
+    void setBudget(MemoryBudget* budget) {
+        budget_ = budget;
+        committed_ = elements_.size();
+    }
+
+    /**
+     * @brief 为即将输出的元素预留容量
+     * @param count 预计还会输出的元素数
+     */
+    void reserve(size_t count) { elements_.reserve(elements_.size() + count); }
+
+    /**
+     * @brief 按存储方式创建元素（不输出）
+     * @param args 构造参数
+     * @return shared_ptr<T> 新元素
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make(Args&&... args) {
+        return arena_ ? arena_->make<T>(std::forward<Args>(args)...)
+                      : std::make_shared<T>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 输出元素
+     * @param element 元素，移入元素列表
+     */
+    template <typename T>
+    void emit(std::shared_ptr<T>&& element) {
+        elements_.push_back(std::move(element));
+        commit(elements_.size());
+    }
+
+    /**
+     * @brief 创建并输出元素
+     * @param args 构造参数
+     * @return T& 新元素，在元素列表中的位置不变
+     *
+     * 调用方在返回后还会填充元素，因此设置了元素队列或内存预算时，
+     * 新元素在下一次 emit()、emplace() 或 flush() 时才送入队列、计入预算。
+     */
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        std::shared_ptr<T> element = make<T>(std::forward<Args>(args)...);
+        T& ref = *element;
+        elements_.push_back(std::move(element));
+        commit(elements_.size() - 1);
+        return ref;
+    }
+
+    /**
+     * @brief 把已输出但尚未处理的元素计入预算并送入队列
+     */
+    void flush() { commit(elements_.size()); }
+
+    /**
+     * @brief 获取已输出的元素数（包括构建器创建之前列表中已有的元素）
+     * @return size_t 元素数
+     */
+    size_t size() const { return elements_.size(); }
+
+private:
+    /**
+     * @brief 把列表中 end 之前尚未处理的元素计入预算并送入队列
+     * @param end 元素下标上界
+     *
+     * 先计入预算再送入队列，元素交给消费者之前不再被访问。
+     */
+    void commit(size_t end) {
+        if (!queue_ && !budget_) {
+            return;
+        }
+        for (; committed_ < end; ++committed_) {
+            const std::shared_ptr<DocumentElement>& element = elements_[committed_];
+            if (budget_ && element) {
+                MemoryUsage usage;
+                element->addMemoryUsage(usage);
+                budget_->charge(usage.total() + usage.sharedTextBytes + sizeof(element));
+            }
+            if (queue_) {
+                queue_->push(element);
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<DocumentElement>>& elements_;  ///< 接收元素的列表
+    ElementArena* arena_;                                      ///< 元素存储区
+    ElementQueue* queue_ = nullptr;                            ///< 同时接收元素的队列
+    MemoryBudget* budget_ = nullptr;                           ///< 计入元素占用的内存预算
+    size_t committed_ = 0;                                     ///< 已计入预算、送入队列的元素数
+};
+
+} // namespace doc_converter
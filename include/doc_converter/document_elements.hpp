@@ -16,24 +16,46 @@
 #pragma once
 
 #include "doc_converter/common.hpp"
+#include "doc_converter/image_store.hpp"
+#include "doc_converter/memory_usage.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 
 namespace doc_converter {
 
+/**
+ * @brief 构造引用外部存储的文本元素时使用的标记
+ */
+struct TextViewTag {};
+
 /**
  * @brief 文本元素类
  * 
- * 表示文档中的纯文本内容。
+ * 表示文档中的纯文本内容。文本可以由元素自己持有，也可以是指向外部存储
+ * （如文档的 TextArena）的视图，此时外部存储必须比元素活得更久。
  */
 class TextElement : public DocumentElement {
 public:
     /**
      * @brief 构造函数
-     * @param text 文本内容
+     * @param text 文本内容（复制到元素中）
+     */
+    explicit TextElement(const std::string& text) : owned_(text) {}
+
+    /**
+     * @brief 构造引用外部存储的文本元素
+     * @param text 文本视图，不复制
      */
-    explicit TextElement(const std::string& text) : text_(text) {}
+    TextElement(std::string_view text, TextViewTag) : view_(text), borrowed_(true) {}
 
     /**
      * @brief 获取元素类型
@@ -41,20 +63,101 @@ public:
      */
     ElementType getType() const override { return ElementType::Text; }
 
+    /**
+     * @brief 接受访问者
+     * @param visitor 访问者
+     */
+    void accept(ElementVisitor& visitor) const override { visitor.visit(*this); }
+
     /**
      * @brief 获取文本内容
-     * @return const string& 文本内容
+     * @return string_view 文本内容
      */
-    const std::string& getText() const { return text_; }
+    std::string_view getText() const { return borrowed_ ? view_ : std::string_view(owned_); }
+
+    /**
+     * @brief 把元素的内存占用累加到统计中
+     * @param usage 内存占用统计
+     */
+    void addMemoryUsage(MemoryUsage& usage) const override {
+        ++usage.elementCount;
+        usage.elementBytes += sizeof(*this);
+        usage.textBytes += MemoryUsage::heapBytes(owned_);
+        usage.sharedTextBytes += borrowed_ ? view_.size() : 0;
+    }
+
+private:
+    std::string owned_;       ///< 自己持有的文本
+    std::string_view view_;   ///< 外部存储中的文本
+    bool borrowed_ = false;   ///< 是否引用外部存储
+};
+
+/**
+ * @brief 段落中文本运行的只读视图，迭代得到每个运行的 string_view
+ */
+class TextRunRange {
+public:
+    /**
+     * @brief 文本运行描述
+     */
+    struct Run {
+        const char* external = nullptr;  ///< 外部存储中的文本，为空时文本位于段落自己的缓冲区
+        uint32_t offset = 0;             ///< 在段落缓冲区中的起始偏移
+        uint32_t length = 0;             ///< 字节数
+    };
+
+    /**
+     * @brief 运行迭代器
+     */
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        iterator() = default;
+        iterator(const char* buffer, const Run* run) : buffer_(buffer), run_(run) {}
+
+        std::string_view operator*() const {
+            return std::string_view(run_->external ? run_->external : buffer_ + run_->offset, run_->length);
+        }
+        std::string_view operator[](difference_type n) const { return *(*this + n); }
+        iterator& operator++() { ++run_; return *this; }
+        iterator operator++(int) { iterator old = *this; ++run_; return old; }
+        iterator& operator--() { --run_; return *this; }
+        iterator& operator+=(difference_type n) { run_ += n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(buffer_, run_ + n); }
+        difference_type operator-(const iterator& other) const { return run_ - other.run_; }
+        bool operator==(const iterator& other) const { return run_ == other.run_; }
+        bool operator!=(const iterator& other) const { return run_ != other.run_; }
+
+    private:
+        const char* buffer_ = nullptr;
+        const Run* run_ = nullptr;
+    };
+
+    TextRunRange(const char* buffer, const Run* runs, size_t count) : buffer_(buffer), runs_(runs), count_(count) {}
+
+    iterator begin() const { return iterator(buffer_, runs_); }
+    iterator end() const { return iterator(buffer_, runs_ + count_); }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    std::string_view operator[](size_t index) const { return begin()[static_cast<std::ptrdiff_t>(index)]; }
 
 private:
-    std::string text_;  ///< 存储文本内容
+    const char* buffer_;
+    const Run* runs_;
+    size_t count_;
 };
 
 /**
  * @brief 段落元素类
  * 
- * 表示文档中的段落，可以包含多个文本元素。
+ * 表示文档中的段落，可以包含多个文本运行。
+ * 运行描述在前几个之内直接存放在段落对象中，自己持有的文本连续存放在一个缓冲区里，
+ * 常见的只有一到三个短运行的段落不需要为每个运行单独分配内存。
  */
 class ParagraphElement : public DocumentElement {
 public:
@@ -65,21 +168,142 @@ public:
     ElementType getType() const override { return ElementType::Paragraph; }
 
     /**
-     * @brief 添加文本元素
+     * @brief 接受访问者
+     * @param visitor 访问者
+     */
+    void accept(ElementVisitor& visitor) const override { visitor.visit(*this); }
+
+    /**
+     * @brief 添加文本运行（复制到段落缓冲区）
      * @param text 要添加的文本
      */
     void addText(const std::string& text) {
-        texts_.push_back(std::make_shared<TextElement>(text));
+        appendOwned(text);
+    }
+
+    /**
+     * @brief 添加文本运行（接管字符串）
+     * @param text 要添加的文本
+     *
+     * 段落缓冲区为空时直接接管字符串的存储，否则追加到缓冲区。
+     */
+    void addText(std::string&& text) {
+        if (!buffer_.empty()) {
+            appendOwned(text);
+            return;
+        }
+        checkLength(text.size());
+        TextRunRange::Run run;
+        run.length = static_cast<uint32_t>(text.size());
+        buffer_ = std::move(text);
+        pushRun(run);
+    }
+
+    /**
+     * @brief 添加引用外部存储的文本运行
+     * @param text 文本视图，所指向的存储必须比段落活得更久
+     */
+    void addTextView(std::string_view text) {
+        checkLength(text.size());
+        TextRunRange::Run run;
+        run.external = text.data();
+        run.length = static_cast<uint32_t>(text.size());
+        pushRun(run);
     }
 
     /**
-     * @brief 获取段落中的所有文本元素
-     * @return const vector<shared_ptr<TextElement>>& 文本元素列表
+     * @brief 获取段落中的所有文本运行
+     * @return TextRunRange 文本运行视图，添加运行后失效
      */
-    const std::vector<std::shared_ptr<TextElement>>& getTexts() const { return texts_; }
+    TextRunRange getTexts() const {
+        return TextRunRange(buffer_.data(), runCount_ <= kInlineRuns ? inline_ : spilled_.data(), runCount_);
+    }
+
+    /**
+     * @brief 将段落标记为编号列表项
+     * @param level 列表级别（从0开始）
+     * @param format 编号格式（如 "bullet"、"decimal"，未知时为空）
+     */
+    void setListInfo(int level, const std::string& format) {
+        listLevel_ = level;
+        listFormat_ = format;
+    }
+
+    /**
+     * @brief 判断段落是否为列表项
+     * @return bool 是否为列表项
+     */
+    bool isListItem() const { return listLevel_ >= 0; }
+
+    /**
+     * @brief 获取列表级别
+     * @return int 列表级别，不是列表项时返回 -1
+     */
+    int getListLevel() const { return listLevel_; }
+
+    /**
+     * @brief 获取编号格式
+     * @return const string& 编号格式
+     */
+    const std::string& getListFormat() const { return listFormat_; }
+
+    /**
+     * @brief 把元素的内存占用累加到统计中
+     * @param usage 内存占用统计
+     */
+    void addMemoryUsage(MemoryUsage& usage) const override {
+        ++usage.elementCount;
+        usage.elementBytes += sizeof(*this);
+        usage.textBytes += MemoryUsage::heapBytes(buffer_) + MemoryUsage::heapBytes(spilled_) +
+                           MemoryUsage::heapBytes(listFormat_);
+        const TextRunRange::Run* runs = runCount_ <= kInlineRuns ? inline_ : spilled_.data();
+        for (uint32_t i = 0; i < runCount_; ++i) {
+            usage.sharedTextBytes += runs[i].external ? runs[i].length : 0;
+        }
+    }
 
 private:
-    std::vector<std::shared_ptr<TextElement>> texts_;  ///< 存储段落中的文本元素
+    static constexpr uint32_t kInlineRuns = 3;  ///< 直接存放在段落对象中的运行数
+
+    /**
+     * @brief 把文本追加到段落缓冲区
+     */
+    void appendOwned(std::string_view text) {
+        checkLength(buffer_.size() + text.size());
+        TextRunRange::Run run;
+        run.offset = static_cast<uint32_t>(buffer_.size());
+        run.length = static_cast<uint32_t>(text.size());
+        buffer_.append(text.data(), text.size());
+        pushRun(run);
+    }
+
+    /**
+     * @brief 记录运行描述，超过内嵌容量时整体移到堆上
+     */
+    void pushRun(const TextRunRange::Run& run) {
+        if (runCount_ < kInlineRuns) {
+            inline_[runCount_] = run;
+        } else {
+            if (runCount_ == kInlineRuns) {
+                spilled_.assign(inline_, inline_ + kInlineRuns);
+            }
+            spilled_.push_back(run);
+        }
+        ++runCount_;
+    }
+
+    static void checkLength(size_t length) {
+        if (length > UINT32_MAX) {
+            throw std::length_error("Paragraph text exceeds 4 GiB");
+        }
+    }
+
+    TextRunRange::Run inline_[kInlineRuns];     ///< 内嵌的运行描述
+    std::vector<TextRunRange::Run> spilled_;   ///< 超过内嵌容量时的全部运行描述
+    uint32_t runCount_ = 0;                    ///< 运行数
+    std::string buffer_;                       ///< 自己持有的运行文本
+    int listLevel_ = -1;      ///< 列表级别（-1 表示不是列表项）
+    std::string listFormat_;  ///< 编号格式
 };
 
 /**
@@ -91,11 +315,11 @@ class HeadingElement : public DocumentElement {
 public:
     /**
      * @brief 构造函数
-     * @param text 标题文本
+     * @param text 标题文本（右值时移入元素）
      * @param level 标题级别（1-6）
      */
-    HeadingElement(const std::string& text, int level)
-        : text_(text), level_(std::min(std::max(level, 1), 6)) {}
+    HeadingElement(std::string text, int level)
+        : text_(std::move(text)), level_(std::min(std::max(level, 1), 6)) {}
 
     /**
      * @brief 获取元素类型
@@ -103,6 +327,12 @@ public:
      */
     ElementType getType() const override { return ElementType::Heading; }
 
+    /**
+     * @brief 接受访问者
+     * @param visitor 访问者
+     */
+    void accept(ElementVisitor& visitor) const override { visitor.visit(*this); }
+
     /**
      * @brief 获取标题文本
      * @return const string& 标题文本
@@ -115,6 +345,16 @@ public:
      */
     int getLevel() const { return level_; }
 
+    /**
+     * @brief 把元素的内存占用累加到统计中
+     * @param usage 内存占用统计
+     */
+    void addMemoryUsage(MemoryUsage& usage) const override {
+        ++usage.elementCount;
+        usage.elementBytes += sizeof(*this);
+        usage.textBytes += MemoryUsage::heapBytes(text_);
+    }
+
 private:
     std::string text_;  ///< 标题文本
     int level_;         ///< 标题级别（1-6）
@@ -127,24 +367,52 @@ class TableCell {
 public:
     /**
      * @brief 构造函数
-     * @param text 单元格文本
+     * @param text 单元格文本（复制到单元格中）
      */
-    explicit TableCell(const std::string& text = "") : text_(text) {}
+    explicit TableCell(const std::string& text = "") : owned_(text) {}
+
+    /**
+     * @brief 构造函数
+     * @param text 单元格文本（移入单元格中）
+     */
+    explicit TableCell(std::string&& text) : owned_(std::move(text)) {}
+
+    /**
+     * @brief 构造引用外部存储（如 StringPool）的单元格
+     * @param text 文本视图，不复制
+     */
+    TableCell(std::string_view text, TextViewTag) : view_(text), borrowed_(true) {}
 
     /**
      * @brief 获取单元格文本
-     * @return string 单元格文本
+     * @return string_view 单元格文本
      */
-    std::string getText() const { return text_; }
+    std::string_view getText() const { return borrowed_ ? view_ : std::string_view(owned_); }
 
     /**
      * @brief 设置单元格文本
-     * @param text 单元格文本
+     * @param text 单元格文本（复制到单元格中）
+     */
+    void setText(const std::string& text) {
+        owned_ = text;
+        view_ = std::string_view();
+        borrowed_ = false;
+    }
+
+    /**
+     * @brief 把单元格持有的文本累加到统计中（单元格对象本身由所在的行计入）
+     * @param usage 内存占用统计
      */
-    void setText(const std::string& text) { text_ = text; }
+    void addMemoryUsage(MemoryUsage& usage) const {
+        ++usage.tableCells;
+        usage.tableBytes += MemoryUsage::heapBytes(owned_);
+        usage.sharedTextBytes += borrowed_ ? view_.size() : 0;
+    }
 
 private:
-    std::string text_;  ///< 单元格文本
+    std::string owned_;       ///< 自己持有的文本
+    std::string_view view_;   ///< 外部存储中的文本
+    bool borrowed_ = false;   ///< 是否引用外部存储
 };
 
 /**
@@ -158,12 +426,35 @@ public:
      */
     void addCell(const TableCell& cell) { cells_.push_back(cell); }
 
+    /**
+     * @brief 添加单元格（移入）
+     * @param cell 单元格
+     */
+    void addCell(TableCell&& cell) { cells_.push_back(std::move(cell)); }
+
+    /**
+     * @brief 预留单元格容量
+     * @param count 单元格数
+     */
+    void reserveCells(size_t count) { cells_.reserve(count); }
+
     /**
      * @brief 获取单元格列表
      * @return vector<TableCell>& 单元格列表的引用
      */
     const std::vector<TableCell>& getCells() const { return cells_; }
 
+    /**
+     * @brief 把行中单元格的内存占用累加到统计中（行对象本身由所在的表格计入）
+     * @param usage 内存占用统计
+     */
+    void addMemoryUsage(MemoryUsage& usage) const {
+        usage.tableBytes += MemoryUsage::heapBytes(cells_);
+        for (const TableCell& cell : cells_) {
+            cell.addMemoryUsage(usage);
+        }
+    }
+
 private:
     std::vector<TableCell> cells_;  ///< 单元格列表
 };
@@ -184,26 +475,83 @@ public:
      */
     ElementType getType() const override { return ElementType::Table; }
 
+    /**
+     * @brief 接受访问者
+     * @param visitor 访问者
+     */
+    void accept(ElementVisitor& visitor) const override { visitor.visit(*this); }
+
     /**
      * @brief 添加表格行
      * @param row 表格行
      */
     void addRow(const TableRow& row) { rows_.push_back(row); }
 
+    /**
+     * @brief 添加表格行（移入）
+     * @param row 表格行
+     */
+    void addRow(TableRow&& row) { rows_.push_back(std::move(row)); }
+
+    /**
+     * @brief 预留表格行容量
+     * @param count 行数
+     */
+    void reserveRows(size_t count) { rows_.reserve(count); }
+
     /**
      * @brief 获取表格行列表
      * @return vector<TableRow>& 表格行列表的引用
      */
     const std::vector<TableRow>& getRows() const { return rows_; }
 
+    /**
+     * @brief 把元素的内存占用累加到统计中
+     * @param usage 内存占用统计
+     */
+    void addMemoryUsage(MemoryUsage& usage) const override {
+        ++usage.elementCount;
+        usage.elementBytes += sizeof(*this);
+        usage.tableBytes += MemoryUsage::heapBytes(rows_);
+        for (const TableRow& row : rows_) {
+            row.addMemoryUsage(usage);
+        }
+    }
+
 private:
     std::vector<TableRow> rows_;  ///< 表格行列表
 };
 
+/**
+ * @brief 图片数据源接口
+ *
+ * 表示存放在文档容器中的图片部件。ImageElement 只持有数据源句柄，
+ * 在转换器第一次请求图片数据时才读取（解压）实际字节。
+ */
+class ImageSource {
+public:
+    virtual ~ImageSource() = default;
+
+    /**
+     * @brief 读取图片数据
+     * @return vector<uint8_t> 图片数据，读取失败时抛出 std::runtime_error
+     */
+    virtual std::vector<uint8_t> load() const = 0;
+
+    /**
+     * @brief 获取图片数据大小（无需读取数据）
+     * @return size_t 图片数据字节数
+     */
+    virtual size_t size() const = 0;
+};
+
 /**
  * @brief 图片元素类
  * 
  * 表示文档中的图片，包含图片数据和属性信息。
+ * 图片数据可以直接给出，也可以由 ImageSource 延迟加载；
+ * 格式和尺寸始终可以立即获取。数据以共享指针保存，
+ * 经 ImageStore 去重的相同图片共用同一份数据。
  */
 class ImageElement : public DocumentElement {
 public:
@@ -218,7 +566,63 @@ public:
                 const std::string& format,
                 int width,
                 int height)
-        : imageData_(imageData)
+        : data_(std::make_shared<const std::vector<uint8_t>>(imageData))
+        , format_(format)
+        , width_(width)
+        , height_(height)
+        , loaded_(true) {}
+
+    /**
+     * @brief 构造函数，接管图片数据
+     * @param imageData 图片数据（移入元素，不复制）
+     * @param format 图片格式（如 "png", "jpg" 等）
+     * @param width 图片宽度（像素）
+     * @param height 图片高度（像素）
+     */
+    ImageElement(std::vector<uint8_t>&& imageData,
+                const std::string& format,
+                int width,
+                int height)
+        : data_(std::make_shared<const std::vector<uint8_t>>(std::move(imageData)))
+        , format_(format)
+        , width_(width)
+        , height_(height)
+        , loaded_(true) {}
+
+    /**
+     * @brief 构造引用存储中图片数据的图片元素
+     * @param image ImageStore 中的图片
+     * @param format 图片格式（如 "png", "jpg" 等）
+     * @param width 图片宽度（像素）
+     * @param height 图片高度（像素）
+     */
+    ImageElement(StoredImage image,
+                const std::string& format,
+                int width,
+                int height)
+        : data_(std::move(image.data))
+        , format_(format)
+        , width_(width)
+        , height_(height)
+        , loaded_(true)
+        , hash_(image.hash)
+        , hashed_(true) {}
+
+    /**
+     * @brief 构造延迟加载的图片元素
+     * @param source 图片数据源
+     * @param format 图片格式（如 "png", "jpg" 等）
+     * @param width 图片宽度（像素）
+     * @param height 图片高度（像素）
+     * @param store 加载数据时用于去重的图片存储，为空时不去重
+     */
+    ImageElement(std::shared_ptr<const ImageSource> source,
+                const std::string& format,
+                int width,
+                int height,
+                std::shared_ptr<ImageStore> store = nullptr)
+        : source_(std::move(source))
+        , store_(std::move(store))
         , format_(format)
         , width_(width)
         , height_(height) {}
@@ -229,11 +633,68 @@ public:
      */
     ElementType getType() const override { return ElementType::Image; }
 
+    /**
+     * @brief 接受访问者
+     * @param visitor 访问者
+     */
+    void accept(ElementVisitor& visitor) const override { visitor.visit(*this); }
+
     /**
      * @brief 获取图片数据
      * @return const vector<uint8_t>& 图片数据
+     *
+     * 延迟加载的图片在第一次调用时读取数据源（设置了图片存储时存入其中去重），
+     * 之后复用已加载的数据；多线程并发调用是安全的。数据源读取失败时抛出异常，下次调用会重试。
      */
-    const std::vector<uint8_t>& getImageData() const { return imageData_; }
+    const std::vector<uint8_t>& getImageData() const {
+        if (!loaded_.load(std::memory_order_acquire)) {
+            std::call_once(loadOnce_, [this] {
+                if (source_ && store_) {
+                    StoredImage stored = store_->intern(source_->load());
+                    data_ = std::move(stored.data);
+                    hash_ = stored.hash;
+                    hashed_.store(true, std::memory_order_release);
+                } else if (source_) {
+                    data_ = std::make_shared<const std::vector<uint8_t>>(source_->load());
+                }
+                loaded_.store(true, std::memory_order_release);
+            });
+        }
+        static const std::vector<uint8_t> empty;
+        return data_ ? *data_ : empty;
+    }
+
+    /**
+     * @brief 获取图片内容哈希（需要时加载数据）
+     * @return ImageHash 内容哈希；经图片存储去重的图片返回存储中的哈希
+     */
+    ImageHash getContentHash() const {
+        const std::vector<uint8_t>& data = getImageData();
+        if (!hashed_.load(std::memory_order_acquire)) {
+            std::call_once(hashOnce_, [this, &data] {
+                hash_ = ImageStore::hash(data.data(), data.size());
+                hashed_.store(true, std::memory_order_release);
+            });
+        }
+        return hash_;
+    }
+
+    /**
+     * @brief 获取共享的图片数据（需要时加载数据）
+     * @return StoredImage 内容哈希和图片数据，可交给 ImageStore::writeOnce()
+     */
+    StoredImage getStoredImage() const {
+        ImageHash hash = getContentHash();
+        return StoredImage{hash, data_};
+    }
+
+    /**
+     * @brief 获取图片数据大小（不触发加载）
+     * @return size_t 图片数据字节数
+     */
+    size_t getDataSize() const {
+        return source_ ? source_->size() : (data_ ? data_->size() : 0);
+    }
 
     /**
      * @brief 获取图片格式
@@ -253,11 +714,38 @@ public:
      */
     int getHeight() const { return height_; }
 
+    /**
+     * @brief 把元素的内存占用累加到统计中
+     * @param usage 内存占用统计
+     *
+     * 已加载的数据计入 imageBytes（与其他元素共用的数据只计一次），尚未加载的计入 lazyImageBytes。
+     * 不触发加载，不能与 getImageData() 同时调用。
+     */
+    void addMemoryUsage(MemoryUsage& usage) const override {
+        ++usage.elementCount;
+        usage.elementBytes += sizeof(*this);
+        usage.textBytes += MemoryUsage::heapBytes(format_);
+        if (data_) {
+            if (usage.countOnce(data_.get())) {
+                usage.imageBytes += sizeof(*data_) + MemoryUsage::heapBytes(*data_);
+            }
+        } else if (source_) {
+            usage.lazyImageBytes += source_->size();
+        }
+    }
+
 private:
-    std::vector<uint8_t> imageData_;  ///< 图片数据
-    std::string format_;              ///< 图片格式
-    int width_;                       ///< 图片宽度
-    int height_;                      ///< 图片高度
+    std::shared_ptr<const ImageSource> source_;  ///< 延迟加载的数据源
+    std::shared_ptr<ImageStore> store_;          ///< 去重用的图片存储
+    mutable std::shared_ptr<const std::vector<uint8_t>> data_;  ///< 图片数据
+    std::string format_;                         ///< 图片格式
+    int width_;                                  ///< 图片宽度
+    int height_;                                 ///< 图片高度
+    mutable std::atomic<bool> loaded_{false};    ///< 数据是否已加载（直接给出数据时构造后即为true）
+    mutable std::once_flag loadOnce_;            ///< 延迟加载只执行一次
+    mutable ImageHash hash_ = 0;                 ///< 内容哈希
+    mutable std::atomic<bool> hashed_{false};    ///< 内容哈希是否已知
+    mutable std::once_flag hashOnce_;            ///< 内容哈希只计算一次
 };
 
 // TODO: 实现 ListElement
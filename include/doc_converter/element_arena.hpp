@@ -0,0 +1,122 @@
+/**
+ * @file element_arena.hpp
+ * @brief 文档元素的单调分配存储区
+ *
+ * 大文档的每个元素和每个文本运行都单独分配一个 shared_ptr 控制块和对象，
+ * 加载和销毁时各产生数十万次 malloc/free。ElementArena 把元素对象和文本
+ * 连续地放在一组缓冲区中，元素共用存储区的控制块，最后一个元素释放时一次性释放。
+ */
+
+#pragma once
+
+#include "doc_converter/text_arena.hpp"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief 文档元素的存储方式
+ */
+enum class ElementStorage {
+    Shared,  ///< 每个元素单独分配，由 shared_ptr 引用计数管理（默认）
+    Arena    ///< 元素和文本放在 ElementArena 中，最后一个元素指针释放时一起释放
+};
+
+/**
+ * @brief 元素存储区
+ *
+ * 存储区必须由 shared_ptr 持有（std::make_shared）。make() 返回的 shared_ptr 与存储区
+ * 共用一个控制块，元素不单独分配控制块；只要还有元素指针，存储区就不会销毁。
+ * 对象在存储区销毁时按创建的逆序析构。非线程安全，并行解析时每个线程使用各自的存储区。
+ */
+class ElementArena : public std::enable_shared_from_this<ElementArena> {
+public:
+    /**
+     * @brief 构造函数
+     * @param initialSize 第一块缓冲区的大小（之后按几何级数增长）
+     */
+    explicit ElementArena(size_t initialSize = 256 * 1024) : resource_(initialSize) {}
+
+    ElementArena(const ElementArena&) = delete;
+    ElementArena& operator=(const ElementArena&) = delete;
+
+    /**
+     * @brief 析构函数，按创建的逆序析构全部对象
+     */
+    ~ElementArena() {
+        for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+            it->destroy(it->object);
+        }
+    }
+
+    /**
+     * @brief 在存储区中构造对象
+     * @param args 构造参数
+     * @return shared_ptr<T> 与存储区共享所有权的指针
+     * @throws std::bad_weak_ptr 存储区不由 shared_ptr 持有时
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make(Args&&... args) {
+        void* memory = resource_.allocate(sizeof(T), alignof(T));
+        T* object = ::new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors_.push_back({object, [](void* p) { static_cast<T*>(p)->~T(); }});
+        }
+        ++objectCount_;
+        // 别名构造：共用存储区的控制块，不单独分配
+        return std::shared_ptr<T>(shared_from_this(), object);
+    }
+
+    /**
+     * @brief 让存储区持有外部对象，直到存储区销毁
+     * @param owner 元素引用其数据的对象（如文本驻留池）
+     *
+     * 元素中的文本视图指向存储区以外的数据时，用它保证数据与元素同生命周期。
+     */
+    void retain(std::shared_ptr<const void> owner) {
+        if (owner) {
+            retained_.push_back(std::move(owner));
+        }
+    }
+
+    /**
+     * @brief 获取与元素同生命周期的文本存储区
+     * @return TextArena& 文本存储区
+     */
+    TextArena& text() { return text_; }
+
+    /**
+     * @brief 获取与元素同生命周期的文本存储区
+     * @return const TextArena& 文本存储区
+     */
+    const TextArena& text() const { return text_; }
+
+    /**
+     * @brief 获取已构造的对象数
+     * @return size_t 对象数
+     */
+    size_t objectCount() const { return objectCount_; }
+
+private:
+    /**
+     * @brief 待析构的对象
+     */
+    struct Destructor {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    std::pmr::monotonic_buffer_resource resource_;  ///< 单调分配的对象缓冲区
+    std::vector<Destructor> destructors_;            ///< 需要析构的对象（按创建顺序）
+    TextArena text_;                                 ///< 元素文本
+    std::vector<std::shared_ptr<const void>> retained_;  ///< 元素引用的外部对象（在对象析构之后释放）
+    size_t objectCount_ = 0;                         ///< 已构造的对象数
+};
+
+} // namespace doc_converter
@@ -0,0 +1,178 @@
+/**
+ * @file element_cursor.hpp
+ * @brief 边解析边转换使用的元素游标
+ *
+ * Document::getElements() 只有在 loadFromFile() 全部完成后才能使用，转换必须等待解析结束。
+ * ElementCursor 在后台线程上加载文档，解析器每输出一个元素就经有界队列交给游标，
+ * 转换器通过 next() 逐个拉取元素，解析与输出重叠进行，输出的第一个字节不必等到解析结束。
+ */
+
+#pragma once
+
+#include "doc_converter/common.hpp"
+#include "doc_converter/document.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief 消费者放弃元素流时解析线程收到的异常
+ */
+class StreamCancelled : public std::runtime_error {
+public:
+    StreamCancelled() : std::runtime_error("Element stream cancelled") {}
+};
+
+/**
+ * @brief 单生产者、单消费者的有界元素队列
+ *
+ * 队列满时 push() 阻塞，解析器最多领先转换器 capacity 个元素；队列空时 pop() 阻塞。
+ * 只在队列由满变为不满、由空变为不空时唤醒对方，稳定状态下不产生多余的通知。
+ */
+class ElementQueue {
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 最多缓存的元素数（至少为 1）
+     */
+    explicit ElementQueue(size_t capacity);
+
+    ElementQueue(const ElementQueue&) = delete;
+    ElementQueue& operator=(const ElementQueue&) = delete;
+
+    /**
+     * @brief 放入元素（生产者）
+     * @param element 元素
+     *
+     * 队列满时阻塞；消费者已调用 cancel() 时抛出 StreamCancelled，
+     * 已调用 discard() 时直接丢弃元素。
+     */
+    void push(std::shared_ptr<DocumentElement> element);
+
+    /**
+     * @brief 取出元素（消费者）
+     * @param element 接收元素
+     * @return bool 取到元素时为 true；队列已关闭且为空时为 false
+     */
+    bool pop(std::shared_ptr<DocumentElement>& element);
+
+    /**
+     * @brief 等待队列中有元素或队列关闭（消费者）
+     */
+    void wait();
+
+    /**
+     * @brief 关闭队列（生产者），之后 pop() 取完剩余元素后返回 false
+     */
+    void close();
+
+    /**
+     * @brief 放弃元素流（消费者），正在或之后调用 push() 的生产者收到 StreamCancelled
+     */
+    void cancel();
+
+    /**
+     * @brief 清空队列并丢弃之后放入的元素（消费者），生产者不再阻塞
+     */
+    void discard();
+
+    /**
+     * @brief 获取队列容量
+     * @return size_t 最多缓存的元素数
+     */
+    size_t capacity() const { return capacity_; }
+
+private:
+    const size_t capacity_;  ///< 最多缓存的元素数
+    std::mutex mutex_;
+    std::condition_variable notFull_;   ///< 生产者等待的条件
+    std::condition_variable notEmpty_;  ///< 消费者等待的条件
+    std::vector<std::shared_ptr<DocumentElement>> slots_;  ///< 环形缓冲区
+    size_t head_ = 0;   ///< 下一个取出的位置
+    size_t count_ = 0;  ///< 缓存的元素数
+    bool closed_ = false;
+    bool cancelled_ = false;
+    bool discarding_ = false;
+};
+
+/**
+ * @brief 元素游标
+ *
+ * 构造时在后台线程上调用 Document::streamFromFile()，之后按文档顺序用 next() 拉取元素。
+ * 游标持有文档；加载期间只能通过游标访问元素，finish() 返回后才能直接访问文档。
+ *
+ * 用法：
+ * @code
+ * ElementCursor cursor(std::make_shared<WordDocument>(), "report.docx");
+ * while (auto element = cursor.next()) {
+ *     element->accept(writer);
+ * }
+ * bool ok = cursor.finish();
+ * @endcode
+ */
+class ElementCursor {
+public:
+    static constexpr size_t kDefaultCapacity = 256;  ///< 默认的队列容量
+
+    /**
+     * @brief 构造函数，立即开始后台加载
+     * @param document 要加载的文档
+     * @param filePath 文档文件路径
+     * @param capacity 解析器最多领先转换器的元素数
+     */
+    ElementCursor(std::shared_ptr<Document> document, std::string filePath,
+                  size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief 析构函数
+     *
+     * 加载尚未结束时放弃元素流并等待加载线程退出，文档只包含已解析的部分。
+     */
+    ~ElementCursor();
+
+    ElementCursor(const ElementCursor&) = delete;
+    ElementCursor& operator=(const ElementCursor&) = delete;
+
+    /**
+     * @brief 拉取下一个元素，必要时等待解析器
+     * @return shared_ptr<DocumentElement> 下一个元素，全部元素取完（或加载失败）后返回 nullptr
+     */
+    std::shared_ptr<DocumentElement> next();
+
+    /**
+     * @brief 获取文档标题
+     * @return string 文档标题
+     *
+     * 等待第一个元素（或加载结束）后读取，此时标题已经确定。
+     */
+    std::string getTitle();
+
+    /**
+     * @brief 丢弃尚未拉取的元素并等待加载结束
+     * @return bool 加载是否成功
+     *
+     * 丢弃的元素仍保存在文档中。可以重复调用。
+     */
+    bool finish();
+
+    /**
+     * @brief 获取正在加载的文档
+     * @return const shared_ptr<Document>& 文档，finish() 返回前不能访问其元素
+     */
+    const std::shared_ptr<Document>& document() const { return document_; }
+
+private:
+    std::shared_ptr<Document> document_;  ///< 正在加载的文档
+    ElementQueue queue_;                  ///< 解析线程与转换线程之间的队列
+    bool loaded_ = false;                 ///< 加载结果（加载线程结束后有效）
+    std::thread loader_;                  ///< 加载线程
+};
+
+} // namespace doc_converter
@@ -0,0 +1,402 @@
+/**
+ * @file flat_document.hpp
+ * @brief 文档内容的紧凑列式表示
+ *
+ * getElements() 返回的元素分散在堆上，顺序遍历时每个元素都要追指针并经虚函数取类型。
+ * FlatDocument 把同一份内容压平成几个连续数组：
+ * - 每个元素一个类型标签和一个指向对应副表的下标
+ * - 所有文本（标题、文本运行、单元格、图片格式）连续存放在一个UTF-8缓冲区中，以偏移和长度引用
+ * - 标题级别、段落、表格行列和图片信息分别存放在各自的副表中
+ * 遍历大文档时按顺序读取这些数组，不再依赖元素对象的内存布局。
+ * 这些数组可以原样保存为带版本号的快照文件，之后映射到内存直接遍历。
+ */
+
+#pragma once
+
+#include "doc_converter/common.hpp"
+#include "doc_converter/document.hpp"
+#include "doc_converter/document_elements.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief 文本缓冲区中的一段文本
+ */
+struct TextSpan {
+    uint32_t offset = 0;  ///< 起始偏移
+    uint32_t length = 0;  ///< 字节数
+};
+
+/**
+ * @brief 连续若干段文本的视图（段落的文本运行、表格一行的单元格）
+ */
+class TextRange {
+public:
+    /**
+     * @brief 文本迭代器，解引用得到 string_view
+     */
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        iterator() = default;
+        iterator(const char* text, const TextSpan* span) : text_(text), span_(span) {}
+
+        std::string_view operator*() const { return std::string_view(text_ + span_->offset, span_->length); }
+        std::string_view operator[](difference_type n) const { return *(*this + n); }
+        iterator& operator++() { ++span_; return *this; }
+        iterator operator++(int) { iterator old = *this; ++span_; return old; }
+        iterator& operator--() { --span_; return *this; }
+        iterator& operator+=(difference_type n) { span_ += n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(text_, span_ + n); }
+        difference_type operator-(const iterator& other) const { return span_ - other.span_; }
+        bool operator==(const iterator& other) const { return span_ == other.span_; }
+        bool operator!=(const iterator& other) const { return span_ != other.span_; }
+
+    private:
+        const char* text_ = nullptr;
+        const TextSpan* span_ = nullptr;
+    };
+
+    TextRange() = default;
+    TextRange(const char* text, const TextSpan* first, size_t count) : text_(text), first_(first), count_(count) {}
+
+    iterator begin() const { return iterator(text_, first_); }
+    iterator end() const { return iterator(text_, first_ + count_); }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    std::string_view operator[](size_t index) const { return begin()[static_cast<std::ptrdiff_t>(index)]; }
+
+private:
+    const char* text_ = nullptr;
+    const TextSpan* first_ = nullptr;
+    size_t count_ = 0;
+};
+
+/**
+ * @brief 表格行的视图，解引用每一行得到该行单元格的 TextRange
+ */
+class RowRange {
+public:
+    /**
+     * @brief 表格中的一行
+     */
+    struct Row {
+        uint32_t firstCell = 0;  ///< 第一个单元格在文本段表中的下标
+        uint32_t cellCount = 0;  ///< 单元格数
+    };
+
+    /**
+     * @brief 行迭代器
+     */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TextRange;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TextRange;
+
+        iterator() = default;
+        iterator(const char* text, const TextSpan* spans, const Row* row) : text_(text), spans_(spans), row_(row) {}
+
+        TextRange operator*() const { return TextRange(text_, spans_ + row_->firstCell, row_->cellCount); }
+        iterator& operator++() { ++row_; return *this; }
+        iterator operator++(int) { iterator old = *this; ++row_; return old; }
+        bool operator==(const iterator& other) const { return row_ == other.row_; }
+        bool operator!=(const iterator& other) const { return row_ != other.row_; }
+
+    private:
+        const char* text_ = nullptr;
+        const TextSpan* spans_ = nullptr;
+        const Row* row_ = nullptr;
+    };
+
+    RowRange() = default;
+    RowRange(const char* text, const TextSpan* spans, const Row* first, size_t count)
+        : text_(text), spans_(spans), first_(first), count_(count) {}
+
+    iterator begin() const { return iterator(text_, spans_, first_); }
+    iterator end() const { return iterator(text_, spans_, first_ + count_); }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    TextRange operator[](size_t index) const { return *iterator(text_, spans_, first_ + index); }
+
+private:
+    const char* text_ = nullptr;
+    const TextSpan* spans_ = nullptr;
+    const Row* first_ = nullptr;
+    size_t count_ = 0;
+};
+
+/**
+ * @brief 列式文档
+ *
+ * 由 Document 构建，或从快照文件映射的只读文档。所有数组只是指向底层存储的视图：
+ * 从 Document 构建时文本全部复制到文档自己的缓冲区中，与原文档的存储方式无关；
+ * 从快照加载时数组直接指向映射的文件，不做反序列化。
+ * 图片只在数组中记录格式、尺寸和大小，数据通过 imageElement() 按需读取（元素位于原文档的存储区时，
+ * 原文档必须比快照活得更久）。复制 FlatDocument 共享同一份底层存储。
+ */
+class FlatDocument {
+public:
+    /**
+     * @brief 图片信息
+     */
+    struct ImageInfo {
+        int32_t width = 0;        ///< 宽度（像素）
+        int32_t height = 0;       ///< 高度（像素）
+        TextSpan format;          ///< 格式
+        uint64_t dataOffset = 0;  ///< 数据在快照图片区中的偏移（只对快照有意义）
+        uint64_t dataSize = 0;    ///< 数据字节数
+    };
+
+    /**
+     * @brief 单个元素的视图
+     *
+     * 只保存文档指针和下标，按值传递。访问与元素类型不符的属性时返回空值。
+     */
+    class ElementView {
+    public:
+        ElementView(const FlatDocument* doc, size_t index) : doc_(doc), index_(index) {}
+
+        /**
+         * @brief 获取元素类型
+         * @return ElementType 元素类型
+         */
+        ElementType type() const { return static_cast<ElementType>(doc_->types_[index_]); }
+
+        /**
+         * @brief 获取文本元素或标题的文本
+         * @return string_view 文本
+         */
+        std::string_view text() const;
+
+        /**
+         * @brief 获取标题级别
+         * @return int 标题级别（1-6），不是标题时返回 0
+         */
+        int headingLevel() const;
+
+        /**
+         * @brief 获取段落的文本运行
+         * @return TextRange 文本运行
+         */
+        TextRange runs() const;
+
+        /**
+         * @brief 获取段落的列表级别
+         * @return int 列表级别，不是列表项时返回 -1
+         */
+        int listLevel() const;
+
+        /**
+         * @brief 获取段落的编号格式
+         * @return string_view 编号格式
+         */
+        std::string_view listFormat() const;
+
+        /**
+         * @brief 获取表格的行
+         * @return RowRange 表格行
+         */
+        RowRange rows() const;
+
+        /**
+         * @brief 获取图片信息
+         * @return const ImageInfo* 图片信息，不是图片时返回 nullptr
+         */
+        const ImageInfo* image() const;
+
+        /**
+         * @brief 获取用于读取图片数据的图片元素
+         * @return shared_ptr<const ImageElement> 图片元素，不是图片时为空
+         *
+         * 从 Document 构建时是原图片元素；从快照加载时是从映射的文件中读取数据的元素。
+         */
+        std::shared_ptr<const ImageElement> imageElement() const;
+
+    private:
+        const FlatDocument* doc_;
+        size_t index_;
+    };
+
+    /**
+     * @brief 元素迭代器，解引用得到 ElementView
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ElementView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ElementView;
+
+        const_iterator(const FlatDocument* doc, size_t index) : doc_(doc), index_(index) {}
+
+        ElementView operator*() const { return ElementView(doc_, index_); }
+        const_iterator& operator++() { ++index_; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++index_; return old; }
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        const FlatDocument* doc_;
+        size_t index_;
+    };
+
+    /**
+     * @brief 构造空文档
+     */
+    FlatDocument() = default;
+
+    /**
+     * @brief 从文档构建
+     * @param doc 源文档
+     *
+     * 文本总量超过4GB时抛出 std::length_error。
+     */
+    explicit FlatDocument(const Document& doc);
+
+    /**
+     * @brief 保存为快照文件
+     * @param filePath 快照文件路径
+     * @return bool 保存是否成功
+     *
+     * 快照包含全部数组和图片数据（相同内容的图片只保存一份），可以在之后的运行中
+     * 用 loadFromSnapshot() 直接映射，不再解压和解析原文档。会读取延迟加载的图片数据。
+     */
+    bool saveSnapshot(const std::string& filePath) const;
+
+    /**
+     * @brief 从快照文件加载
+     * @param filePath 快照文件路径
+     * @return bool 加载是否成功
+     *
+     * 文件被映射到内存，数组直接指向映射的字节；加载时只校验文件头和各数组的下标范围。
+     * 版本不符或文件损坏时返回 false，文档保持原状。
+     */
+    bool loadFromSnapshot(const std::string& filePath);
+
+    /**
+     * @brief 获取文档标题
+     * @return const string& 文档标题
+     */
+    const std::string& getTitle() const { return title_; }
+
+    /**
+     * @brief 获取元素数
+     * @return size_t 元素数
+     */
+    size_t size() const { return types_.size; }
+
+    /**
+     * @brief 判断是否没有元素
+     * @return bool 是否为空
+     */
+    bool empty() const { return types_.size == 0; }
+
+    /**
+     * @brief 获取指定下标的元素
+     * @param index 下标
+     * @return ElementView 元素视图
+     */
+    ElementView operator[](size_t index) const { return ElementView(this, index); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, types_.size); }
+
+    /**
+     * @brief 获取文本段的内容
+     * @param span 文本段（如 ImageInfo::format）
+     * @return string_view 文本
+     */
+    std::string_view text(const TextSpan& span) const {
+        return std::string_view(text_.data + span.offset, span.length);
+    }
+
+    /**
+     * @brief 获取文本缓冲区的字节数
+     * @return size_t 字节数
+     */
+    size_t textBytes() const { return text_.size; }
+
+private:
+    /**
+     * @brief 段落副表项
+     */
+    struct Paragraph {
+        uint32_t firstRun = 0;  ///< 第一个文本运行在文本段表中的下标
+        uint32_t runCount = 0;  ///< 文本运行数
+        int32_t listLevel = -1; ///< 列表级别
+        TextSpan listFormat;    ///< 编号格式
+    };
+
+    /**
+     * @brief 标题副表项
+     */
+    struct Heading {
+        TextSpan text;      ///< 标题文本
+        int32_t level = 1;  ///< 标题级别
+    };
+
+    /**
+     * @brief 表格副表项
+     */
+    struct Table {
+        uint32_t firstRow = 0;  ///< 第一行在行表中的下标
+        uint32_t rowCount = 0;  ///< 行数
+    };
+
+    /**
+     * @brief 指向底层存储的只读数组
+     */
+    template <typename T>
+    struct Column {
+        const T* data = nullptr;
+        size_t size = 0;
+
+        const T& operator[](size_t index) const { return data[index]; }
+    };
+
+    /**
+     * @brief 从 Document 构建时持有数组的存储
+     */
+    struct Columns;
+
+    /**
+     * @brief 让各数组指向构建出的存储
+     */
+    void bind(const Columns& columns);
+
+    /**
+     * @brief 校验各数组中的下标和文本段都在范围内（用于快照），不符时抛出 std::runtime_error
+     */
+    void validate() const;
+
+    std::string title_;                     ///< 文档标题
+    std::shared_ptr<const void> storage_;   ///< 底层存储（构建出的数组或映射的快照文件）
+    Column<uint8_t> types_;                 ///< 每个元素的类型（ElementType）
+    Column<uint32_t> slots_;                ///< 每个元素在对应副表中的下标
+    Column<char> text_;                     ///< 全部文本
+    Column<TextSpan> spans_;                ///< 文本元素、文本运行和单元格的文本段
+    Column<Paragraph> paragraphs_;          ///< 段落副表
+    Column<Heading> headings_;              ///< 标题副表
+    Column<Table> tables_;                  ///< 表格副表
+    Column<RowRange::Row> rows_;            ///< 表格行
+    Column<ImageInfo> images_;              ///< 图片副表
+    std::vector<std::shared_ptr<const ImageElement>> imageElements_;  ///< 与图片副表对应的图片元素
+};
+
+} // namespace doc_converter
@@ -0,0 +1,131 @@
+/**
+ * @file html_converter.hpp
+ * @brief HTML转换器
+ *
+ * 把文档渲染为HTML：标题为 <h1>~<h6>，段落为 <p>，列表项按级别嵌套在 <ul>/<ol> 中，
+ * 表格为 <table>，图片为 <img>。文本经转义后写出，转义按块扫描，整段复制不需要转义的片段。
+ *
+ * 以名称 "HTML" 注册在 ConverterFactory 中。
+ */
+
+#pragma once
+
+#include "document.hpp"
+#include "element_cursor.hpp"
+#include "image_store.hpp"
+#include "output_sink.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief HTML转换器
+ *
+ * 转换过程中的状态都在调用内部，同一个转换器可以在多个线程中同时使用。
+ */
+class HtmlConverter : public Converter {
+public:
+    /**
+     * @brief 构造函数
+     * @param imageStore 图片文件去重用的存储（为空时创建一个），多个转换器共用时跨文档去重
+     */
+    explicit HtmlConverter(std::shared_ptr<ImageStore> imageStore = nullptr);
+
+    using Converter::convert;
+
+    /**
+     * @brief 转换文档并写入文件
+     * @param doc 要转换的文档
+     * @param outputPath 输出文件路径
+     * @return bool 转换是否成功
+     *
+     * ImageOutputMode::Files 时图片写入输出文件旁的 "<文件名>_files" 目录。
+     */
+    bool convert(const Document& doc, const std::string& outputPath) override;
+
+    /**
+     * @brief 转换文档并写入输出层
+     * @param doc 要转换的文档
+     * @param sink 输出层
+     * @return bool 转换是否成功
+     *
+     * ImageOutputMode::Files 时图片写入 setImageDirectory() 设置的目录，未设置时嵌入。
+     */
+    bool convert(const Document& doc, OutputSink& sink) override;
+
+    /**
+     * @brief 边加载边转换文档并写入文件
+     * @param cursor 正在加载的文档的元素游标
+     * @param outputPath 输出文件路径
+     * @return bool 加载和转换是否都成功
+     */
+    bool convert(ElementCursor& cursor, const std::string& outputPath) override;
+
+    /**
+     * @brief 边加载边转换文档并写入输出层
+     * @param cursor 正在加载的文档的元素游标
+     * @param sink 输出层
+     * @return bool 加载和转换是否都成功
+     */
+    bool convert(ElementCursor& cursor, OutputSink& sink) override;
+
+    /**
+     * @brief 获取转换器名称
+     * @return string "HTML"
+     */
+    std::string getName() const override { return "HTML"; }
+
+    /**
+     * @brief 获取支持的格式列表
+     * @return vector<string> {"html", "htm"}
+     */
+    std::vector<std::string> getSupportedExtensions() const override { return {"html", "htm"}; }
+
+    /**
+     * @brief 设置图片的输出方式
+     * @param mode 输出方式，默认为 ImageOutputMode::Embed
+     */
+    void setImageMode(ImageOutputMode mode) { imageMode_ = mode; }
+
+    /**
+     * @brief 获取图片的输出方式
+     * @return ImageOutputMode 输出方式
+     */
+    ImageOutputMode getImageMode() const { return imageMode_; }
+
+    /**
+     * @brief 设置写入输出层时图片文件的目录
+     * @param directory 目录（不存在时创建），<img> 的 src 为 "<目录>/<文件名>"
+     */
+    void setImageDirectory(const std::string& directory) { imageDirectory_ = directory; }
+
+    /**
+     * @brief 获取写入输出层时图片文件的目录
+     * @return const string& 目录，未设置时为空
+     */
+    const std::string& getImageDirectory() const { return imageDirectory_; }
+
+private:
+    class Writer;
+
+    /**
+     * @brief 写出文档元素
+     * @param title 文档标题
+     * @param outputPath 输出文件路径，写入输出层时为空
+     * @param sink 输出层
+     * @param cursor 正在加载的文档的元素游标，为空时写出 doc 的元素
+     * @param doc 已加载的文档
+     *
+     * 写入失败时抛出异常。
+     */
+    void write(const std::string& title, const std::string& outputPath, OutputSink& sink,
+               ElementCursor* cursor, const Document* doc) const;
+
+    std::shared_ptr<ImageStore> imageStore_;              ///< 图片文件去重用的存储
+    ImageOutputMode imageMode_ = ImageOutputMode::Embed;  ///< 图片的输出方式
+    std::string imageDirectory_;                          ///< 写入输出层时图片文件的目录
+};
+
+} // namespace doc_converter
@@ -0,0 +1,142 @@
+/**
+ * @file image_store.hpp
+ * @brief 按内容寻址的图片存储
+ *
+ * 批量转换时同一个徽标、信头图片会出现在成千上万个文档中。ImageStore 以
+ * 64 位内容哈希为键，相同的图片数据在一个文档内以及共享同一存储的一批文档之间只保存一份；
+ * 导出图片的转换器用 writeOnce() 按哈希命名输出文件，每个不同的图片只写一次。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief 图片内容哈希
+ */
+using ImageHash = uint64_t;
+
+/**
+ * @brief 转换器输出图片的方式
+ */
+enum class ImageOutputMode {
+    Embed,  ///< 以 data URI 嵌入输出文件
+    Files   ///< 经 writeOnce() 写入单独的图片文件，输出中引用文件
+};
+
+/**
+ * @brief 存储中的图片数据
+ */
+struct StoredImage {
+    ImageHash hash = 0;                                ///< 内容哈希（存储内唯一）
+    std::shared_ptr<const std::vector<uint8_t>> data;  ///< 共享的图片数据
+};
+
+/**
+ * @brief 图片存储
+ *
+ * 存储只弱引用图片数据：数据由引用它的图片元素共同持有，所有元素销毁后随之释放。
+ * 线程安全，可以在并行加载的多个文档之间共享。
+ */
+class ImageStore {
+public:
+    ImageStore() = default;
+    ImageStore(const ImageStore&) = delete;
+    ImageStore& operator=(const ImageStore&) = delete;
+
+    /**
+     * @brief 计算内容哈希
+     * @param data 数据
+     * @param size 字节数
+     * @return ImageHash 64 位哈希
+     */
+    static ImageHash hash(const uint8_t* data, size_t size);
+
+    /**
+     * @brief 存入图片数据
+     * @param data 图片数据（移入存储）
+     * @return StoredImage 已有相同内容时返回已有的数据，否则返回新存入的数据
+     *
+     * 内容不同而哈希相同时顺延到下一个未占用的哈希值，返回的哈希在存储内唯一。
+     */
+    StoredImage intern(std::vector<uint8_t>&& data);
+
+    /**
+     * @brief 把图片写入目录，同一目录下相同的图片只写一次
+     * @param image 存储中的图片
+     * @param format 图片格式（用作扩展名，不满足 isSafeFormat() 时改用 "bin"）
+     * @param directory 输出目录（必须已存在）
+     * @return string 文件名（不含目录），写入失败时抛出 std::runtime_error
+     *
+     * 目录中已有同名且内容相同的文件时（例如之前的批次写入的）不再重写，否则先写临时文件再改名，
+     * 不会留下写了一半的文件。并发写同一个文件时只有一个调用方写入，其余调用方等待写入完成后返回，
+     * 写入失败时都抛出异常。
+     */
+    std::string writeOnce(const StoredImage& image, const std::string& format, const std::string& directory);
+
+    /**
+     * @brief 获取图片的输出文件名
+     * @param hash 内容哈希
+     * @param format 图片格式
+     * @return string 十六进制哈希加扩展名（如 "00ab...ef.png"）
+     */
+    static std::string fileName(ImageHash hash, const std::string& format);
+
+    /**
+     * @brief 判断图片格式能否用作文件扩展名
+     * @param format 图片格式
+     * @return bool 是否为1-8个小写字母或数字
+     *
+     * 格式来自不可信的输入（部件名、快照），写文件前必须经过该检查。
+     */
+    static bool isSafeFormat(const std::string& format);
+
+    /**
+     * @brief 获取仍在使用的不同图片数
+     * @return size_t 图片数
+     */
+    size_t size() const;
+
+    /**
+     * @brief 获取因去重而没有重复保存的字节数
+     * @return size_t 字节数
+     */
+    size_t dedupedBytes() const;
+
+private:
+    /**
+     * @brief 已写出（或正在写）的文件
+     */
+    struct WrittenFile {
+        std::weak_ptr<const std::vector<uint8_t>> data;  ///< 写出的图片数据
+        std::shared_future<void> done;                   ///< 写入完成（失败时保存异常）
+    };
+
+    /**
+     * @brief 清除数据已释放的条目（调用方持有锁）
+     */
+    void purgeExpired();
+
+    /**
+     * @brief 清除数据已释放且已写完的文件记录（调用方持有锁）
+     */
+    void purgeWritten();
+
+    mutable std::mutex mutex_;  ///< 保护下面的成员
+    std::unordered_map<ImageHash, std::weak_ptr<const std::vector<uint8_t>>> entries_;  ///< 哈希到图片数据
+    std::unordered_map<std::string, WrittenFile> written_;  ///< 文件路径到写入记录
+    size_t purgeThreshold_ = 64;  ///< 条目数达到该值时清理已释放的条目
+    size_t writtenPurgeThreshold_ = 64;  ///< 文件记录数达到该值时清理
+    size_t dedupedBytes_ = 0;     ///< 去重节省的字节数
+};
+
+} // namespace doc_converter
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <mutex>
 
 namespace doc_converter {
 
@@ -31,6 +32,7 @@ enum class LogLevel {
  * @brief 日志系统类
  * 
  * 提供了简单的日志记录功能，支持不同级别的日志输出。
+ * 日志输出是线程安全的，可以在并行解析的工作线程中使用。
  */
 class Logger {
 public:
@@ -106,6 +108,7 @@ private:
     LogLevel currentLevel_ = LogLevel::INFO;  ///< 当前日志级别
     std::ostream* output_ = &std::cout;       ///< 日志输出流
     std::ofstream fileStream_;                ///< 文件输出流
+    std::mutex mutex_;                        ///< 保护输出流的互斥锁
 };
 
 } // namespace doc_converter 
\ No newline at end of file
@@ -0,0 +1,98 @@
+/**
+ * @file mapped_file.hpp
+ * @brief 只读文件输入层
+ *
+ * 普通文件通过mmap映射到内存，解析器直接在映射的字节上工作，不经过iostream拷贝；
+ * 管道、字符设备等无法映射的输入按大块read()读入自有缓冲区。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief 只读文件内容
+ *
+ * 只能移动，不能拷贝。映射期间如果文件被其他进程截断，访问超出部分会触发SIGBUS，
+ * 这与其他基于mmap的读取器相同。
+ */
+class MappedFile {
+public:
+    /**
+     * @brief 访问模式提示
+     */
+    enum class Access {
+        Sequential,  ///< 从头到尾顺序读取（madvise(MADV_SEQUENTIAL)）
+        Random       ///< 按偏移随机访问（如ZIP中央目录、CFB扇区链）
+    };
+
+    /**
+     * @brief 构造空对象
+     */
+    MappedFile() = default;
+
+    /**
+     * @brief 打开文件
+     * @param filePath 文件路径
+     * @param access 访问模式提示
+     *
+     * 文件无法打开或读取时抛出 std::runtime_error。
+     */
+    explicit MappedFile(const std::string& filePath, Access access = Access::Sequential);
+
+    /**
+     * @brief 接管内存中的数据
+     * @param bytes 数据
+     */
+    explicit MappedFile(std::vector<uint8_t> bytes);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief 获取数据起始地址
+     * @return const uint8_t* 数据
+     */
+    const uint8_t* data() const { return data_; }
+
+    /**
+     * @brief 获取数据大小
+     * @return size_t 字节数
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief 以字符视图形式访问数据
+     * @return string_view 文件内容
+     */
+    std::string_view view() const { return std::string_view(reinterpret_cast<const char*>(data_), size_); }
+
+    /**
+     * @brief 数据是否来自内存映射
+     * @return bool 是否为映射
+     */
+    bool isMapped() const { return mapped_; }
+
+private:
+    /**
+     * @brief 释放映射或缓冲区
+     */
+    void reset() noexcept;
+
+    const uint8_t* data_ = nullptr;  ///< 数据起始地址
+    size_t size_ = 0;                ///< 数据大小
+    bool mapped_ = false;            ///< 是否为mmap映射
+    std::vector<uint8_t> buffer_;    ///< 无法映射时的自有缓冲区
+};
+
+} // namespace doc_converter
@@ -0,0 +1,192 @@
+/**
+ * @file memory_usage.hpp
+ * @brief 文档内存占用的统计和加载预算
+ *
+ * 加载后的文档占用多少内存很难事先估计。MemoryUsage 按类别统计文档的内存占用，
+ * 用于确定工作进程的规模；MemoryBudget 在加载过程中累计新元素的占用，
+ * 超出预算时立即中止加载，而不是一直解析到进程被 OOM killer 结束。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief 文档内存占用（字节数为估算值，不含分配器自身的开销）
+ */
+struct MemoryUsage {
+    size_t elementCount = 0;      ///< 元素数
+    size_t elementBytes = 0;      ///< 元素对象本身
+    size_t textBytes = 0;         ///< 标题、段落和文本元素自己持有的文本
+    size_t sharedTextBytes = 0;   ///< 元素引用的外部文本（存储区或驻留池中，不计入 total()）
+    size_t tableCells = 0;        ///< 表格单元格数
+    size_t tableBytes = 0;        ///< 表格行、单元格及单元格持有的文本
+    size_t imageBytes = 0;        ///< 已加载的图片数据（共享的数据只计一次）
+    size_t lazyImageBytes = 0;    ///< 尚未加载的图片数据（不计入 total()）
+    size_t containerBytes = 0;    ///< 元素列表、存储区和驻留池等容器
+
+    /**
+     * @brief 获取总占用
+     * @return size_t 元素、文本、表格、已加载图片和容器占用的字节数之和
+     */
+    size_t total() const {
+        return elementBytes + textBytes + tableBytes + imageBytes + containerBytes;
+    }
+
+    /**
+     * @brief 登记共享的缓冲区（如多个图片元素共用的图片数据）
+     * @param buffer 缓冲区地址
+     * @return bool 第一次登记时为 true，调用方只在此时计入其大小
+     */
+    bool countOnce(const void* buffer) { return buffer && counted_.insert(buffer).second; }
+
+    /**
+     * @brief 获取字符串在堆上占用的字节数（短字符串优化时为 0）
+     * @param text 字符串
+     * @return size_t 字节数
+     */
+    static size_t heapBytes(const std::string& text) {
+        static const size_t inlineCapacity = std::string().capacity();
+        return text.capacity() > inlineCapacity ? text.capacity() + 1 : 0;
+    }
+
+    /**
+     * @brief 获取 vector 缓冲区占用的字节数
+     * @param values vector
+     * @return size_t 字节数
+     */
+    template <typename T>
+    static size_t heapBytes(const std::vector<T>& values) {
+        return values.capacity() * sizeof(T);
+    }
+
+private:
+    std::unordered_set<const void*> counted_;  ///< 已计入的共享缓冲区
+};
+
+/**
+ * @brief 超出内存预算时加载中止抛出的异常
+ */
+class MemoryBudgetExceeded : public std::runtime_error {
+public:
+    /**
+     * @brief 构造函数
+     * @param required 加载到此时需要的字节数
+     * @param budget 预算字节数
+     */
+    MemoryBudgetExceeded(size_t required, size_t budget)
+        : std::runtime_error("Memory budget exceeded: document needs at least " + std::to_string(required) +
+                             " bytes, budget is " + std::to_string(budget) + " bytes"),
+          required_(required), budget_(budget) {}
+
+    /**
+     * @brief 获取加载到中止时需要的字节数
+     * @return size_t 字节数
+     */
+    size_t required() const { return required_; }
+
+    /**
+     * @brief 获取预算字节数
+     * @return size_t 字节数
+     */
+    size_t budget() const { return budget_; }
+
+private:
+    size_t required_;
+    size_t budget_;
+};
+
+/**
+ * @brief 加载过程中的内存预算
+ *
+ * 线程安全，并行解析的分块和附属部件共用一个预算。
+ */
+class MemoryBudget {
+public:
+    /**
+     * @brief 构造函数
+     * @param limit 预算字节数
+     * @param used 加载开始前已占用的字节数
+     */
+    explicit MemoryBudget(size_t limit, size_t used = 0) : limit_(limit), used_(used) {}
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    /**
+     * @brief 计入新分配的内存
+     * @param bytes 字节数
+     *
+     * 累计值超过预算时抛出 MemoryBudgetExceeded。
+     */
+    void charge(size_t bytes) {
+        size_t previous = used_.fetch_add(bytes, std::memory_order_relaxed);
+        if (bytes > limit_ || previous > limit_ - bytes) {
+            throw MemoryBudgetExceeded(bytes > SIZE_MAX - previous ? SIZE_MAX : previous + bytes, limit_);
+        }
+    }
+
+    /**
+     * @brief 撤销之前计入的内存
+     * @param bytes 字节数（不超过之前计入的字节数）
+     */
+    void release(size_t bytes) { used_.fetch_sub(bytes, std::memory_order_relaxed); }
+
+    /**
+     * @brief 临时分配的预留
+     *
+     * 用于解析期间的临时缓冲区（XML树、解压后的部件）：构造时计入预算，析构时撤销，
+     * 预留期间新元素的占用与临时占用一起受预算限制。
+     */
+    class Reservation {
+    public:
+        /**
+         * @brief 构造函数
+         * @param budget 预算
+         * @param bytes 预留的字节数，剩余预算不足时抛出 MemoryBudgetExceeded
+         */
+        Reservation(MemoryBudget& budget, size_t bytes) : budget_(budget), bytes_(bytes) {
+            try {
+                budget_.charge(bytes_);
+            } catch (...) {
+                budget_.release(bytes_);
+                throw;
+            }
+        }
+
+        ~Reservation() { budget_.release(bytes_); }
+
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+    private:
+        MemoryBudget& budget_;
+        size_t bytes_;
+    };
+
+    /**
+     * @brief 获取已计入的字节数
+     * @return size_t 字节数
+     */
+    size_t used() const { return used_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取预算字节数
+     * @return size_t 字节数
+     */
+    size_t limit() const { return limit_; }
+
+private:
+    const size_t limit_;
+    std::atomic<size_t> used_;
+};
+
+} // namespace doc_converter
@@ -0,0 +1,86 @@
+/**
+ * @file multi_target_converter.hpp
+ * @brief 一次解析、多个目标的转换
+ *
+ * 同一个源文档经常要同时输出txt、html和md。解析是开销最大的部分，
+ * MultiTargetConverter 只解析一次，然后在各自的线程上把同一个（只读的）文档
+ * 并发交给每个目标的转换器，并分别报告每个目标的结果。
+ */
+
+#pragma once
+
+#include "document.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief 转换目标
+ */
+struct ConversionTarget {
+    /**
+     * @brief 使用 ConverterFactory 中注册的转换器
+     * @param name 转换器名称
+     * @param path 输出文件路径
+     */
+    ConversionTarget(std::string name, std::string path)
+        : converterName(std::move(name)), outputPath(std::move(path)) {}
+
+    /**
+     * @brief 使用指定的转换器
+     * @param instance 转换器
+     * @param path 输出文件路径
+     */
+    ConversionTarget(std::shared_ptr<Converter> instance, std::string path)
+        : outputPath(std::move(path)), converter(std::move(instance)) {}
+
+    std::string converterName;             ///< ConverterFactory 中注册的转换器名称
+    std::string outputPath;                ///< 输出文件路径
+    std::shared_ptr<Converter> converter;  ///< 直接指定的转换器（不为空时忽略 converterName）
+};
+
+/**
+ * @brief 单个目标的转换结果
+ */
+struct ConversionResult {
+    std::string converterName;                 ///< 转换器名称
+    std::string outputPath;                    ///< 输出文件路径
+    bool success = false;                      ///< 是否成功
+    std::string error;                         ///< 失败原因，成功时为空
+    std::chrono::milliseconds elapsed{0};      ///< 转换用时（未执行的目标为 0）
+};
+
+/**
+ * @brief 一次解析、多个目标的转换
+ */
+class MultiTargetConverter {
+public:
+    /**
+     * @brief 把已加载的文档并发转换到多个目标
+     * @param doc 已加载的文档，转换期间不能修改
+     * @param targets 转换目标
+     * @return vector<ConversionResult> 与 targets 一一对应的结果
+     *
+     * 每个目标在单独的线程上转换，一个目标失败不影响其他目标。转换器名称未注册、
+     * 输出路径与前面的目标相同的目标不执行。同一个转换器实例出现在多个目标中时，
+     * 它必须可以在多个线程中同时使用（内置的转换器都可以）。
+     */
+    static std::vector<ConversionResult> convert(const Document& doc,
+                                                 const std::vector<ConversionTarget>& targets);
+
+    /**
+     * @brief 加载文件一次，然后并发转换到多个目标
+     * @param doc 用于加载的文档对象
+     * @param inputPath 输入文件路径
+     * @param targets 转换目标
+     * @return vector<ConversionResult> 与 targets 一一对应的结果，加载失败时全部失败
+     */
+    static std::vector<ConversionResult> convertFile(Document& doc, const std::string& inputPath,
+                                                     const std::vector<ConversionTarget>& targets);
+};
+
+} // namespace doc_converter
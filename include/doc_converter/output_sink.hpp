@@ -0,0 +1,206 @@
+/**
+ * @file output_sink.hpp
+ * @brief 转换器的输出层
+ *
+ * 转换器把格式化好的文本写入 OutputSink，而不是逐个 << 写入 std::ofstream：
+ * - 输出先积累在一个较大的用户态缓冲区中，缓冲区满时整块写出
+ * - 超过半个缓冲区的大段输出不再复制，与缓冲区中的内容一起以 writev 方式写出
+ * - 目标可以互换：文件描述符（FileSink）、内存（MemorySink）或直接丢弃（NullSink），
+ *   NullSink 用于单独测量转换器的格式化开销
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace doc_converter {
+
+/**
+ * @brief 输出层基类
+ *
+ * 写入失败时抛出 std::runtime_error。非线程安全。
+ */
+class OutputSink {
+public:
+    static constexpr size_t kDefaultBufferSize = 256 * 1024;  ///< 默认缓冲区大小
+
+    virtual ~OutputSink() = default;
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    /**
+     * @brief 写入文本
+     * @param text 文本
+     */
+    void write(std::string_view text) {
+        if (text.size() <= capacity_ - used_) {
+            std::memcpy(buffer_.get() + used_, text.data(), text.size());
+            used_ += text.size();
+            return;
+        }
+        writeLarge(text);
+    }
+
+    /**
+     * @brief 写入单个字符
+     * @param c 字符
+     */
+    void put(char c) {
+        if (used_ == capacity_) {
+            flushBuffer();
+        }
+        buffer_[used_++] = c;
+    }
+
+    /**
+     * @brief 写入重复的字符
+     * @param c 字符
+     * @param count 重复次数
+     */
+    void fill(char c, size_t count);
+
+    OutputSink& operator<<(std::string_view text) {
+        write(text);
+        return *this;
+    }
+
+    OutputSink& operator<<(char c) {
+        put(c);
+        return *this;
+    }
+
+    /**
+     * @brief 把缓冲区中的内容写到目标
+     */
+    void flush() { flushBuffer(); }
+
+    /**
+     * @brief 获取已写入的字节数（包括仍在缓冲区中的）
+     * @return size_t 字节数
+     */
+    size_t bytesWritten() const { return flushed_ + used_; }
+
+protected:
+    /**
+     * @brief 构造函数
+     * @param bufferSize 缓冲区大小（至少 1 字节）
+     */
+    explicit OutputSink(size_t bufferSize);
+
+    /**
+     * @brief 按顺序把若干段字节写到目标（writev 语义）
+     * @param chunks 各段字节
+     * @param count 段数
+     *
+     * 写入失败时抛出 std::runtime_error。
+     */
+    virtual void writeChunks(const std::string_view* chunks, size_t count) = 0;
+
+private:
+    /**
+     * @brief 写入放不进缓冲区剩余空间的文本
+     * @param text 文本
+     */
+    void writeLarge(std::string_view text);
+
+    /**
+     * @brief 把缓冲区中的内容写到目标并清空缓冲区
+     */
+    void flushBuffer();
+
+    std::unique_ptr<char[]> buffer_;  ///< 输出缓冲区
+    size_t capacity_;                 ///< 缓冲区大小
+    size_t used_ = 0;                 ///< 缓冲区中的字节数
+    size_t flushed_ = 0;              ///< 已写到目标的字节数
+};
+
+/**
+ * @brief 写入文件描述符的输出层
+ */
+class FileSink : public OutputSink {
+public:
+    /**
+     * @brief 创建（或截断）并打开输出文件
+     * @param filePath 文件路径
+     * @param bufferSize 缓冲区大小
+     *
+     * 文件无法打开时抛出 std::runtime_error。
+     */
+    explicit FileSink(const std::string& filePath, size_t bufferSize = kDefaultBufferSize);
+
+    /**
+     * @brief 写入已打开的文件描述符（如标准输出），不负责关闭
+     * @param fd 文件描述符
+     * @param bufferSize 缓冲区大小
+     */
+    explicit FileSink(int fd, size_t bufferSize = kDefaultBufferSize);
+
+    /**
+     * @brief 析构函数，写出剩余内容并关闭文件（忽略错误，需要检查错误时先调用 close()）
+     */
+    ~FileSink() override;
+
+    /**
+     * @brief 写出剩余内容并关闭文件
+     *
+     * 写入或关闭失败时抛出 std::runtime_error。可以重复调用。
+     */
+    void close();
+
+protected:
+    void writeChunks(const std::string_view* chunks, size_t count) override;
+
+private:
+    std::string path_;   ///< 文件路径（用于错误信息）
+    int fd_;             ///< 文件描述符，关闭后为 -1
+    bool owned_;         ///< 是否由本对象关闭
+};
+
+/**
+ * @brief 写入内存的输出层
+ */
+class MemorySink : public OutputSink {
+public:
+    /**
+     * @brief 构造函数
+     * @param bufferSize 缓冲区大小
+     */
+    explicit MemorySink(size_t bufferSize = 16 * 1024) : OutputSink(bufferSize) {}
+
+    /**
+     * @brief 获取全部输出
+     * @return const string& 输出内容（先写出缓冲区）
+     */
+    const std::string& str() {
+        flush();
+        return data_;
+    }
+
+protected:
+    void writeChunks(const std::string_view* chunks, size_t count) override;
+
+private:
+    std::string data_;  ///< 已写出的内容
+};
+
+/**
+ * @brief 丢弃全部输出的输出层，只统计字节数
+ */
+class NullSink : public OutputSink {
+public:
+    /**
+     * @brief 构造函数
+     * @param bufferSize 缓冲区大小（与实际输出使用相同的大小，使复制开销一致）
+     */
+    explicit NullSink(size_t bufferSize = kDefaultBufferSize) : OutputSink(bufferSize) {}
+
+protected:
+    void writeChunks(const std::string_view* /*chunks*/, size_t /*count*/) override {}
+};
+
+} // namespace doc_converter
@@ -0,0 +1,62 @@
+/**
+ * @file string_pool.hpp
+ * @brief 文档文本的驻留池
+ *
+ * 以表格为主的文档（报表、清单）中同一个单元格文本往往重复出现成千上万次。
+ * StringPool 对相同的文本只保存一份，元素只保存指向池中副本的 string_view。
+ * 一个池可以由单个文档使用，也可以在一批文档之间共享。
+ */
+
+#pragma once
+
+#include "doc_converter/text_arena.hpp"
+#include <cstddef>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_set>
+
+namespace doc_converter {
+
+/**
+ * @brief 文本驻留池
+ *
+ * 存入的文本在池销毁前一直有效且地址不变。线程安全：查找持共享锁，
+ * 插入新文本时持独占锁，因此并行解析的分块和同时加载的多个文档可以共用一个池。
+ */
+class StringPool {
+public:
+    /**
+     * @brief 构造函数
+     * @param initialSize 文本缓冲区第一块的大小
+     */
+    explicit StringPool(size_t initialSize = 64 * 1024) : text_(initialSize) {}
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    /**
+     * @brief 驻留文本
+     * @param text 文本
+     * @return string_view 池中与 text 相等的唯一副本
+     */
+    std::string_view intern(std::string_view text);
+
+    /**
+     * @brief 获取池中不同文本的数量
+     * @return size_t 文本数
+     */
+    size_t size() const;
+
+    /**
+     * @brief 获取池中文本的总字节数
+     * @return size_t 字节数
+     */
+    size_t bytesStored() const;
+
+private:
+    mutable std::shared_mutex mutex_;               ///< 保护下面两个成员
+    std::unordered_set<std::string_view> strings_;  ///< 已驻留的文本（指向 text_）
+    TextArena text_;                                ///< 文本存储区
+};
+
+} // namespace doc_converter
@@ -0,0 +1,61 @@
+/**
+ * @file text_arena.hpp
+ * @brief 文档文本的单调分配存储区
+ *
+ * 解析器把元素文本连续地写入存储区，元素只保存指向其中的 string_view，
+ * 避免每个文本片段单独分配一个 std::string。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <string_view>
+
+namespace doc_converter {
+
+/**
+ * @brief 文本存储区
+ *
+ * 只追加、不释放单个片段：存入的文本在存储区销毁前一直有效且地址不变。
+ * 非线程安全，并行解析时每个线程使用各自的存储区。
+ */
+class TextArena {
+public:
+    /**
+     * @brief 构造函数
+     * @param initialSize 第一块缓冲区的大小（之后按几何级数增长）
+     */
+    explicit TextArena(size_t initialSize = 64 * 1024) : resource_(initialSize) {}
+
+    TextArena(const TextArena&) = delete;
+    TextArena& operator=(const TextArena&) = delete;
+
+    /**
+     * @brief 存入文本
+     * @param text 文本
+     * @return string_view 指向存储区内副本的视图
+     */
+    std::string_view store(std::string_view text) {
+        if (text.empty()) {
+            return std::string_view();
+        }
+        char* copy = static_cast<char*>(resource_.allocate(text.size(), 1));
+        std::memcpy(copy, text.data(), text.size());
+        bytesStored_ += text.size();
+        return std::string_view(copy, text.size());
+    }
+
+    /**
+     * @brief 获取已存入的文本字节数
+     * @return size_t 字节数
+     */
+    size_t bytesStored() const { return bytesStored_; }
+
+private:
+    std::pmr::monotonic_buffer_resource resource_;  ///< 单调分配的缓冲区
+    size_t bytesStored_ = 0;                        ///< 已存入的字节数
+};
+
+} // namespace doc_converter
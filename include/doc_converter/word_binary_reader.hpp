@@ -0,0 +1,67 @@
+/**
+ * @file word_binary_reader.hpp
+ * @brief Word 97-2003 二进制格式（.doc）的文本提取器
+ *
+ * 从CFB容器中读取WordDocument流和表格流，根据FIB定位片段表（piece table），
+ * 直接得到正文文本并按段落标记切分，不依赖外部进程。
+ */
+
+#pragma once
+
+#include "doc_converter/compound_file.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace doc_converter {
+
+/**
+ * @brief Word二进制文本提取器
+ *
+ * 只处理正文（主文档）部分：
+ * - 支持压缩（cp1252）和未压缩（UTF-16LE）片段
+ * - 域代码只保留域结果
+ * - 段落标记、单元格标记和分页符作为段落边界
+ * 加密文档和Word 95及更早版本不受支持。
+ */
+class WordBinaryReader {
+public:
+    /**
+     * @brief 构造函数
+     * @param file 已打开的复合文档
+     *
+     * 读取FIB和片段表，格式不受支持时抛出 std::runtime_error。
+     */
+    explicit WordBinaryReader(const CompoundFile& file);
+
+    /**
+     * @brief 提取正文段落
+     * @return vector<string> UTF-8编码的段落文本（已去掉首尾空白，不含空段落）
+     */
+    std::vector<std::string> readParagraphs() const;
+
+private:
+    /**
+     * @brief 片段表中的一个片段
+     */
+    struct Piece {
+        uint32_t cpStart;    ///< 起始字符位置
+        uint32_t cpEnd;      ///< 结束字符位置
+        uint32_t offset;     ///< 在WordDocument流中的字节偏移
+        bool compressed;     ///< 是否为8位压缩文本
+    };
+
+    /**
+     * @brief 解析CLX结构中的片段表
+     * @param table 表格流内容
+     * @param fcClx CLX偏移
+     * @param lcbClx CLX长度
+     */
+    void parsePieceTable(const std::vector<uint8_t>& table, uint32_t fcClx, uint32_t lcbClx);
+
+    std::vector<uint8_t> wordDocument_;  ///< WordDocument流
+    std::vector<Piece> pieces_;          ///< 片段表
+    uint32_t ccpText_ = 0;               ///< 正文字符数
+};
+
+} // namespace doc_converter
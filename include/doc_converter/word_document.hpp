@@ -5,8 +5,8 @@
  * @date 2024-03-26
  * 
  * 本文件实现了Word文档的解析功能：
- * - 使用libxml2和zlib库解析.docx文件
- * - 使用antiword解析.doc文件
+ * - 使用进程内的ZIP读取器和libxml2解析.docx文件
+ * - 使用进程内的CFB读取器解析.doc文件，antiword仅作为后备
  * 主要功能：
  * - 读取.docx和.doc文件
  * - 解析文档结构（段落、标题等）
@@ -18,21 +18,46 @@
 #include "doc_converter/common.hpp"
 #include "doc_converter/document.hpp"
 #include "doc_converter/document_elements.hpp"
+#include "doc_converter/element_arena.hpp"
+#include "doc_converter/string_pool.hpp"
+#include "doc_converter/text_arena.hpp"
+#include <map>
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include <libxml/parser.h>
 #include <libxml/tree.h>
-#include <zlib.h>
+#include <libxml/xmlreader.h>
 
 namespace doc_converter {
 
+class ZipArchive;
+
+/**
+ * @brief .docx正文解析模式
+ */
+enum class ParseMode {
+    Dom,        ///< 构建完整DOM后遍历（默认）
+    Streaming,  ///< 使用xmlTextReader流式解析，内存占用只取决于最大的单个块
+    Parallel    ///< 在正文块边界切分，多线程并行解析各分块后按文档顺序合并
+};
+
+/**
+ * @brief .docx元素文本的存储方式
+ */
+enum class TextStorage {
+    Owned,  ///< 每个文本元素持有自己的std::string副本（默认）
+    Arena   ///< 文本写入文档持有的TextArena，元素只保存视图，文档销毁后失效
+};
+
 /**
  * @brief Word文档类
  * 
  * 实现了Document接口的Word文档类，提供了.docx和.doc文件的读取和解析功能。
- * - .docx文件使用libxml2和zlib库解析
- * - .doc文件使用antiword工具解析
+ * - .docx文件在进程内解压（ZipArchive），只解压需要的部件并直接送入libxml2
+ * - .doc文件在进程内读取CFB容器和片段表（WordBinaryReader），
+ *   遇到加密或Word 95等不支持的格式时回退到antiword工具
  */
 class WordDocument : public Document {
 public:
@@ -54,6 +79,17 @@ public:
      */
     bool loadFromFile(const std::string& filePath) override;
 
+    /**
+     * @brief 从文件加载文档，同时把正文元素送入队列
+     * @param filePath 文件路径
+     * @param queue 接收元素的队列
+     * @return bool 是否加载成功
+     *
+     * 每个正文元素解析完成后立即送入队列（并行解析时每个分块按文档顺序完成后送出），
+     * 页眉、页脚、脚注和尾注的元素不送入队列。
+     */
+    bool streamFromFile(const std::string& filePath, ElementQueue& queue) override;
+
     /**
      * @brief 获取文档标题
      * @return string 文档标题
@@ -66,69 +102,264 @@ public:
      */
     const std::vector<std::shared_ptr<DocumentElement>>& getElements() const override;
 
+    /**
+     * @brief 获取文档的内存占用
+     * @return MemoryUsage 正文和附属部件元素、文本存储区以及驻留池的内存占用
+     *
+     * 驻留池在多个文档之间共享时按池的全部内容计入。
+     */
+    MemoryUsage getMemoryUsage() const override;
+
     /**
      * @brief 添加文档元素
      * @param element 要添加的元素
      */
     void addElement(std::shared_ptr<DocumentElement> element) override;
 
+    /**
+     * @brief 判断当前.docx容器中是否存在指定部件
+     * @param partName 部件名（如 "word/styles.xml"）
+     * @return bool 是否存在
+     */
+    bool hasPart(const std::string& partName) const;
+
+    /**
+     * @brief 解压当前.docx容器中的指定部件
+     * @param partName 部件名
+     * @return vector<uint8_t> 部件内容，未打开容器或部件不存在时抛出 std::runtime_error
+     */
+    std::vector<uint8_t> readPart(const std::string& partName) const;
+
+    /**
+     * @brief 设置.docx正文解析模式
+     * @param mode 解析模式
+     */
+    void setParseMode(ParseMode mode) { parseMode_ = mode; }
+
+    /**
+     * @brief 获取.docx正文解析模式
+     * @return ParseMode 解析模式
+     */
+    ParseMode getParseMode() const { return parseMode_; }
+
+    /**
+     * @brief 设置并行解析使用的线程数
+     * @param threads 线程数，0 表示使用硬件并发数
+     */
+    void setParseThreads(unsigned threads) { parseThreads_ = threads; }
+
+    /**
+     * @brief 设置.docx元素文本的存储方式
+     * @param storage 存储方式
+     *
+     * 使用 TextStorage::Arena 时，段落中的文本元素指向文档内部的存储区，
+     * 只在文档对象存活期间有效。
+     */
+    void setTextStorage(TextStorage storage) { textStorage_ = storage; }
+
+    /**
+     * @brief 获取.docx元素文本的存储方式
+     * @return TextStorage 存储方式
+     */
+    TextStorage getTextStorage() const { return textStorage_; }
+
+    /**
+     * @brief 设置加载文件时元素的存储方式
+     * @param storage 存储方式
+     *
+     * 使用 ElementStorage::Arena 时，元素和文本（无论 TextStorage 如何设置）都位于
+     * 共享的存储区中，getElements() 返回的指针使存储区在文档销毁后继续有效；
+     * 设置了文本驻留池时存储区同时持有池，驻留的文本同样有效。
+     */
+    void setElementStorage(ElementStorage storage) { elementStorage_ = storage; }
+
+    /**
+     * @brief 获取元素的存储方式
+     * @return ElementStorage 存储方式
+     */
+    ElementStorage getElementStorage() const { return elementStorage_; }
+
+    /**
+     * @brief 设置文本驻留池
+     * @param pool 驻留池，为空时不驻留
+     *
+     * 设置后段落文本运行和表格单元格文本经池驻留，相同的文本只保存一份。
+     * 同一个池可以在一批文档之间共享，文档持有池的引用，元素文本在文档存活期间有效；
+     * 使用 ElementStorage::Arena 时元素的存储区也持有池，文本在元素存活期间有效。
+     */
+    void setStringPool(std::shared_ptr<StringPool> pool) { stringPool_ = std::move(pool); }
+
+    /**
+     * @brief 获取文本驻留池
+     * @return shared_ptr<StringPool> 驻留池，未设置时为空
+     */
+    const std::shared_ptr<StringPool>& getStringPool() const { return stringPool_; }
+
+    /**
+     * @brief 设置图片存储
+     * @param store 图片存储，为空时每次加载使用文档自己的存储
+     *
+     * 延迟加载的图片在读取数据时存入图片存储，相同内容的图片只保存一份。
+     * 在一批文档之间共享同一存储可以跨文档去重。
+     */
+    void setImageStore(std::shared_ptr<ImageStore> store) { imageStore_ = std::move(store); }
+
+    /**
+     * @brief 获取图片存储
+     * @return shared_ptr<ImageStore> 图片存储，未设置时为空
+     */
+    const std::shared_ptr<ImageStore>& getImageStore() const { return imageStore_; }
+
+    /**
+     * @brief 获取.docx中页眉、页脚、脚注和尾注部件的名称
+     * @return vector<string> 部件名（如 "word/header1.xml"），按名称排序
+     */
+    std::vector<std::string> getAuxiliaryParts() const;
+
+    /**
+     * @brief 获取页眉、页脚、脚注或尾注部件中的元素
+     * @param partName 部件名
+     * @return const vector<shared_ptr<DocumentElement>>& 元素列表，部件不存在或解析失败时为空
+     *
+     * 这些元素不属于正文，不出现在 getElements() 中。
+     */
+    const std::vector<std::shared_ptr<DocumentElement>>& getAuxiliaryElements(const std::string& partName) const;
+
 protected:
     std::string title_;  // 文档标题
     std::vector<std::shared_ptr<DocumentElement>> elements_;  // 文档元素列表
 
 private:
+    /**
+     * @brief 正文解析上下文
+     *
+     * 解析函数只通过上下文输出结果，不直接修改文档，因此不同分块可以在多个线程上并行解析。
+     */
+    struct ParseContext;
+
+    /**
+     * @brief 从容器中解压部件并直接送入libxml2解析
+     * @param partName 部件名
+     * @return xmlDocPtr 解析结果，调用者负责释放
+     */
+    xmlDocPtr parseXmlPart(const std::string& partName) const;
+
+    /**
+     * @brief 加载.docx文件
+     * @param filePath 文件路径
+     *
+     * ZIP容器按OPC部件读取；非ZIP内容按扁平XML处理。
+     */
+    void loadDocx(const std::string& filePath);
+
     /**
      * @brief 解析.docx文档
      * @param xmlDoc XML文档对象
+     * @param ctx 解析上下文
      */
-    void parseDocument(xmlDocPtr xmlDoc);
+    void parseDocument(xmlDocPtr xmlDoc, ParseContext& ctx) const;
+
+    /**
+     * @brief 流式解析.docx文档
+     * @param reader xmlTextReader对象
+     * @param ctx 解析上下文
+     *
+     * 每个正文块（段落、表格）在其结束标签到达时展开为子树并立即转换为文档元素，
+     * 随后由reader释放，峰值内存只取决于最大的单个块。
+     */
+    void parseDocumentStream(xmlTextReaderPtr reader, ParseContext& ctx) const;
+
+    /**
+     * @brief 并行解析.docx文档
+     * @param data document.xml内容
+     * @param size 内容长度
+     * @param ctx 解析上下文
+     *
+     * 在w:body的直接子元素边界把正文切成若干分块，每个分块补上根元素和w:body标签后
+     * 在独立线程上解析，最后按文档顺序合并。块数太少时退化为顺序解析。
+     */
+    void parseDocumentParallel(const char* data, size_t size, ParseContext& ctx) const;
+
+    /**
+     * @brief 解析正文中的单个块级节点
+     * @param node XML节点
+     * @param ctx 解析上下文
+     */
+    void parseBodyNode(xmlNodePtr node, ParseContext& ctx) const;
 
     /**
      * @brief 解析段落
      * @param node XML节点
+     * @param ctx 解析上下文
      */
-    void parseParagraph(xmlNodePtr node);
+    void parseParagraph(xmlNodePtr node, ParseContext& ctx) const;
 
     /**
      * @brief 解析表格
      * @param node XML节点
+     * @param ctx 解析上下文
      */
-    void parseTable(xmlNodePtr node);
+    void parseTable(xmlNodePtr node, ParseContext& ctx) const;
 
     /**
      * @brief 解析表格行
      * @param node XML节点
+     * @param ctx 解析上下文
      * @return TableRow 解析后的表格行
      */
-    TableRow parseTableRow(xmlNodePtr node);
+    TableRow parseTableRow(xmlNodePtr node, ParseContext& ctx) const;
 
     /**
      * @brief 解析表格单元格
      * @param node XML节点
+     * @param ctx 解析上下文
      * @return TableCell 解析后的表格单元格
      */
-    TableCell parseTableCell(xmlNodePtr node);
+    TableCell parseTableCell(xmlNodePtr node, ParseContext& ctx) const;
 
     /**
      * @brief 解析图片
      * @param node XML节点
+     * @param ctx 解析上下文
      */
-    void parseImage(xmlNodePtr node);
+    void parseImage(xmlNodePtr node, ParseContext& ctx) const;
 
     /**
-     * @brief 从.docx文件中提取图片数据
-     * @param imageId 图片ID
-     * @param format 图片格式
-     * @return vector<uint8_t> 图片数据
+     * @brief 关系ID到部件名的映射
      */
-    std::vector<uint8_t> extractImageData(const std::string& imageId, const std::string& format);
+    using RelationshipMap = std::unordered_map<std::string, std::string>;
+
+    /**
+     * @brief 解析部件的关系（word/_rels/<部件文件名>.rels）
+     * @param partName 部件名（如 "word/document.xml"）
+     * @param auxiliaryParts 不为空时输出其中页眉、页脚、脚注和尾注部件的名称
+     * @return RelationshipMap 关系ID到部件名的映射，没有关系部件时为空
+     */
+    RelationshipMap loadRelationships(const std::string& partName,
+                                      std::vector<std::string>* auxiliaryParts = nullptr) const;
+
+    /**
+     * @brief 根据关系ID查找容器内的部件
+     * @param ctx 解析上下文（提供当前部件的关系）
+     * @param relationshipId 关系ID（如 "rId5"）
+     * @return string 部件名，找不到时返回空字符串
+     */
+    std::string resolvePart(const ParseContext& ctx, const std::string& relationshipId) const;
+
+    /**
+     * @brief 解析页眉、页脚、脚注或尾注部件
+     * @param partName 部件名
+     * @param ctx 解析上下文
+     */
+    void parseAuxiliaryPart(const std::string& partName, ParseContext& ctx) const;
 
     /**
      * @brief 获取节点文本
      * @param node XML节点
-     * @return string 节点文本
+     * @param ctx 解析上下文
+     * @return string 节点下所有w:t的文本（w:tab转换为制表符）
      */
-    std::string getNodeText(xmlNodePtr node);
+    std::string getNodeText(xmlNodePtr node, ParseContext& ctx) const;
 
     /**
      * @brief 解析.doc文档
@@ -137,12 +368,34 @@ private:
     void parseDocDocument(const std::string& filePath);
 
     /**
-     * @brief 从antiword输出中提取文本内容
-     * @param output antiword的输出内容
+     * @brief 使用antiword工具解析.doc文档
+     * @param filePath 文件路径
+     *
+     * 边读取antiword的输出边生成段落元素。
+     */
+    void parseDocWithAntiword(const std::string& filePath);
+
+    /**
+     * @brief 按元素存储方式创建只含一个文本的段落（用于.doc文件）
+     * @param text 段落文本
+     * @return shared_ptr<ParagraphElement> 段落元素
      */
-    void extractTextFromAntiwordOutput(const std::string& output);
+    std::shared_ptr<ParagraphElement> makeParagraph(std::string_view text);
 
     std::string docxPath_;  // 当前打开的.docx文件路径
+    std::shared_ptr<ZipArchive> archive_;  // 当前打开的.docx容器
+    RelationshipMap relationships_;  // word/document.xml的关系ID到部件名的映射
+    std::map<std::string, std::vector<std::shared_ptr<DocumentElement>>> auxiliaryElements_;  // 页眉、页脚、脚注和尾注的元素
+    ParseMode parseMode_ = ParseMode::Dom;  // .docx正文解析模式
+    unsigned parseThreads_ = 0;  // 并行解析线程数（0 = 硬件并发数）
+    TextStorage textStorage_ = TextStorage::Owned;  // .docx元素文本的存储方式
+    std::vector<std::unique_ptr<TextArena>> textArenas_;  // 元素文本存储区（并行解析时每个分块一个）
+    ElementStorage elementStorage_ = ElementStorage::Shared;  // 元素的存储方式
+    std::vector<std::shared_ptr<ElementArena>> elementArenas_;  // 元素存储区（并行解析时每个分块一个）
+    std::shared_ptr<StringPool> stringPool_;  // 文本驻留池（可在多个文档之间共享）
+    std::shared_ptr<ImageStore> imageStore_;  // 图片存储（可在多个文档之间共享）
+    ElementQueue* queue_ = nullptr;  // streamFromFile()期间接收正文元素的队列
+    MemoryBudget* budget_ = nullptr;  // loadFromFile()期间的内存预算
 };
 
 } // namespace doc_converter 
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+ * @file zip_archive.hpp
+ * @brief OPC/ZIP 容器读取器
+ *
+ * .docx 文件本质上是一个 ZIP 包（OPC 容器），本文件提供进程内的读取实现：
+ * - 解析中央目录（支持 ZIP64）
+ * - 按部件名查找条目
+ * - 使用 zlib 按需解压单个条目，可直接流式送入解析器
+ */
+
+#pragma once
+
+#include "doc_converter/mapped_file.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <zlib.h>
+
+namespace doc_converter {
+
+/**
+ * @brief ZIP 条目信息（来自中央目录）
+ */
+struct ZipEntry {
+    std::string name;              ///< 部件名（不含前导 '/'）
+    uint16_t method = 0;           ///< 压缩方法（0 = 存储，8 = deflate）
+    uint32_t crc32 = 0;            ///< 未压缩数据的 CRC32
+    uint64_t compressedSize = 0;   ///< 压缩后大小
+    uint64_t uncompressedSize = 0; ///< 解压后大小
+    uint64_t localHeaderOffset = 0;///< 本地文件头偏移
+};
+
+class ZipArchive;
+
+/**
+ * @brief 单个条目的拉取式解压读取器
+ *
+ * 每次 read() 直接解压到调用者提供的缓冲区，不产生中间拷贝。
+ * 读取器引用所属 ZipArchive 的数据，使用期间归档对象必须保持有效。
+ */
+class ZipEntryReader {
+public:
+    ZipEntryReader(const ZipArchive& archive, const ZipEntry& entry);
+    ~ZipEntryReader();
+
+    ZipEntryReader(const ZipEntryReader&) = delete;
+    ZipEntryReader& operator=(const ZipEntryReader&) = delete;
+
+    /**
+     * @brief 读取解压后的数据
+     * @param buffer 输出缓冲区
+     * @param size 缓冲区大小
+     * @return size_t 实际读取的字节数，0 表示条目结束
+     *
+     * 数据损坏或 CRC 校验失败时抛出 std::runtime_error。
+     */
+    size_t read(char* buffer, size_t size);
+
+    /**
+     * @brief 获取条目解压后的总大小
+     * @return uint64_t 解压后大小
+     */
+    uint64_t size() const { return entry_.uncompressedSize; }
+
+private:
+    const ZipEntry& entry_;         ///< 条目信息
+    const uint8_t* input_;          ///< 压缩数据起始位置
+    uint64_t consumed_ = 0;         ///< 已消耗的压缩数据字节数
+    uint64_t produced_ = 0;         ///< 已产生的解压数据字节数
+    uint32_t crc_ = 0;              ///< 运行中的 CRC32
+    bool finished_ = false;         ///< 是否已读到结尾
+    bool inflating_ = false;        ///< zlib 流是否已初始化
+    z_stream stream_{};             ///< zlib 解压流
+};
+
+/**
+ * @brief ZIP 归档类
+ *
+ * 构造时解析中央目录，之后对归档的只读访问（查找、打开条目）是线程安全的，
+ * 每个 ZipEntryReader 拥有独立的解压状态。
+ */
+class ZipArchive {
+public:
+    /**
+     * @brief 从文件打开归档
+     * @param filePath 文件路径
+     *
+     * 文件无法读取或不是合法的 ZIP 时抛出 std::runtime_error。
+     */
+    explicit ZipArchive(const std::string& filePath);
+
+    /**
+     * @brief 从内存数据打开归档
+     * @param data 归档的完整字节
+     */
+    explicit ZipArchive(std::vector<uint8_t> data);
+
+    /**
+     * @brief 从已打开的文件创建归档
+     * @param file 文件内容（通常是内存映射），条目直接从中解压
+     */
+    explicit ZipArchive(MappedFile file);
+
+    ZipArchive(const ZipArchive&) = delete;
+    ZipArchive& operator=(const ZipArchive&) = delete;
+
+    /**
+     * @brief 判断数据是否以 ZIP 本地文件头开始
+     * @param data 数据起始地址
+     * @param size 数据大小
+     * @return bool 是否为 ZIP 数据
+     */
+    static bool isZipData(const void* data, size_t size);
+
+    /**
+     * @brief 查找条目
+     * @param name 部件名（允许带前导 '/'）
+     * @return const ZipEntry* 条目信息，不存在时返回 nullptr
+     */
+    const ZipEntry* findEntry(const std::string& name) const;
+
+    /**
+     * @brief 判断条目是否存在
+     * @param name 部件名
+     * @return bool 是否存在
+     */
+    bool hasEntry(const std::string& name) const { return findEntry(name) != nullptr; }
+
+    /**
+     * @brief 获取所有条目
+     * @return const vector<ZipEntry>& 中央目录中的条目列表
+     */
+    const std::vector<ZipEntry>& getEntries() const { return entries_; }
+
+    /**
+     * @brief 打开条目的流式读取器
+     * @param name 部件名
+     * @return unique_ptr<ZipEntryReader> 读取器，条目不存在时抛出 std::runtime_error
+     */
+    std::unique_ptr<ZipEntryReader> openEntry(const std::string& name) const;
+
+    /**
+     * @brief 解压整个条目
+     * @param name 部件名
+     * @return vector<uint8_t> 解压后的数据
+     */
+    std::vector<uint8_t> readEntry(const std::string& name) const;
+
+    /**
+     * @brief 分块解压条目并交给回调处理
+     * @param name 部件名
+     * @param sink 数据块回调
+     */
+    void readEntry(const std::string& name,
+                   const std::function<void(const char*, size_t)>& sink) const;
+
+private:
+    friend class ZipEntryReader;
+
+    /**
+     * @brief 解析中央目录
+     */
+    void parseCentralDirectory();
+
+    /**
+     * @brief 获取条目压缩数据的起始位置
+     * @param entry 条目信息
+     * @return const uint8_t* 压缩数据起始地址
+     */
+    const uint8_t* entryData(const ZipEntry& entry) const;
+
+    MappedFile data_;                                    ///< 归档字节（内存映射或自有缓冲区）
+    std::vector<ZipEntry> entries_;                      ///< 条目列表
+    std::unordered_map<std::string, size_t> index_;      ///< 部件名到条目下标的索引
+};
+
+} // namespace doc_converter
@@ -0,0 +1,161 @@
+/**
+ * @file antiword_extractor.cpp
+ * @brief 通过antiword提取.doc文本的实现
+ */
+
+#include "antiword_extractor.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdexcept>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+extern char** environ;
+
+namespace doc_converter {
+namespace detail {
+
+namespace {
+
+/**
+ * @brief 每次从管道读取的块大小
+ */
+constexpr size_t kReadBlockSize = 256 * 1024;
+
+/**
+ * @brief 回收子进程
+ * @return int waitpid得到的状态
+ */
+int waitChild(pid_t pid) {
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+    return status;
+}
+
+} // namespace
+
+AntiwordOutputSplitter::AntiwordOutputSplitter(Sink sink) : sink_(std::move(sink)) {
+}
+
+void AntiwordOutputSplitter::feed(const char* data, size_t size) {
+    const char* end = data + size;
+    while (data < end) {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', end - data));
+        if (!newline) {
+            pending_.append(data, end);
+            return;
+        }
+        if (pending_.empty()) {
+            processLine(std::string_view(data, newline - data));
+        } else {
+            pending_.append(data, newline);
+            processLine(pending_);
+            pending_.clear();
+        }
+        data = newline + 1;
+    }
+}
+
+void AntiwordOutputSplitter::finish() {
+    if (!pending_.empty()) {
+        processLine(pending_);
+        pending_.clear();
+    }
+    flushParagraph();
+}
+
+void AntiwordOutputSplitter::processLine(std::string_view line) {
+    size_t start = line.find_first_not_of(" \t");
+    // 空行（包括只有空白的行）结束当前段落
+    if (line.empty() || start == std::string_view::npos) {
+        flushParagraph();
+        return;
+    }
+
+    // 以空白开头的行开始新段落
+    if (start > 0) {
+        flushParagraph();
+        line.remove_prefix(start);
+    }
+
+    if (!paragraph_.empty()) {
+        paragraph_ += ' ';
+    }
+    paragraph_.append(line.data(), line.size());
+}
+
+void AntiwordOutputSplitter::flushParagraph() {
+    if (!paragraph_.empty()) {
+        sink_(std::move(paragraph_));
+        paragraph_.clear();
+    }
+}
+
+void runAntiword(const std::string& filePath, AntiwordOutputSplitter& splitter) {
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        throw std::runtime_error("Failed to create pipe: " + std::string(std::strerror(errno)));
+    }
+
+    // 子进程的标准输出接到管道写端，其余描述符在exec时关闭
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+
+    char program[] = "antiword";
+    char textOption[] = "-t";
+    // "--" 之后的参数不再按选项解析，以'-'开头的相对路径也作为文件名
+    char endOfOptions[] = "--";
+    std::string path = filePath;
+    char* argv[] = {program, textOption, endOfOptions, &path[0], nullptr};
+
+    pid_t pid = 0;
+    int rc = posix_spawnp(&pid, program, &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (rc != 0) {
+        close(fds[0]);
+        throw std::runtime_error("Failed to execute antiword command: " + std::string(std::strerror(rc)));
+    }
+
+    // 边读边切分，解析与子进程的输出重叠进行
+    std::vector<char> buffer(kReadBlockSize);
+    try {
+        for (;;) {
+            ssize_t n = read(fds[0], buffer.data(), buffer.size());
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Failed to read antiword output: " + std::string(std::strerror(errno)));
+            }
+            if (n == 0) {
+                break;
+            }
+            splitter.feed(buffer.data(), static_cast<size_t>(n));
+        }
+    } catch (...) {
+        close(fds[0]);
+        kill(pid, SIGTERM);
+        waitChild(pid);
+        throw;
+    }
+    close(fds[0]);
+
+    int status = waitChild(pid);
+    if (status < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw std::runtime_error("antiword command failed");
+    }
+    splitter.finish();
+}
+
+} // namespace detail
+} // namespace doc_converter
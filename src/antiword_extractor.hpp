@@ -0,0 +1,67 @@
+/**
+ * @file antiword_extractor.hpp
+ * @brief 通过antiword提取.doc文本（内部头文件）
+ *
+ * 作为进程内.doc解析的后备路径：
+ * - 使用posix_spawnp和参数数组启动antiword，不经过shell
+ * - 按大块读取管道，边读边切分段落，内存占用与输出总量无关
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace doc_converter {
+namespace detail {
+
+/**
+ * @brief antiword输出的增量段落切分器
+ *
+ * 规则与按行读取时一致：空行结束当前段落；以空白开头的行开始新段落；
+ * 其余行用空格接到当前段落后面。
+ */
+class AntiwordOutputSplitter {
+public:
+    using Sink = std::function<void(std::string&&)>;
+
+    /**
+     * @brief 构造函数
+     * @param sink 每得到一个完整段落时调用
+     */
+    explicit AntiwordOutputSplitter(Sink sink);
+
+    /**
+     * @brief 送入一块输出数据（可以在任意位置切开）
+     * @param data 数据起始地址
+     * @param size 数据大小
+     */
+    void feed(const char* data, size_t size);
+
+    /**
+     * @brief 输出结束，处理剩余的行和段落
+     */
+    void finish();
+
+private:
+    void processLine(std::string_view line);
+    void flushParagraph();
+
+    Sink sink_;              ///< 段落回调
+    std::string pending_;    ///< 尚未遇到换行符的半行
+    std::string paragraph_;  ///< 当前段落
+};
+
+/**
+ * @brief 运行antiword并把输出送入切分器
+ * @param filePath .doc文件路径
+ * @param splitter 段落切分器
+ *
+ * 无法启动进程或antiword返回非零状态时抛出 std::runtime_error。
+ */
+void runAntiword(const std::string& filePath, AntiwordOutputSplitter& splitter);
+
+} // namespace detail
+} // namespace doc_converter
@@ -0,0 +1,256 @@
+/**
+ * @file compound_file.cpp
+ * @brief OLE2复合文档读取器的实现
+ */
+
+#include "doc_converter/compound_file.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+namespace doc_converter {
+
+namespace {
+
+constexpr uint8_t kSignature[8] = {0xD0, 0xCF, 0x11, 0xE0, 0xA1, 0xB1, 0x1A, 0xE1};
+constexpr uint32_t kEndOfChain = 0xFFFFFFFE;
+constexpr uint32_t kFreeSector = 0xFFFFFFFF;
+constexpr uint32_t kNoStream = 0xFFFFFFFF;
+constexpr size_t kHeaderSize = 512;
+constexpr size_t kHeaderDifatCount = 109;
+constexpr size_t kDirectoryEntrySize = 128;
+constexpr uint8_t kTypeStream = 2;
+constexpr uint8_t kTypeRoot = 5;
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readU64(const uint8_t* p) {
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+/**
+ * @brief CFB目录名比较（ASCII范围内不区分大小写）
+ */
+bool sameName(const std::u16string& a, const std::string& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        char16_t x = a[i];
+        char16_t y = static_cast<unsigned char>(b[i]);
+        if (x < 0x80) {
+            x = static_cast<char16_t>(std::toupper(x));
+        }
+        if (y < 0x80) {
+            y = static_cast<char16_t>(std::toupper(y));
+        }
+        if (x != y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+CompoundFile::CompoundFile(const std::string& filePath) : data_(filePath, MappedFile::Access::Random) {
+    parse();
+}
+
+CompoundFile::CompoundFile(std::vector<uint8_t> data) : data_(std::move(data)) {
+    parse();
+}
+
+bool CompoundFile::isCompoundFile(const void* data, size_t size) {
+    return size >= sizeof(kSignature) && std::memcmp(data, kSignature, sizeof(kSignature)) == 0;
+}
+
+void CompoundFile::parse() {
+    if (data_.size() < kHeaderSize || !isCompoundFile(data_.data(), data_.size())) {
+        throw std::runtime_error("Not a compound file");
+    }
+    const uint8_t* header = data_.data();
+    if (readU16(header + 0x1C) != 0xFFFE) {
+        throw std::runtime_error("Unsupported compound file byte order");
+    }
+    uint16_t sectorShift = readU16(header + 0x1E);
+    uint16_t miniSectorShift = readU16(header + 0x20);
+    if ((sectorShift != 9 && sectorShift != 12) || miniSectorShift != 6) {
+        throw std::runtime_error("Unsupported compound file sector size");
+    }
+    sectorSize_ = 1u << sectorShift;
+    miniSectorSize_ = 1u << miniSectorShift;
+    miniStreamCutoff_ = readU32(header + 0x38);
+    if (miniStreamCutoff_ != 4096) {
+        throw std::runtime_error("Unsupported compound file mini stream cutoff");
+    }
+
+    const uint32_t fatSectorCount = readU32(header + 0x2C);
+    const uint32_t firstDirectorySector = readU32(header + 0x30);
+    const uint32_t firstMiniFatSector = readU32(header + 0x3C);
+    uint32_t difatSector = readU32(header + 0x44);
+    const uint32_t difatSectorCount = readU32(header + 0x48);
+
+    // 扇区总数决定了链长度和各计数的上限，用于防止循环链和按文件头中的计数过量分配
+    const size_t sectorCount = (data_.size() - kHeaderSize + sectorSize_ - 1) / sectorSize_;
+    sectorCount_ = sectorCount;
+    if (fatSectorCount > sectorCount || difatSectorCount > sectorCount) {
+        throw std::runtime_error("Corrupt compound file header: sector counts exceed file size");
+    }
+    auto sectorData = [&](uint32_t sector) -> const uint8_t* {
+        uint64_t offset = (static_cast<uint64_t>(sector) + 1) * sectorSize_;
+        if (sector >= sectorCount || offset + sectorSize_ > data_.size()) {
+            throw std::runtime_error("Compound file sector out of range");
+        }
+        return data_.data() + offset;
+    };
+
+    // DIFAT：文件头中109项，其余在DIFAT扇区链中
+    std::vector<uint32_t> fatSectors;
+    fatSectors.reserve(fatSectorCount);
+    for (size_t i = 0; i < kHeaderDifatCount && fatSectors.size() < fatSectorCount; ++i) {
+        fatSectors.push_back(readU32(header + 0x4C + i * 4));
+    }
+    // 循环的DIFAT链最多走difatSectorCount步（不超过扇区数）
+    const size_t entriesPerSector = sectorSize_ / 4;
+    for (uint32_t n = 0; n < difatSectorCount && fatSectors.size() < fatSectorCount; ++n) {
+        const uint8_t* p = sectorData(difatSector);
+        for (size_t i = 0; i + 1 < entriesPerSector && fatSectors.size() < fatSectorCount; ++i) {
+            fatSectors.push_back(readU32(p + i * 4));
+        }
+        difatSector = readU32(p + (entriesPerSector - 1) * 4);
+    }
+
+    fat_.reserve(fatSectors.size() * entriesPerSector);
+    for (uint32_t sector : fatSectors) {
+        const uint8_t* p = sectorData(sector);
+        for (size_t i = 0; i < entriesPerSector; ++i) {
+            fat_.push_back(readU32(p + i * 4));
+        }
+    }
+
+    // 目录
+    std::vector<uint8_t> directory = readChain(firstDirectorySector, UINT64_MAX);
+    directory_.reserve(directory.size() / kDirectoryEntrySize);
+    for (size_t offset = 0; offset + kDirectoryEntrySize <= directory.size(); offset += kDirectoryEntrySize) {
+        const uint8_t* p = directory.data() + offset;
+        DirectoryEntry entry;
+        uint16_t nameBytes = std::min<uint16_t>(readU16(p + 0x40), 64);
+        for (size_t i = 0; i + 1 < nameBytes; i += 2) {
+            char16_t c = static_cast<char16_t>(readU16(p + i));
+            if (c == 0) {
+                break;
+            }
+            entry.name.push_back(c);
+        }
+        entry.type = p[0x42];
+        entry.left = readU32(p + 0x44);
+        entry.right = readU32(p + 0x48);
+        entry.child = readU32(p + 0x4C);
+        entry.startSector = readU32(p + 0x74);
+        entry.size = readU64(p + 0x78);
+        // 版本3的文件只使用低32位
+        if (sectorSize_ == 512) {
+            entry.size &= 0xFFFFFFFF;
+        }
+        directory_.push_back(std::move(entry));
+    }
+    if (directory_.empty() || directory_[0].type != kTypeRoot) {
+        throw std::runtime_error("Compound file has no root entry");
+    }
+
+    // 迷你FAT和迷你流
+    if (firstMiniFatSector != kEndOfChain && firstMiniFatSector != kFreeSector) {
+        std::vector<uint8_t> miniFat = readChain(firstMiniFatSector, UINT64_MAX);
+        miniFat_.reserve(miniFat.size() / 4);
+        for (size_t i = 0; i + 4 <= miniFat.size(); i += 4) {
+            miniFat_.push_back(readU32(miniFat.data() + i));
+        }
+        miniStream_ = readChain(directory_[0].startSector, directory_[0].size);
+    }
+}
+
+std::vector<uint8_t> CompoundFile::readChain(uint32_t start, uint64_t size) const {
+    // 大小来自不可信的目录项，预留容量不超过文件本身
+    std::vector<uint8_t> out;
+    out.reserve(static_cast<size_t>(std::min<uint64_t>(size, data_.size())));
+    uint32_t sector = start;
+    size_t steps = 0;
+    while (sector != kEndOfChain && out.size() < size) {
+        uint64_t offset = (static_cast<uint64_t>(sector) + 1) * sectorSize_;
+        if (sector >= fat_.size() || offset >= data_.size() || ++steps > sectorCount_) {
+            throw std::runtime_error("Corrupt compound file sector chain");
+        }
+        size_t available = static_cast<size_t>(std::min<uint64_t>(sectorSize_, data_.size() - offset));
+        size_t take = static_cast<size_t>(std::min<uint64_t>(available, size - out.size()));
+        out.insert(out.end(), data_.data() + offset, data_.data() + offset + take);
+        sector = fat_[sector];
+    }
+    if (size != UINT64_MAX && out.size() < size) {
+        throw std::runtime_error("Truncated compound file stream");
+    }
+    return out;
+}
+
+const CompoundFile::DirectoryEntry* CompoundFile::findRootChild(const std::string& name) const {
+    // 子节点组织为红黑树，这里按普通二叉树遍历全部兄弟节点
+    std::vector<uint32_t> pending = {directory_[0].child};
+    size_t visited = 0;
+    while (!pending.empty()) {
+        uint32_t index = pending.back();
+        pending.pop_back();
+        if (index == kNoStream || index >= directory_.size() || ++visited > directory_.size()) {
+            continue;
+        }
+        const DirectoryEntry& entry = directory_[index];
+        if (sameName(entry.name, name)) {
+            return &entry;
+        }
+        pending.push_back(entry.left);
+        pending.push_back(entry.right);
+    }
+    return nullptr;
+}
+
+bool CompoundFile::hasStream(const std::string& name) const {
+    const DirectoryEntry* entry = findRootChild(name);
+    return entry && entry->type == kTypeStream;
+}
+
+std::vector<uint8_t> CompoundFile::readStream(const std::string& name) const {
+    const DirectoryEntry* entry = findRootChild(name);
+    if (!entry || entry->type != kTypeStream) {
+        throw std::runtime_error("Compound file stream not found: " + name);
+    }
+    if (entry->size >= miniStreamCutoff_) {
+        return readChain(entry->startSector, entry->size);
+    }
+
+    // 小流存放在迷你流中
+    std::vector<uint8_t> out;
+    out.reserve(static_cast<size_t>(std::min<uint64_t>(entry->size, miniStream_.size())));
+    const size_t miniSectorCount = miniStream_.size() / miniSectorSize_;
+    uint32_t sector = entry->startSector;
+    size_t steps = 0;
+    while (out.size() < entry->size) {
+        uint64_t offset = static_cast<uint64_t>(sector) * miniSectorSize_;
+        if (sector >= miniFat_.size() || offset >= miniStream_.size() || ++steps > miniSectorCount) {
+            throw std::runtime_error("Corrupt compound file mini stream chain: " + name);
+        }
+        size_t take = static_cast<size_t>(std::min<uint64_t>(
+            {static_cast<uint64_t>(miniSectorSize_), miniStream_.size() - offset, entry->size - out.size()}));
+        out.insert(out.end(), miniStream_.begin() + offset, miniStream_.begin() + offset + take);
+        sector = miniFat_[sector];
+    }
+    return out;
+}
+
+} // namespace doc_converter
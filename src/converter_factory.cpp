@@ -1,43 +1,170 @@
 /**
  * @file converter_factory.cpp
  * @brief 转换器工厂类的实现
- * 
+ *
  * 实现了ConverterFactory类的功能，包括：
  * - 注册转换器创建函数
  * - 创建转换器实例
- * 使用静态map存储转换器创建函数。
+ * - 按注册时指定的方式复用转换器实例
+ * 使用静态map存储转换器创建函数，内置的转换器（"HTML"、"Markdown"）预先注册。
+ *
+ * map 发布后不再修改（RCU方式）：查找时原子地读取当前快照的指针后直接查找；
+ * 注册时在写锁内复制当前快照、修改后原子地替换。旧快照可能仍被其他线程读取，
+ * 保留到进程退出，注册只在启动和配置变化时发生，占用的内存可以忽略。
  */
 
 #include "doc_converter/document.hpp"
+#include "doc_converter/html_converter.hpp"
+#include "doc_converter/markdown_converter.hpp"
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 
 namespace doc_converter {
 
 namespace {
     /**
-     * @brief 存储转换器创建函数的全局映射表
-     * 
+     * @brief 一次注册（发布后不再修改，getConverter() 共用的实例除外）
+     */
+    struct Registration {
+        std::function<std::shared_ptr<Converter>()> creator;  ///< 创建函数
+        ConverterReuse reuse;                                  ///< 实例的复用方式
+        uint64_t id;                                           ///< 注册编号，用于使线程缓存失效
+        mutable std::once_flag sharedOnce;                     ///< 共用实例的创建
+        mutable std::shared_ptr<Converter> shared;             ///< ConverterReuse::Shared 时共用的实例
+    };
+
+    /**
+     * @brief 注册表快照
+     *
      * 键：转换器名称
-     * 值：创建转换器的函数对象
+     * 值：注册（未改变的注册在新旧快照之间共用）
+     */
+    using CreatorMap = std::unordered_map<std::string, std::shared_ptr<const Registration>>;
+
+    /**
+     * @brief 注册表
+     */
+    class Registry {
+    public:
+        /**
+         * @brief 构造函数，注册内置转换器
+         */
+        Registry() {
+            CreatorMap builtins;
+            builtins.emplace("HTML", makeRegistration(
+                [] { return std::make_shared<HtmlConverter>(); }, ConverterReuse::Shared));
+            builtins.emplace("Markdown", makeRegistration(
+                [] { return std::make_shared<MarkdownConverter>(); }, ConverterReuse::Shared));
+            publish(std::move(builtins));
+        }
+
+        /**
+         * @brief 查找注册（不加锁）
+         * @param name 转换器名称
+         * @return const Registration* 注册，未注册时为 nullptr；快照保留到进程退出，指针一直有效
+         */
+        const Registration* find(const std::string& name) const {
+            const CreatorMap* creators = current_.load(std::memory_order_acquire);
+            auto it = creators->find(name);
+            return it == creators->end() ? nullptr : it->second.get();
+        }
+
+        /**
+         * @brief 注册或替换转换器
+         */
+        void add(const std::string& name, std::function<std::shared_ptr<Converter>()> creator,
+                 ConverterReuse reuse) {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            CreatorMap creators = *current_.load(std::memory_order_relaxed);
+            creators[name] = makeRegistration(std::move(creator), reuse);
+            publish(std::move(creators));
+        }
+
+    private:
+        std::shared_ptr<const Registration> makeRegistration(std::function<std::shared_ptr<Converter>()> creator,
+                                                             ConverterReuse reuse) {
+            auto registration = std::make_shared<Registration>();
+            registration->creator = std::move(creator);
+            registration->reuse = reuse;
+            registration->id = ++lastId_;
+            return registration;
+        }
+
+        /**
+         * @brief 发布新快照（调用方持有写锁，或在构造函数中）
+         */
+        void publish(CreatorMap creators) {
+            snapshots_.push_back(std::make_unique<const CreatorMap>(std::move(creators)));
+            current_.store(snapshots_.back().get(), std::memory_order_release);
+        }
+
+        std::atomic<const CreatorMap*> current_{nullptr};          ///< 当前快照
+        std::mutex writeMutex_;                                    ///< 注册之间互斥
+        std::vector<std::unique_ptr<const CreatorMap>> snapshots_;  ///< 发布过的全部快照
+        uint64_t lastId_ = 0;                                      ///< 最后一次注册的编号
+    };
+
+    /**
+     * @brief 获取注册表（第一次使用时创建，不依赖静态初始化的顺序）
+     */
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    /**
+     * @brief 线程复用的实例
      */
-    std::unordered_map<std::string, std::function<std::shared_ptr<Converter>()>> g_converterCreators;
+    struct CachedConverter {
+        uint64_t id = 0;                      ///< 创建实例时的注册编号
+        std::shared_ptr<Converter> converter;  ///< 实例
+    };
 }
 
 void ConverterFactory::registerConverter(
     const std::string& name,
-    std::function<std::shared_ptr<Converter>()> creator) {
-    // 将创建函数存储到映射表中
-    g_converterCreators[name] = std::move(creator);
+    std::function<std::shared_ptr<Converter>()> creator,
+    ConverterReuse reuse) {
+    // 将创建函数存储到新的快照中
+    registry().add(name, std::move(creator), reuse);
 }
 
 std::shared_ptr<Converter> ConverterFactory::createConverter(const std::string& name) {
     // 查找转换器创建函数
-    auto it = g_converterCreators.find(name);
-    if (it == g_converterCreators.end()) {
+    const Registration* registration = registry().find(name);
+    if (!registration) {
         // 如果找不到对应的转换器，返回nullptr
         return nullptr;
     }
     // 调用创建函数生成转换器实例
-    return it->second();
+    return registration->creator();
+}
+
+std::shared_ptr<Converter> ConverterFactory::getConverter(const std::string& name) {
+    const Registration* registration = registry().find(name);
+    if (!registration) {
+        return nullptr;
+    }
+    switch (registration->reuse) {
+        case ConverterReuse::Shared:
+            std::call_once(registration->sharedOnce, [registration] {
+                registration->shared = registration->creator();
+            });
+            return registration->shared;
+        case ConverterReuse::PerThread: {
+            // 名称重新注册后编号改变，下次使用时按新的注册创建
+            thread_local std::unordered_map<std::string, CachedConverter> cache;
+            CachedConverter& cached = cache[name];
+            if (!cached.converter || cached.id != registration->id) {
+                cached.converter = registration->creator();
+                cached.id = registration->id;
+            }
+            return cached.converter;
+        }
+        case ConverterReuse::None:
+        default:
+            return registration->creator();
+    }
+}
 }
-} 
\ No newline at end of file
@@ -1,7 +1,74 @@
+/**
+ * @file document.cpp
+ * @brief 文档和转换器接口中的默认实现（流式加载、内存统计、输出层）
+ */
+
 #include "doc_converter/document.hpp"
+#include "doc_converter/element_cursor.hpp"
+#include "doc_converter/logger.hpp"
+#include "doc_converter/memory_usage.hpp"
+#include "doc_converter/output_sink.hpp"
 
 namespace doc_converter {
 
-// Document 类现在是纯虚类，不需要实现任何方法
+void DocumentElement::addMemoryUsage(MemoryUsage& usage) const {
+    ++usage.elementCount;
+    usage.elementBytes += sizeof(DocumentElement);
+}
+
+MemoryUsage Document::getMemoryUsage() const {
+    MemoryUsage usage;
+    const auto& elements = getElements();
+    for (const auto& element : elements) {
+        if (element) {
+            element->addMemoryUsage(usage);
+        }
+    }
+    usage.containerBytes += MemoryUsage::heapBytes(elements);
+    return usage;
+}
+
+bool Document::streamFromFile(const std::string& filePath, ElementQueue& queue) {
+    if (!loadFromFile(filePath)) {
+        return false;
+    }
+    for (const auto& element : getElements()) {
+        queue.push(element);
+    }
+    return true;
+}
+
+bool Converter::convert(const Document& doc, const std::string& outputPath) {
+    try {
+        FileSink sink(outputPath);
+        if (!convert(doc, sink)) {
+            return false;
+        }
+        sink.close();
+        return true;
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to convert document: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool Converter::convert(const Document& /*doc*/, OutputSink& /*sink*/) {
+    Logger::getInstance().error("Converter " + getName() + " does not support output sinks");
+    return false;
+}
+
+bool Converter::convert(ElementCursor& cursor, const std::string& outputPath) {
+    if (!cursor.finish()) {
+        return false;
+    }
+    return convert(*cursor.document(), outputPath);
+}
+
+bool Converter::convert(ElementCursor& cursor, OutputSink& sink) {
+    if (!cursor.finish()) {
+        return false;
+    }
+    return convert(*cursor.document(), sink);
+}
 
-} // namespace doc_converter 
\ No newline at end of file
+} // namespace doc_converter
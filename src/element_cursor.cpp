@@ -0,0 +1,125 @@
+/**
+ * @file element_cursor.cpp
+ * @brief 元素游标和有界元素队列的实现
+ */
+
+#include "doc_converter/element_cursor.hpp"
+#include <algorithm>
+
+namespace doc_converter {
+
+ElementQueue::ElementQueue(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1)), slots_(capacity_) {}
+
+void ElementQueue::push(std::shared_ptr<DocumentElement> element) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this] { return count_ < capacity_ || cancelled_ || discarding_; });
+    if (cancelled_) {
+        throw StreamCancelled();
+    }
+    if (discarding_) {
+        return;
+    }
+    slots_[(head_ + count_) % capacity_] = std::move(element);
+    if (count_++ == 0) {
+        lock.unlock();
+        notEmpty_.notify_one();
+    }
+}
+
+bool ElementQueue::pop(std::shared_ptr<DocumentElement>& element) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return count_ > 0 || closed_; });
+    if (count_ == 0) {
+        return false;
+    }
+    element = std::move(slots_[head_]);
+    head_ = (head_ + 1) % capacity_;
+    if (count_-- == capacity_) {
+        lock.unlock();
+        notFull_.notify_one();
+    }
+    return true;
+}
+
+void ElementQueue::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return count_ > 0 || closed_; });
+}
+
+void ElementQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    notEmpty_.notify_all();
+}
+
+void ElementQueue::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancelled_ = true;
+    }
+    notFull_.notify_all();
+}
+
+void ElementQueue::discard() {
+    std::vector<std::shared_ptr<DocumentElement>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        discarding_ = true;
+        // 元素在锁外释放
+        dropped.reserve(count_);
+        for (size_t i = 0; i < count_; ++i) {
+            dropped.push_back(std::move(slots_[(head_ + i) % capacity_]));
+        }
+        head_ = 0;
+        count_ = 0;
+    }
+    notFull_.notify_all();
+}
+
+ElementCursor::ElementCursor(std::shared_ptr<Document> document, std::string filePath, size_t capacity)
+    : document_(std::move(document)), queue_(capacity) {
+    loader_ = std::thread([this, filePath = std::move(filePath)] {
+        bool loaded = false;
+        try {
+            loaded = document_->streamFromFile(filePath, queue_);
+        } catch (const std::exception&) {
+            loaded = false;
+        }
+        // close() 之前写入，消费者经队列的锁看到结果
+        loaded_ = loaded;
+        queue_.close();
+    });
+}
+
+ElementCursor::~ElementCursor() {
+    if (loader_.joinable()) {
+        queue_.cancel();
+        loader_.join();
+    }
+}
+
+std::shared_ptr<DocumentElement> ElementCursor::next() {
+    std::shared_ptr<DocumentElement> element;
+    if (!queue_.pop(element)) {
+        return nullptr;
+    }
+    return element;
+}
+
+std::string ElementCursor::getTitle() {
+    queue_.wait();
+    return document_->getTitle();
+}
+
+bool ElementCursor::finish() {
+    if (loader_.joinable()) {
+        queue_.discard();
+        loader_.join();
+    }
+    return loaded_;
+}
+
+} // namespace doc_converter
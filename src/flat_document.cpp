@@ -0,0 +1,196 @@
+/**
+ * @file flat_document.cpp
+ * @brief 列式文档的实现
+ */
+
+#include "doc_converter/flat_document.hpp"
+#include <limits>
+#include <stdexcept>
+
+namespace doc_converter {
+
+struct FlatDocument::Columns {
+    std::vector<uint8_t> types;
+    std::vector<uint32_t> slots;
+    std::string text;
+    std::vector<TextSpan> spans;
+    std::vector<Paragraph> paragraphs;
+    std::vector<Heading> headings;
+    std::vector<Table> tables;
+    std::vector<RowRange::Row> rows;
+    std::vector<ImageInfo> images;
+
+    /**
+     * @brief 把文本追加到缓冲区
+     */
+    TextSpan append(std::string_view value) {
+        if (value.size() > std::numeric_limits<uint32_t>::max() - text.size()) {
+            throw std::length_error("FlatDocument text exceeds 4 GiB");
+        }
+        TextSpan span;
+        span.offset = static_cast<uint32_t>(text.size());
+        span.length = static_cast<uint32_t>(value.size());
+        text.append(value.data(), value.size());
+        return span;
+    }
+};
+
+FlatDocument::FlatDocument(const Document& doc) : title_(doc.getTitle()) {
+    auto columns = std::make_shared<Columns>();
+    const auto& elements = doc.getElements();
+    columns->types.reserve(elements.size());
+    columns->slots.reserve(elements.size());
+
+    for (const auto& element : elements) {
+        if (!element) {
+            continue;
+        }
+        const DocumentElement* base = element.get();
+        uint32_t slot = 0;
+        switch (base->getType()) {
+            case ElementType::Text: {
+                auto text = dynamic_cast<const TextElement*>(base);
+                if (!text) {
+                    continue;
+                }
+                slot = static_cast<uint32_t>(columns->spans.size());
+                columns->spans.push_back(columns->append(text->getText()));
+                break;
+            }
+            case ElementType::Paragraph: {
+                auto para = dynamic_cast<const ParagraphElement*>(base);
+                if (!para) {
+                    continue;
+                }
+                Paragraph entry;
+                entry.firstRun = static_cast<uint32_t>(columns->spans.size());
+                entry.runCount = static_cast<uint32_t>(para->getTexts().size());
+                for (const auto& text : para->getTexts()) {
+                    columns->spans.push_back(columns->append(text));
+                }
+                entry.listLevel = para->getListLevel();
+                entry.listFormat = columns->append(para->getListFormat());
+                slot = static_cast<uint32_t>(columns->paragraphs.size());
+                columns->paragraphs.push_back(entry);
+                break;
+            }
+            case ElementType::Heading: {
+                auto heading = dynamic_cast<const HeadingElement*>(base);
+                if (!heading) {
+                    continue;
+                }
+                slot = static_cast<uint32_t>(columns->headings.size());
+                columns->headings.push_back({columns->append(heading->getText()), heading->getLevel()});
+                break;
+            }
+            case ElementType::Table: {
+                auto table = dynamic_cast<const TableElement*>(base);
+                if (!table) {
+                    continue;
+                }
+                Table entry;
+                entry.firstRow = static_cast<uint32_t>(columns->rows.size());
+                entry.rowCount = static_cast<uint32_t>(table->getRows().size());
+                for (const auto& row : table->getRows()) {
+                    RowRange::Row rowEntry;
+                    rowEntry.firstCell = static_cast<uint32_t>(columns->spans.size());
+                    rowEntry.cellCount = static_cast<uint32_t>(row.getCells().size());
+                    for (const auto& cell : row.getCells()) {
+                        columns->spans.push_back(columns->append(cell.getText()));
+                    }
+                    columns->rows.push_back(rowEntry);
+                }
+                slot = static_cast<uint32_t>(columns->tables.size());
+                columns->tables.push_back(entry);
+                break;
+            }
+            case ElementType::Image: {
+                auto image = std::dynamic_pointer_cast<const ImageElement>(element);
+                if (!image) {
+                    continue;
+                }
+                ImageInfo info;
+                info.width = image->getWidth();
+                info.height = image->getHeight();
+                info.format = columns->append(image->getFormat());
+                info.dataSize = image->getDataSize();
+                slot = static_cast<uint32_t>(columns->images.size());
+                columns->images.push_back(info);
+                imageElements_.push_back(std::move(image));
+                break;
+            }
+            default:
+                // 尚未实现的元素类型只保留类型标签
+                break;
+        }
+        columns->types.push_back(static_cast<uint8_t>(base->getType()));
+        columns->slots.push_back(slot);
+    }
+
+    bind(*columns);
+    storage_ = std::move(columns);
+}
+
+void FlatDocument::bind(const Columns& columns) {
+    types_ = {columns.types.data(), columns.types.size()};
+    slots_ = {columns.slots.data(), columns.slots.size()};
+    text_ = {columns.text.data(), columns.text.size()};
+    spans_ = {columns.spans.data(), columns.spans.size()};
+    paragraphs_ = {columns.paragraphs.data(), columns.paragraphs.size()};
+    headings_ = {columns.headings.data(), columns.headings.size()};
+    tables_ = {columns.tables.data(), columns.tables.size()};
+    rows_ = {columns.rows.data(), columns.rows.size()};
+    images_ = {columns.images.data(), columns.images.size()};
+}
+
+std::string_view FlatDocument::ElementView::text() const {
+    switch (type()) {
+        case ElementType::Text:
+            return doc_->text(doc_->spans_[doc_->slots_[index_]]);
+        case ElementType::Heading:
+            return doc_->text(doc_->headings_[doc_->slots_[index_]].text);
+        default:
+            return std::string_view();
+    }
+}
+
+int FlatDocument::ElementView::headingLevel() const {
+    return type() == ElementType::Heading ? doc_->headings_[doc_->slots_[index_]].level : 0;
+}
+
+TextRange FlatDocument::ElementView::runs() const {
+    if (type() != ElementType::Paragraph) {
+        return TextRange();
+    }
+    const Paragraph& entry = doc_->paragraphs_[doc_->slots_[index_]];
+    return TextRange(doc_->text_.data, doc_->spans_.data + entry.firstRun, entry.runCount);
+}
+
+int FlatDocument::ElementView::listLevel() const {
+    return type() == ElementType::Paragraph ? doc_->paragraphs_[doc_->slots_[index_]].listLevel : -1;
+}
+
+std::string_view FlatDocument::ElementView::listFormat() const {
+    if (type() != ElementType::Paragraph) {
+        return std::string_view();
+    }
+    return doc_->text(doc_->paragraphs_[doc_->slots_[index_]].listFormat);
+}
+
+RowRange FlatDocument::ElementView::rows() const {
+    if (type() != ElementType::Table) {
+        return RowRange();
+    }
+    const Table& entry = doc_->tables_[doc_->slots_[index_]];
+    return RowRange(doc_->text_.data, doc_->spans_.data, doc_->rows_.data + entry.firstRow, entry.rowCount);
+}
+
+const FlatDocument::ImageInfo* FlatDocument::ElementView::image() const {
+    return type() == ElementType::Image ? &doc_->images_[doc_->slots_[index_]] : nullptr;
+}
+
+std::shared_ptr<const ImageElement> FlatDocument::ElementView::imageElement() const {
+    return type() == ElementType::Image ? doc_->imageElements_[doc_->slots_[index_]] : nullptr;
+}
+
+} // namespace doc_converter
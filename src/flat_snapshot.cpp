@@ -0,0 +1,337 @@
+/**
+ * @file flat_snapshot.cpp
+ * @brief 列式文档快照文件的读写
+ *
+ * 快照文件布局（本机字节序，所有数组按 8 字节对齐）：
+ * - 文件头：魔数 "DOCSNAP\0"、版本号、字节序标记、数组个数、每个数组的偏移和元素数
+ * - 标题、类型标签、副表下标、文本、文本段、段落、标题、表格、表格行、图片信息、图片数据
+ * 各数组与 FlatDocument 内存中的布局相同，加载时直接指向映射的字节。
+ */
+
+#include "doc_converter/flat_document.hpp"
+#include "doc_converter/image_store.hpp"
+#include "doc_converter/logger.hpp"
+#include "doc_converter/mapped_file.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+namespace doc_converter {
+
+namespace {
+
+constexpr char kSnapshotMagic[8] = {'D', 'O', 'C', 'S', 'N', 'A', 'P', '\0'};
+
+/**
+ * @brief 快照格式版本，数组布局变化时递增
+ */
+constexpr uint32_t kSnapshotVersion = 1;
+
+/**
+ * @brief 字节序标记，读入的值不同说明文件由字节序不同的机器写出
+ */
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+/**
+ * @brief 快照中的数组
+ */
+enum SnapshotSection : uint32_t {
+    kTitleSection,
+    kTypesSection,
+    kSlotsSection,
+    kTextSection,
+    kSpansSection,
+    kParagraphsSection,
+    kHeadingsSection,
+    kTablesSection,
+    kRowsSection,
+    kImagesSection,
+    kImageDataSection,
+    kSectionCount
+};
+
+struct SectionEntry {
+    uint64_t offset;  ///< 数组在文件中的偏移
+    uint64_t count;   ///< 元素数
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t sectionCount;
+    uint32_t reserved;
+    SectionEntry sections[kSectionCount];
+};
+
+constexpr uint64_t kSectionAlignment = 8;
+
+uint64_t alignUp(uint64_t value) {
+    return (value + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+/**
+ * @brief 从映射的快照文件中读取图片数据
+ */
+class SnapshotImageSource : public ImageSource {
+public:
+    SnapshotImageSource(std::shared_ptr<const MappedFile> file, const uint8_t* data, size_t size)
+        : file_(std::move(file)), data_(data), size_(size) {}
+
+    std::vector<uint8_t> load() const override { return std::vector<uint8_t>(data_, data_ + size_); }
+
+    size_t size() const override { return size_; }
+
+private:
+    std::shared_ptr<const MappedFile> file_;  ///< 保持映射有效
+    const uint8_t* data_;
+    size_t size_;
+};
+
+} // namespace
+
+bool FlatDocument::saveSnapshot(const std::string& filePath) const {
+    static_assert(std::is_trivially_copyable_v<TextSpan> && sizeof(TextSpan) == 8, "TextSpan layout");
+    static_assert(std::is_trivially_copyable_v<Paragraph> && sizeof(Paragraph) == 20, "Paragraph layout");
+    static_assert(std::is_trivially_copyable_v<Heading> && sizeof(Heading) == 12, "Heading layout");
+    static_assert(std::is_trivially_copyable_v<Table> && sizeof(Table) == 8, "Table layout");
+    static_assert(std::is_trivially_copyable_v<RowRange::Row> && sizeof(RowRange::Row) == 8, "Row layout");
+    static_assert(std::is_trivially_copyable_v<ImageInfo> && sizeof(ImageInfo) == 32, "ImageInfo layout");
+
+    std::string tempPath = filePath + ".tmp";
+    try {
+        // 图片数据按内容去重后连续存放
+        std::vector<ImageInfo> images(images_.data, images_.data + images_.size);
+        std::vector<uint8_t> imageData;
+        std::unordered_multimap<ImageHash, size_t> stored;
+        for (size_t i = 0; i < images.size(); ++i) {
+            static const std::vector<uint8_t> kEmpty;
+            const std::vector<uint8_t>& bytes = imageElements_[i] ? imageElements_[i]->getImageData() : kEmpty;
+            ImageHash hash = ImageStore::hash(bytes.data(), bytes.size());
+            images[i].dataSize = bytes.size();
+            images[i].dataOffset = imageData.size();
+            auto range = stored.equal_range(hash);
+            bool found = false;
+            for (auto it = range.first; it != range.second && !found; ++it) {
+                const ImageInfo& previous = images[it->second];
+                if (previous.dataSize == bytes.size() &&
+                    (bytes.empty() ||
+                     std::memcmp(imageData.data() + previous.dataOffset, bytes.data(), bytes.size()) == 0)) {
+                    images[i].dataOffset = previous.dataOffset;
+                    found = true;
+                }
+            }
+            if (!found) {
+                imageData.insert(imageData.end(), bytes.begin(), bytes.end());
+                stored.emplace(hash, i);
+            }
+        }
+
+        struct Block {
+            const void* data;
+            uint64_t bytes;
+        };
+        Block blocks[kSectionCount];
+        SnapshotHeader header{};
+        std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+        header.version = kSnapshotVersion;
+        header.byteOrder = kByteOrderMark;
+        header.sectionCount = kSectionCount;
+        auto section = [&](SnapshotSection id, const void* data, size_t count, size_t elementSize) {
+            header.sections[id].count = count;
+            blocks[id] = {data, static_cast<uint64_t>(count) * elementSize};
+        };
+        section(kTitleSection, title_.data(), title_.size(), 1);
+        section(kTypesSection, types_.data, types_.size, sizeof(uint8_t));
+        section(kSlotsSection, slots_.data, slots_.size, sizeof(uint32_t));
+        section(kTextSection, text_.data, text_.size, 1);
+        section(kSpansSection, spans_.data, spans_.size, sizeof(TextSpan));
+        section(kParagraphsSection, paragraphs_.data, paragraphs_.size, sizeof(Paragraph));
+        section(kHeadingsSection, headings_.data, headings_.size, sizeof(Heading));
+        section(kTablesSection, tables_.data, tables_.size, sizeof(Table));
+        section(kRowsSection, rows_.data, rows_.size, sizeof(RowRange::Row));
+        section(kImagesSection, images.data(), images.size(), sizeof(ImageInfo));
+        section(kImageDataSection, imageData.data(), imageData.size(), 1);
+
+        uint64_t offset = alignUp(sizeof(SnapshotHeader));
+        for (uint32_t id = 0; id < kSectionCount; ++id) {
+            header.sections[id].offset = offset;
+            offset = alignUp(offset + blocks[id].bytes);
+        }
+
+        // 先写临时文件再改名，中途失败不会留下不完整的快照
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open " + tempPath);
+        }
+        static const char kPadding[kSectionAlignment] = {};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t written = sizeof(header);
+        for (uint32_t id = 0; id < kSectionCount; ++id) {
+            file.write(kPadding, static_cast<std::streamsize>(header.sections[id].offset - written));
+            if (blocks[id].bytes > 0) {
+                file.write(static_cast<const char*>(blocks[id].data), static_cast<std::streamsize>(blocks[id].bytes));
+            }
+            written = header.sections[id].offset + blocks[id].bytes;
+        }
+        file.close();
+        if (!file) {
+            throw std::runtime_error("Write failed: " + tempPath);
+        }
+        if (std::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+            throw std::runtime_error("Cannot rename " + tempPath + " to " + filePath);
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::remove(tempPath.c_str());
+        Logger::getInstance().error("Failed to save snapshot: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool FlatDocument::loadFromSnapshot(const std::string& filePath) {
+    try {
+        // 多个转换器会反复遍历同一映射，不希望读过的页被提前回收
+        auto file = std::make_shared<const MappedFile>(filePath, MappedFile::Access::Random);
+        const uint8_t* base = file->data();
+        const uint64_t fileSize = file->size();
+
+        SnapshotHeader header;
+        if (fileSize < sizeof(header)) {
+            throw std::runtime_error("File too small for a snapshot header: " + filePath);
+        }
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+            throw std::runtime_error("Not a document snapshot: " + filePath);
+        }
+        if (header.byteOrder != kByteOrderMark) {
+            throw std::runtime_error("Snapshot written with a different byte order: " + filePath);
+        }
+        if (header.version != kSnapshotVersion || header.sectionCount != kSectionCount) {
+            throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version) + ": " +
+                                     filePath);
+        }
+
+        auto column = [&](SnapshotSection id, size_t elementSize, size_t alignment) {
+            const SectionEntry& entry = header.sections[id];
+            if (entry.offset % alignment != 0 || entry.offset > fileSize ||
+                entry.count > (fileSize - entry.offset) / elementSize) {
+                throw std::runtime_error("Snapshot section " + std::to_string(id) + " out of range");
+            }
+            return std::make_pair(base + entry.offset, static_cast<size_t>(entry.count));
+        };
+        auto bindColumn = [&](auto& target, SnapshotSection id) {
+            using T = std::remove_const_t<std::remove_pointer_t<decltype(target.data)>>;
+            auto range = column(id, sizeof(T), alignof(T));
+            target.data = reinterpret_cast<const T*>(range.first);
+            target.size = range.second;
+        };
+
+        FlatDocument loaded;
+        auto title = column(kTitleSection, 1, 1);
+        loaded.title_.assign(reinterpret_cast<const char*>(title.first), title.second);
+        bindColumn(loaded.types_, kTypesSection);
+        bindColumn(loaded.slots_, kSlotsSection);
+        bindColumn(loaded.text_, kTextSection);
+        bindColumn(loaded.spans_, kSpansSection);
+        bindColumn(loaded.paragraphs_, kParagraphsSection);
+        bindColumn(loaded.headings_, kHeadingsSection);
+        bindColumn(loaded.tables_, kTablesSection);
+        bindColumn(loaded.rows_, kRowsSection);
+        bindColumn(loaded.images_, kImagesSection);
+        auto imageData = column(kImageDataSection, 1, 1);
+        loaded.validate();
+
+        loaded.imageElements_.reserve(loaded.images_.size);
+        for (size_t i = 0; i < loaded.images_.size; ++i) {
+            const ImageInfo& info = loaded.images_[i];
+            if (info.dataOffset > imageData.second || info.dataSize > imageData.second - info.dataOffset) {
+                throw std::runtime_error("Snapshot image " + std::to_string(i) + " out of range");
+            }
+            // 格式会用作输出图片的文件扩展名，快照被篡改时不能带入路径字符
+            std::string format(loaded.text(info.format));
+            if (!format.empty() && !ImageStore::isSafeFormat(format)) {
+                throw std::runtime_error("Snapshot image " + std::to_string(i) + " has invalid format");
+            }
+            auto source = std::make_shared<SnapshotImageSource>(file, imageData.first + info.dataOffset,
+                                                                static_cast<size_t>(info.dataSize));
+            loaded.imageElements_.push_back(
+                std::make_shared<ImageElement>(std::move(source), std::move(format), info.width, info.height));
+        }
+
+        loaded.storage_ = std::move(file);
+        *this = std::move(loaded);
+        return true;
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to load snapshot: " + std::string(e.what()));
+        return false;
+    }
+}
+
+void FlatDocument::validate() const {
+    auto checkSpan = [this](const TextSpan& span) {
+        if (span.offset > text_.size || span.length > text_.size - span.offset) {
+            throw std::runtime_error("Snapshot text span out of range");
+        }
+    };
+    auto checkRange = [](uint64_t first, uint64_t count, size_t size, const char* what) {
+        if (first > size || count > size - first) {
+            throw std::runtime_error(std::string("Snapshot ") + what + " out of range");
+        }
+    };
+
+    if (types_.size != slots_.size) {
+        throw std::runtime_error("Snapshot type and slot arrays differ in length");
+    }
+    for (size_t i = 0; i < types_.size; ++i) {
+        uint32_t slot = slots_[i];
+        switch (static_cast<ElementType>(types_[i])) {
+            case ElementType::Text:
+                checkRange(slot, 1, spans_.size, "text element");
+                break;
+            case ElementType::Paragraph:
+                checkRange(slot, 1, paragraphs_.size, "paragraph");
+                break;
+            case ElementType::Heading:
+                checkRange(slot, 1, headings_.size, "heading");
+                break;
+            case ElementType::Table:
+                checkRange(slot, 1, tables_.size, "table");
+                break;
+            case ElementType::Image:
+                checkRange(slot, 1, images_.size, "image");
+                break;
+            case ElementType::List:
+                break;
+            default:
+                throw std::runtime_error("Unknown element type in snapshot");
+        }
+    }
+    for (size_t i = 0; i < spans_.size; ++i) {
+        checkSpan(spans_[i]);
+    }
+    for (size_t i = 0; i < paragraphs_.size; ++i) {
+        checkRange(paragraphs_[i].firstRun, paragraphs_[i].runCount, spans_.size, "paragraph runs");
+        checkSpan(paragraphs_[i].listFormat);
+    }
+    for (size_t i = 0; i < headings_.size; ++i) {
+        checkSpan(headings_[i].text);
+        if (headings_[i].level < 1 || headings_[i].level > 6) {
+            throw std::runtime_error("Snapshot heading level out of range");
+        }
+    }
+    for (size_t i = 0; i < tables_.size; ++i) {
+        checkRange(tables_[i].firstRow, tables_[i].rowCount, rows_.size, "table rows");
+    }
+    for (size_t i = 0; i < rows_.size; ++i) {
+        checkRange(rows_[i].firstCell, rows_[i].cellCount, spans_.size, "table cells");
+    }
+    for (size_t i = 0; i < images_.size; ++i) {
+        checkSpan(images_[i].format);
+    }
+}
+
+} // namespace doc_converter
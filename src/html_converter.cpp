@@ -0,0 +1,215 @@
+/**
+ * @file html_converter.cpp
+ * @brief HTML转换器的实现
+ */
+
+#include "doc_converter/html_converter.hpp"
+#include "doc_converter/document_elements.hpp"
+#include "doc_converter/logger.hpp"
+#include "image_output.hpp"
+#include "text_escape.hpp"
+#include <algorithm>
+
+namespace doc_converter {
+
+/**
+ * @brief 把元素写成HTML的访问者
+ */
+class HtmlConverter::Writer : public ElementVisitor {
+public:
+    /**
+     * @brief 构造函数
+     * @param out 输出层
+     * @param images 图片的输出位置
+     */
+    Writer(OutputSink& out, detail::ImageOutput& images) : out_(out), images_(images) {}
+
+    using ElementVisitor::visit;
+
+    void begin(const std::string& title) {
+        out_ << "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>";
+        detail::escapeHtml(title, out_);
+        out_ << "</title>\n</head>\n<body>\n";
+    }
+
+    void end() {
+        closeLists(0);
+        out_ << "</body>\n</html>\n";
+    }
+
+    void visit(const HeadingElement& heading) override {
+        closeLists(0);
+        char level = static_cast<char>('0' + std::clamp(heading.getLevel(), 1, 6));
+        out_ << "<h" << level << '>';
+        detail::escapeHtml(heading.getText(), out_);
+        out_ << "</h" << level << ">\n";
+    }
+
+    void visit(const ParagraphElement& para) override {
+        if (para.isListItem()) {
+            openListItem(para.getListLevel(), para.getListFormat() != "bullet" && !para.getListFormat().empty());
+            writeRuns(para);
+            return;
+        }
+        closeLists(0);
+        out_ << "<p>";
+        writeRuns(para);
+        out_ << "</p>\n";
+    }
+
+    void visit(const TextElement& text) override {
+        closeLists(0);
+        out_ << "<p>";
+        detail::escapeHtml(text.getText(), out_);
+        out_ << "</p>\n";
+    }
+
+    void visit(const TableElement& table) override {
+        closeLists(0);
+        out_ << "<table>\n";
+        for (const TableRow& row : table.getRows()) {
+            out_ << "<tr>";
+            for (const TableCell& cell : row.getCells()) {
+                out_ << "<td>";
+                detail::escapeHtml(cell.getText(), out_);
+                out_ << "</td>";
+            }
+            out_ << "</tr>\n";
+        }
+        out_ << "</table>\n";
+    }
+
+    void visit(const ImageElement& image) override {
+        closeLists(0);
+        const std::vector<uint8_t>& data = image.getImageData();
+        if (data.empty()) {
+            return;
+        }
+        out_ << "<img src=\"";
+        if (images_.embedded()) {
+            out_ << "data:" << detail::ImageOutput::mimeType(image.getFormat()) << ";base64,";
+            detail::writeBase64(data.data(), data.size(), out_);
+        } else {
+            detail::escapeHtml(images_.writeFile(image), out_);
+        }
+        out_ << '"';
+        if (image.getWidth() > 0) {
+            out_ << " width=\"" << std::to_string(image.getWidth()) << '"';
+        }
+        if (image.getHeight() > 0) {
+            out_ << " height=\"" << std::to_string(image.getHeight()) << '"';
+        }
+        out_ << " alt=\"\">\n";
+    }
+
+private:
+    /**
+     * @brief 列表中仍未结束的一级
+     */
+    struct OpenList {
+        int level;     ///< 列表级别
+        bool ordered;  ///< 是否为编号列表
+    };
+
+    void writeRuns(const ParagraphElement& para) {
+        for (std::string_view text : para.getTexts()) {
+            detail::escapeHtml(text, out_);
+        }
+    }
+
+    /**
+     * @brief 开始一个列表项，更深的列表嵌套在上一级仍未结束的 <li> 中
+     */
+    void openListItem(int level, bool ordered) {
+        closeLists(level + 1);
+        if (!lists_.empty() && lists_.back().level == level) {
+            if (lists_.back().ordered == ordered) {
+                out_ << "</li>\n<li>";
+                return;
+            }
+            closeLists(level);
+        }
+        out_ << (lists_.empty() ? "" : "\n") << (ordered ? "<ol>\n<li>" : "<ul>\n<li>");
+        lists_.push_back({level, ordered});
+    }
+
+    /**
+     * @brief 结束级别不低于 level 的列表
+     */
+    void closeLists(int level) {
+        while (!lists_.empty() && lists_.back().level >= level) {
+            out_ << (lists_.back().ordered ? "</li>\n</ol>\n" : "</li>\n</ul>\n");
+            lists_.pop_back();
+        }
+    }
+
+    OutputSink& out_;
+    detail::ImageOutput& images_;
+    std::vector<OpenList> lists_;
+};
+
+HtmlConverter::HtmlConverter(std::shared_ptr<ImageStore> imageStore)
+    : imageStore_(imageStore ? std::move(imageStore) : std::make_shared<ImageStore>()) {}
+
+bool HtmlConverter::convert(const Document& doc, const std::string& outputPath) {
+    try {
+        FileSink sink(outputPath);
+        write(doc.getTitle(), outputPath, sink, nullptr, &doc);
+        sink.close();
+        return true;
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to convert document to HTML: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool HtmlConverter::convert(const Document& doc, OutputSink& sink) {
+    try {
+        write(doc.getTitle(), std::string(), sink, nullptr, &doc);
+        return true;
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to convert document to HTML: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool HtmlConverter::convert(ElementCursor& cursor, const std::string& outputPath) {
+    try {
+        FileSink sink(outputPath);
+        write(cursor.getTitle(), outputPath, sink, &cursor, nullptr);
+        sink.close();
+        return cursor.finish();
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to convert document to HTML: " + std::string(e.what()));
+        cursor.finish();
+        return false;
+    }
+}
+
+bool HtmlConverter::convert(ElementCursor& cursor, OutputSink& sink) {
+    try {
+        write(cursor.getTitle(), std::string(), sink, &cursor, nullptr);
+        return cursor.finish();
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to convert document to HTML: " + std::string(e.what()));
+        cursor.finish();
+        return false;
+    }
+}
+
+void HtmlConverter::write(const std::string& title, const std::string& outputPath, OutputSink& sink,
+                          ElementCursor* cursor, const Document* doc) const {
+    detail::ImageOutput images(*imageStore_, imageMode_, outputPath, imageDirectory_);
+    Writer writer(sink, images);
+    writer.begin(title);
+    if (cursor) {
+        while (auto element = cursor->next()) {
+            element->accept(writer);
+        }
+    } else {
+        doc->visitElements(writer);
+    }
+    writer.end();
+}
+
+} // namespace doc_converter
@@ -0,0 +1,55 @@
+/**
+ * @file image_output.cpp
+ * @brief 转换器输出图片的位置
+ */
+
+#include "image_output.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+
+namespace doc_converter {
+namespace detail {
+
+ImageOutput::ImageOutput(ImageStore& store, ImageOutputMode mode, const std::string& outputPath,
+                         const std::string& imageDirectory)
+    : store_(store) {
+    if (mode != ImageOutputMode::Files) {
+        return;
+    }
+    if (!outputPath.empty()) {
+        std::filesystem::path path(outputPath);
+        std::string name = path.stem().string() + "_files";
+        directory_ = (path.parent_path() / name).string();
+        prefix_ = name + "/";
+    } else if (!imageDirectory.empty()) {
+        directory_ = imageDirectory;
+        prefix_ = imageDirectory.back() == '/' ? imageDirectory : imageDirectory + "/";
+    }
+}
+
+std::string ImageOutput::writeFile(const ImageElement& image) {
+    if (!directoryCreated_) {
+        std::filesystem::create_directories(directory_);
+        directoryCreated_ = true;
+    }
+    return prefix_ + store_.writeOnce(image.getStoredImage(), image.getFormat(), directory_);
+}
+
+std::string_view ImageOutput::mimeType(std::string format) {
+    std::transform(format.begin(), format.end(), format.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (format == "png") return "image/png";
+    if (format == "jpg" || format == "jpeg") return "image/jpeg";
+    if (format == "gif") return "image/gif";
+    if (format == "bmp") return "image/bmp";
+    if (format == "tif" || format == "tiff") return "image/tiff";
+    if (format == "svg") return "image/svg+xml";
+    if (format == "webp") return "image/webp";
+    if (format == "emf") return "image/emf";
+    if (format == "wmf") return "image/wmf";
+    return "application/octet-stream";
+}
+
+} // namespace detail
+} // namespace doc_converter
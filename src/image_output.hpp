@@ -0,0 +1,65 @@
+/**
+ * @file image_output.hpp
+ * @brief 转换器输出图片的位置（内部头文件）
+ *
+ * HTML和Markdown转换器共用：按 ImageOutputMode 决定图片嵌入输出，
+ * 还是写入单独的文件并在输出中引用。
+ */
+
+#pragma once
+
+#include "doc_converter/document_elements.hpp"
+#include "doc_converter/image_store.hpp"
+#include <string>
+#include <string_view>
+
+namespace doc_converter {
+namespace detail {
+
+/**
+ * @brief 一次转换中输出图片的位置
+ */
+class ImageOutput {
+public:
+    /**
+     * @brief 构造函数
+     * @param store 图片文件去重用的存储
+     * @param mode 图片的输出方式
+     * @param outputPath 输出文件路径，写入输出层时为空
+     * @param imageDirectory 写入输出层时图片文件的目录
+     *
+     * ImageOutputMode::Files 时，写入文件的图片放在输出文件旁的 "<文件名>_files" 目录，
+     * 写入输出层时放在 imageDirectory；两者都没有时嵌入。
+     */
+    ImageOutput(ImageStore& store, ImageOutputMode mode, const std::string& outputPath,
+                const std::string& imageDirectory);
+
+    /**
+     * @brief 是否以 data URI 嵌入图片
+     * @return bool 是否嵌入
+     */
+    bool embedded() const { return directory_.empty(); }
+
+    /**
+     * @brief 把图片写入图片目录（第一次写入时创建目录）
+     * @param image 图片元素
+     * @return string 输出中引用图片的路径，写入失败时抛出异常
+     */
+    std::string writeFile(const ImageElement& image);
+
+    /**
+     * @brief 获取图片格式对应的MIME类型
+     * @param format 图片格式（扩展名，不区分大小写）
+     * @return string_view MIME类型，未知格式为 application/octet-stream
+     */
+    static std::string_view mimeType(std::string format);
+
+private:
+    ImageStore& store_;
+    std::string directory_;         ///< 图片目录，嵌入时为空
+    std::string prefix_;            ///< 引用路径中文件名前的部分
+    bool directoryCreated_ = false;
+};
+
+} // namespace detail
+} // namespace doc_converter
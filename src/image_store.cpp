@@ -0,0 +1,259 @@
+/**
+ * @file image_store.cpp
+ * @brief 按内容寻址的图片存储的实现
+ */
+
+#include "doc_converter/image_store.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace doc_converter {
+
+namespace {
+
+constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief 64 位混合函数（splitmix64 的收尾步骤）
+ */
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t load64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief 判断文件内容是否与数据相同
+ */
+bool sameContent(const std::filesystem::path& path, const std::vector<uint8_t>& data) {
+    std::error_code ec;
+    if (std::filesystem::file_size(path, ec) != data.size() || ec) {
+        return false;
+    }
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> buffer(std::min<size_t>(data.size(), 64 * 1024));
+    size_t offset = 0;
+    while (offset < data.size()) {
+        size_t chunk = std::min(buffer.size(), data.size() - offset);
+        if (!file.read(buffer.data(), static_cast<std::streamsize>(chunk)) ||
+            std::memcmp(buffer.data(), data.data() + offset, chunk) != 0) {
+            return false;
+        }
+        offset += chunk;
+    }
+    return true;
+}
+
+/**
+ * @brief 写图片文件，内容已相同时跳过
+ *
+ * 先写临时文件再改名，目录中不会出现写了一半的图片。
+ */
+void writeFile(const StoredImage& image, const std::filesystem::path& path) {
+    static const std::vector<uint8_t> empty;
+    const std::vector<uint8_t>& data = image.data ? *image.data : empty;
+    if (sameContent(path, data)) {
+        return;
+    }
+    std::string tempPath = path.string() + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        file.close();
+        if (!file) {
+            std::remove(tempPath.c_str());
+            throw std::runtime_error("Failed to write image: " + path.string());
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.string().c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        throw std::runtime_error("Cannot rename " + tempPath + " to " + path.string());
+    }
+}
+
+} // namespace
+
+ImageHash ImageStore::hash(const uint8_t* data, size_t size) {
+    // 四路独立累加，每 8 字节一次乘法，互不依赖的乘法可以流水执行
+    uint64_t lanes[4] = {
+        0x243F6A8885A308D3ULL ^ size,
+        0x13198A2E03707344ULL,
+        0xA4093822299F31D0ULL,
+        0x082EFA98EC4E6C89ULL,
+    };
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            uint64_t v = lanes[lane] ^ load64(data + i + lane * 8);
+            lanes[lane] = (v * kMultiplier) ^ (v >> 29);
+        }
+    }
+    for (; i + 8 <= size; i += 8) {
+        uint64_t v = lanes[0] ^ load64(data + i);
+        lanes[0] = (v * kMultiplier) ^ (v >> 29);
+    }
+    uint64_t tail = 0;
+    if (i < size) {
+        std::memcpy(&tail, data + i, size - i);
+    }
+    uint64_t h = mix(lanes[0] ^ tail);
+    h = mix(h ^ lanes[1]);
+    h = mix(h ^ lanes[2]);
+    return mix(h ^ lanes[3]);
+}
+
+StoredImage ImageStore::intern(std::vector<uint8_t>&& data) {
+    // 哈希在锁外计算
+    ImageHash key = hash(data.data(), data.size());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (;; ++key) {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            break;
+        }
+        std::shared_ptr<const std::vector<uint8_t>> existing = it->second.lock();
+        if (!existing) {
+            // 之前的数据已释放，复用这个哈希
+            break;
+        }
+        if (*existing == data) {
+            dedupedBytes_ += data.size();
+            return StoredImage{key, std::move(existing)};
+        }
+        // 哈希冲突：顺延到下一个哈希值
+    }
+
+    auto stored = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+    entries_[key] = stored;
+    if (entries_.size() >= purgeThreshold_) {
+        purgeExpired();
+        purgeThreshold_ = std::max<size_t>(64, entries_.size() * 2);
+    }
+    return StoredImage{key, std::move(stored)};
+}
+
+std::string ImageStore::fileName(ImageHash hash, const std::string& format) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return format.empty() ? std::string(hex) : std::string(hex) + "." + format;
+}
+
+bool ImageStore::isSafeFormat(const std::string& format) {
+    return !format.empty() && format.size() <= 8 &&
+           std::all_of(format.begin(), format.end(), [](char c) {
+               return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+           });
+}
+
+std::string ImageStore::writeOnce(const StoredImage& image, const std::string& format,
+                                  const std::string& directory) {
+    std::string name = fileName(image.hash, isSafeFormat(format) ? format : std::string("bin"));
+    std::filesystem::path path = std::filesystem::path(directory) / name;
+    std::string key = path.lexically_normal().string();
+
+    // 第一个写这份内容的调用方登记后负责写入，其余调用方等待它的结果。
+    // 记录的数据已释放（哈希可能已被其他内容复用）时重新写
+    std::promise<void> written;
+    std::shared_future<void> pending;
+    for (;;) {
+        std::shared_future<void> other;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = written_.find(key);
+            if (it == written_.end()) {
+                written_.emplace(key, WrittenFile{image.data, written.get_future().share()});
+                if (written_.size() >= writtenPurgeThreshold_) {
+                    purgeWritten();
+                    writtenPurgeThreshold_ = std::max<size_t>(64, written_.size() * 2);
+                }
+                break;
+            }
+            std::shared_ptr<const std::vector<uint8_t>> data = it->second.data.lock();
+            if (data && image.data && (data == image.data || *data == *image.data)) {
+                pending = it->second.done;
+                break;
+            }
+            other = it->second.done;
+            if (other.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                written_.erase(it);
+                continue;
+            }
+        }
+        // 其他数据正在写入同名文件，等它结束后重新判断
+        other.wait();
+    }
+    if (pending.valid()) {
+        pending.get();  // 写入失败时重新抛出同一个异常
+        return name;
+    }
+
+    // 写文件时不持锁；失败时撤销记录，下次调用重试
+    try {
+        writeFile(image, path);
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            written_.erase(key);
+        }
+        written.set_exception(std::current_exception());
+        throw;
+    }
+    written.set_value();
+    return name;
+}
+
+size_t ImageStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t live = 0;
+    for (const auto& entry : entries_) {
+        if (!entry.second.expired()) {
+            ++live;
+        }
+    }
+    return live;
+}
+
+size_t ImageStore::dedupedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dedupedBytes_;
+}
+
+void ImageStore::purgeExpired() {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.expired()) {
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ImageStore::purgeWritten() {
+    // 图片数据释放后不再需要记住它写到了哪里：之后再写同一内容时比较文件内容即可。
+    // 正在写的记录保留，由写入方自己撤销
+    for (auto it = written_.begin(); it != written_.end();) {
+        bool writing = it->second.done.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+        if (!writing && it->second.data.expired()) {
+            it = written_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace doc_converter
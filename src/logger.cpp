@@ -18,6 +18,7 @@ Logger& Logger::getInstance() {
 }
 
 bool Logger::init(const std::string& logFile) {
+    std::lock_guard<std::mutex> lock(mutex_);
     try {
         fileStream_.open(logFile, std::ios::app);
         if (!fileStream_.is_open()) {
@@ -78,11 +79,13 @@ std::string Logger::getLevelString(LogLevel level) {
 void Logger::log(LogLevel level, const std::string& message) {
     // 获取当前时间
     auto now = std::time(nullptr);
-    auto tm = *std::localtime(&now);
+    std::tm tm{};
+    localtime_r(&now, &tm);
     std::ostringstream oss;
     oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
 
     // 输出日志
+    std::lock_guard<std::mutex> lock(mutex_);
     *output_ << "[" << oss.str() << "] [" << getLevelString(level) << "] " << message << std::endl;
 }
 
@@ -6,6 +6,7 @@
  */
 
 #include "doc_converter/main_window.hpp"
+#include "doc_converter/flat_document.hpp"
 #include "doc_converter/logger.hpp"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -131,34 +132,31 @@ void MainWindow::updatePreview() {
         return;
     }
 
+    // 预览按顺序扫描列式快照，不逐个访问分散的元素对象
+    FlatDocument flat(*doc_);
     std::stringstream ss;
-    const auto& elements = doc_->getElements();
-    
-    for (const auto& element : elements) {
-        switch (element->getType()) {
+
+    for (const auto& element : flat) {
+        switch (element.type()) {
             case ElementType::Text: {
-                auto text = std::dynamic_pointer_cast<TextElement>(element);
-                ss << text->getText() << "\n";
+                ss << element.text() << "\n";
                 break;
             }
             case ElementType::Paragraph: {
-                auto para = std::dynamic_pointer_cast<ParagraphElement>(element);
-                for (const auto& text : para->getTexts()) {
-                    ss << text->getText() << " ";
+                for (std::string_view text : element.runs()) {
+                    ss << text << " ";
                 }
                 ss << "\n\n";
                 break;
             }
             case ElementType::Heading: {
-                auto heading = std::dynamic_pointer_cast<HeadingElement>(element);
-                ss << "#" << heading->getLevel() << " " << heading->getText() << "\n\n";
+                ss << "#" << element.headingLevel() << " " << element.text() << "\n\n";
                 break;
             }
             case ElementType::Table: {
-                auto table = std::dynamic_pointer_cast<TableElement>(element);
-                for (const auto& row : table->getRows()) {
-                    for (const auto& cell : row.getCells()) {
-                        ss << "|" << cell.getText() << "|";
+                for (const auto& row : element.rows()) {
+                    for (std::string_view cell : row) {
+                        ss << "|" << cell << "|";
                     }
                     ss << "\n";
                 }
@@ -166,9 +164,9 @@ void MainWindow::updatePreview() {
                 break;
             }
             case ElementType::Image: {
-                auto image = std::dynamic_pointer_cast<ImageElement>(element);
-                ss << "[图片: " << image->getWidth() << "x" << image->getHeight() 
-                   << " (" << image->getFormat() << ")]\n\n";
+                const FlatDocument::ImageInfo* image = element.image();
+                ss << "[图片: " << image->width << "x" << image->height
+                   << " (" << flat.text(image->format) << ")]\n\n";
                 break;
             }
             default:
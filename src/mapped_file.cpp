@@ -0,0 +1,130 @@
+/**
+ * @file mapped_file.cpp
+ * @brief 只读文件输入层的实现
+ */
+
+#include "doc_converter/mapped_file.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace doc_converter {
+
+namespace {
+
+/**
+ * @brief 无法映射时每次read()的块大小
+ */
+constexpr size_t kReadBlockSize = 1 << 20;
+
+/**
+ * @brief 自动关闭文件描述符
+ */
+struct FileDescriptor {
+    int fd;
+    ~FileDescriptor() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+std::runtime_error systemError(const std::string& what, const std::string& filePath) {
+    return std::runtime_error(what + ": " + filePath + " (" + std::strerror(errno) + ")");
+}
+
+} // namespace
+
+MappedFile::MappedFile(const std::string& filePath, Access access) {
+    FileDescriptor file{open(filePath.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (file.fd < 0) {
+        throw systemError("Failed to open file", filePath);
+    }
+    struct stat st;
+    if (fstat(file.fd, &st) != 0) {
+        throw systemError("Failed to stat file", filePath);
+    }
+
+    // 普通非空文件直接映射
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (addr != MAP_FAILED) {
+            madvise(addr, static_cast<size_t>(st.st_size),
+                    access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+            data_ = static_cast<const uint8_t*>(addr);
+            size_ = static_cast<size_t>(st.st_size);
+            mapped_ = true;
+            return;
+        }
+    }
+
+    // 管道等无法映射的输入：按大块读到结尾
+    if (S_ISREG(st.st_mode)) {
+        buffer_.reserve(static_cast<size_t>(st.st_size));
+    }
+    size_t used = 0;
+    for (;;) {
+        if (buffer_.size() - used < kReadBlockSize) {
+            buffer_.resize(used + kReadBlockSize);
+        }
+        ssize_t n = read(file.fd, buffer_.data() + used, buffer_.size() - used);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw systemError("Failed to read file", filePath);
+        }
+        if (n == 0) {
+            break;
+        }
+        used += static_cast<size_t>(n);
+    }
+    buffer_.resize(used);
+    buffer_.shrink_to_fit();
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+MappedFile::MappedFile(std::vector<uint8_t> bytes) : buffer_(std::move(bytes)) {
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() {
+    reset();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        reset();
+        mapped_ = other.mapped_;
+        size_ = other.size_;
+        buffer_ = std::move(other.buffer_);
+        data_ = mapped_ ? other.data_ : buffer_.data();
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+        other.buffer_.clear();
+    }
+    return *this;
+}
+
+void MappedFile::reset() noexcept {
+    if (mapped_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
+}
+
+} // namespace doc_converter
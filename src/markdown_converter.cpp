@@ -0,0 +1,267 @@
+/**
+ * @file markdown_converter.cpp
+ * @brief Markdown转换器的实现
+ */
+
+#include "doc_converter/markdown_converter.hpp"
+#include "doc_converter/document_elements.hpp"
+#include "doc_converter/logger.hpp"
+#include "image_output.hpp"
+#include "text_escape.hpp"
+#include <algorithm>
+
+namespace doc_converter {
+
+/**
+ * @brief 把元素写成Markdown的访问者
+ */
+class MarkdownConverter::Writer : public ElementVisitor {
+public:
+    /**
+     * @brief 构造函数
+     * @param out 输出层
+     * @param images 图片的输出位置
+     */
+    Writer(OutputSink& out, detail::ImageOutput& images) : out_(out), images_(images) {}
+
+    using ElementVisitor::visit;
+
+    void begin(const std::string& title) {
+        if (title.empty()) {
+            return;
+        }
+        out_ << "# ";
+        detail::escapeMarkdown(title, detail::MarkdownContext::Heading, out_);
+        out_ << "\n\n";
+    }
+
+    void end() { endList(); }
+
+    void visit(const HeadingElement& heading) override {
+        endList();
+        out_.fill('#', static_cast<size_t>(std::clamp(heading.getLevel(), 1, 6)));
+        out_ << ' ';
+        detail::escapeMarkdown(heading.getText(), detail::MarkdownContext::Heading, out_);
+        out_ << "\n\n";
+    }
+
+    void visit(const ParagraphElement& para) override {
+        if (isEmpty(para)) {
+            return;
+        }
+        if (para.isListItem()) {
+            writeListItem(para);
+            return;
+        }
+        endList();
+        writeRuns(para);
+        out_ << "\n\n";
+    }
+
+    void visit(const TextElement& text) override {
+        std::string_view rest = text.getText();
+        if (rest.empty()) {
+            return;
+        }
+        endList();
+        detail::escapeMarkdownBlockStart(rest, out_);
+        detail::escapeMarkdown(rest, detail::MarkdownContext::Paragraph, out_);
+        out_ << "\n\n";
+    }
+
+    void visit(const TableElement& table) override {
+        const std::vector<TableRow>& rows = table.getRows();
+        // 渲染器丢弃超出表头宽度的单元格，表头和分隔行按最宽的一行补齐；较短的行由渲染器补齐
+        size_t columns = 0;
+        for (const TableRow& row : rows) {
+            columns = std::max(columns, row.getCells().size());
+        }
+        if (columns == 0) {
+            return;
+        }
+        endList();
+        // 第一行作为表头
+        writeRow(rows.front(), columns);
+        out_ << '|';
+        for (size_t i = 0; i < columns; ++i) {
+            out_ << " --- |";
+        }
+        out_ << '\n';
+        for (size_t i = 1; i < rows.size(); ++i) {
+            writeRow(rows[i], 0);
+        }
+        out_ << '\n';
+    }
+
+    void visit(const ImageElement& image) override {
+        const std::vector<uint8_t>& data = image.getImageData();
+        if (data.empty()) {
+            return;
+        }
+        endList();
+        out_ << "![](";
+        if (images_.embedded()) {
+            out_ << "data:" << detail::ImageOutput::mimeType(image.getFormat()) << ";base64,";
+            detail::writeBase64(data.data(), data.size(), out_);
+        } else {
+            writeDestination(images_.writeFile(image));
+        }
+        out_ << ")\n\n";
+    }
+
+private:
+    /**
+     * @brief 列表中仍未结束的一级
+     */
+    struct OpenList {
+        int level;      ///< 列表级别
+        size_t indent;  ///< 下一级列表项的缩进（本级列表项内容所在的列）
+    };
+
+    static bool isEmpty(const ParagraphElement& para) {
+        for (std::string_view text : para.getTexts()) {
+            if (!text.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void writeRuns(const ParagraphElement& para) {
+        // 块开头在第一个含非空白字符的运行中；之前只含空白的运行整段略去
+        bool blockStart = true;
+        for (std::string_view text : para.getTexts()) {
+            if (blockStart && !detail::escapeMarkdownBlockStart(text, out_)) {
+                continue;
+            }
+            blockStart = false;
+            detail::escapeMarkdown(text, detail::MarkdownContext::Paragraph, out_);
+        }
+    }
+
+    /**
+     * @brief 写出列表项，更深的一级缩进到上一级列表项内容所在的列
+     */
+    void writeListItem(const ParagraphElement& para) {
+        int level = para.getListLevel();
+        while (!lists_.empty() && lists_.back().level >= level) {
+            lists_.pop_back();
+        }
+        size_t indent = lists_.empty() ? 0 : lists_.back().indent;
+        const std::string& format = para.getListFormat();
+        std::string_view marker = format.empty() || format == "bullet" ? "- " : "1. ";
+        out_.fill(' ', indent);
+        out_ << marker;
+        lists_.push_back({level, indent + marker.size()});
+        writeRuns(para);
+        out_ << '\n';
+    }
+
+    /**
+     * @brief 结束列表，与后面的块之间空一行
+     */
+    void endList() {
+        if (!lists_.empty()) {
+            out_ << '\n';
+            lists_.clear();
+        }
+    }
+
+    void writeRow(const TableRow& row, size_t minColumns) {
+        out_ << '|';
+        for (const TableCell& cell : row.getCells()) {
+            out_ << ' ';
+            detail::escapeMarkdown(cell.getText(), detail::MarkdownContext::TableCell, out_);
+            out_ << " |";
+        }
+        for (size_t i = row.getCells().size(); i < minColumns; ++i) {
+            out_ << "  |";
+        }
+        out_ << '\n';
+    }
+
+    /**
+     * @brief 写出链接目标，编码空格、括号等会结束链接的字符
+     */
+    void writeDestination(std::string_view path) {
+        static const char kHex[] = "0123456789ABCDEF";
+        for (char c : path) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (u <= 0x20 || c == '(' || c == ')' || c == '<' || c == '>' || c == '\\' || c == '%') {
+                out_ << '%' << kHex[u >> 4] << kHex[u & 0x0F];
+            } else {
+                out_ << c;
+            }
+        }
+    }
+
+    OutputSink& out_;
+    detail::ImageOutput& images_;
+    std::vector<OpenList> lists_;
+};
+
+MarkdownConverter::MarkdownConverter(std::shared_ptr<ImageStore> imageStore)
+    : imageStore_(imageStore ? std::move(imageStore) : std::make_shared<ImageStore>()) {}
+
+bool MarkdownConverter::convert(const Document& doc, const std::string& outputPath) {
+    try {
+        FileSink sink(outputPath);
+        write(doc.getTitle(), outputPath, sink, nullptr, &doc);
+        sink.close();
+        return true;
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to convert document to Markdown: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool MarkdownConverter::convert(const Document& doc, OutputSink& sink) {
+    try {
+        write(doc.getTitle(), std::string(), sink, nullptr, &doc);
+        return true;
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to convert document to Markdown: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool MarkdownConverter::convert(ElementCursor& cursor, const std::string& outputPath) {
+    try {
+        FileSink sink(outputPath);
+        write(cursor.getTitle(), outputPath, sink, &cursor, nullptr);
+        sink.close();
+        return cursor.finish();
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to convert document to Markdown: " + std::string(e.what()));
+        cursor.finish();
+        return false;
+    }
+}
+
+bool MarkdownConverter::convert(ElementCursor& cursor, OutputSink& sink) {
+    try {
+        write(cursor.getTitle(), std::string(), sink, &cursor, nullptr);
+        return cursor.finish();
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Failed to convert document to Markdown: " + std::string(e.what()));
+        cursor.finish();
+        return false;
+    }
+}
+
+void MarkdownConverter::write(const std::string& title, const std::string& outputPath, OutputSink& sink,
+                              ElementCursor* cursor, const Document* doc) const {
+    detail::ImageOutput images(*imageStore_, imageMode_, outputPath, imageDirectory_);
+    Writer writer(sink, images);
+    writer.begin(title);
+    if (cursor) {
+        while (auto element = cursor->next()) {
+            element->accept(writer);
+        }
+    } else {
+        doc->visitElements(writer);
+    }
+    writer.end();
+}
+
+} // namespace doc_converter
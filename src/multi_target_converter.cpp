@@ -0,0 +1,112 @@
+/**
+ * @file multi_target_converter.cpp
+ * @brief 一次解析、多个目标的转换的实现
+ */
+
+#include "doc_converter/multi_target_converter.hpp"
+#include "doc_converter/logger.hpp"
+#include <filesystem>
+#include <future>
+#include <system_error>
+#include <unordered_set>
+
+namespace doc_converter {
+
+namespace {
+
+/**
+ * @brief 转换单个目标并记录结果
+ */
+void runTarget(const Document& doc, Converter& converter, ConversionResult& result) {
+    auto start = std::chrono::steady_clock::now();
+    try {
+        result.success = converter.convert(doc, result.outputPath);
+        if (!result.success) {
+            result.error = "Converter " + result.converterName + " failed";
+        }
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    } catch (...) {
+        result.error = "Unknown error";
+    }
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+}
+
+/**
+ * @brief 用于比较输出路径的规范形式
+ */
+std::string normalizedPath(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+    return (ec ? std::filesystem::path(path) : absolute).lexically_normal().string();
+}
+
+} // namespace
+
+std::vector<ConversionResult> MultiTargetConverter::convert(const Document& doc,
+                                                            const std::vector<ConversionTarget>& targets) {
+    std::vector<ConversionResult> results(targets.size());
+    std::vector<std::shared_ptr<Converter>> converters(targets.size());
+    std::unordered_set<std::string> outputPaths;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        const ConversionTarget& target = targets[i];
+        ConversionResult& result = results[i];
+        converters[i] = target.converter ? target.converter : ConverterFactory::createConverter(target.converterName);
+        result.converterName = converters[i] ? converters[i]->getName() : target.converterName;
+        result.outputPath = target.outputPath;
+        if (!converters[i]) {
+            result.error = "Unknown converter: " + target.converterName;
+        } else if (!outputPaths.insert(normalizedPath(target.outputPath)).second) {
+            result.error = "Output path already used by another target: " + target.outputPath;
+            converters[i].reset();
+        }
+    }
+
+    // 每个目标一个线程，最后一个目标在调用线程上转换
+    std::vector<size_t> runnable;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (converters[i]) {
+            runnable.push_back(i);
+        }
+    }
+    std::vector<std::future<void>> futures;
+    for (size_t k = 0; k < runnable.size(); ++k) {
+        size_t i = runnable[k];
+        if (k + 1 < runnable.size()) {
+            try {
+                futures.push_back(std::async(std::launch::async, runTarget, std::cref(doc),
+                                             std::ref(*converters[i]), std::ref(results[i])));
+                continue;
+            } catch (const std::system_error&) {
+                // 无法创建线程时在调用线程上转换
+            }
+        }
+        runTarget(doc, *converters[i], results[i]);
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    for (const ConversionResult& result : results) {
+        if (!result.success) {
+            Logger::getInstance().error("Failed to convert to " + result.outputPath + ": " + result.error);
+        }
+    }
+    return results;
+}
+
+std::vector<ConversionResult> MultiTargetConverter::convertFile(Document& doc, const std::string& inputPath,
+                                                                const std::vector<ConversionTarget>& targets) {
+    if (doc.loadFromFile(inputPath)) {
+        return convert(doc, targets);
+    }
+    std::vector<ConversionResult> results(targets.size());
+    for (size_t i = 0; i < targets.size(); ++i) {
+        results[i].converterName = targets[i].converter ? targets[i].converter->getName() : targets[i].converterName;
+        results[i].outputPath = targets[i].outputPath;
+        results[i].error = "Failed to load document: " + inputPath;
+    }
+    return results;
+}
+
+} // namespace doc_converter
@@ -0,0 +1,185 @@
+/**
+ * @file ooxml_tags.cpp
+ * @brief WordprocessingML元素名标签表的实现
+ */
+
+#include "ooxml_tags.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace doc_converter {
+namespace detail {
+
+namespace {
+
+/**
+ * @brief 词表项：本地名在词表中唯一，对应一个命名空间和标签
+ *
+ * 按指针逐个比较，正文中最常见的名称排在前面。
+ */
+struct Vocabulary {
+    const char* localName;
+    OoxmlNamespace ns;
+    OoxmlTag tag;
+};
+
+constexpr Vocabulary kVocabulary[] = {
+    {"p", OoxmlNamespace::Wordprocessing, OoxmlTag::Paragraph},
+    {"r", OoxmlNamespace::Wordprocessing, OoxmlTag::Run},
+    {"t", OoxmlNamespace::Wordprocessing, OoxmlTag::Text},
+    {"pPr", OoxmlNamespace::Wordprocessing, OoxmlTag::ParagraphProperties},
+    {"pStyle", OoxmlNamespace::Wordprocessing, OoxmlTag::ParagraphStyle},
+    {"outlineLvl", OoxmlNamespace::Wordprocessing, OoxmlTag::OutlineLevel},
+    {"numPr", OoxmlNamespace::Wordprocessing, OoxmlTag::NumberingProperties},
+    {"ilvl", OoxmlNamespace::Wordprocessing, OoxmlTag::IndentLevel},
+    {"numId", OoxmlNamespace::Wordprocessing, OoxmlTag::NumberingId},
+    {"tab", OoxmlNamespace::Wordprocessing, OoxmlTag::Tab},
+    {"br", OoxmlNamespace::Wordprocessing, OoxmlTag::Break},
+    {"cr", OoxmlNamespace::Wordprocessing, OoxmlTag::CarriageReturn},
+    {"del", OoxmlNamespace::Wordprocessing, OoxmlTag::Deleted},
+    {"moveFrom", OoxmlNamespace::Wordprocessing, OoxmlTag::MoveFrom},
+    {"tbl", OoxmlNamespace::Wordprocessing, OoxmlTag::Table},
+    {"tr", OoxmlNamespace::Wordprocessing, OoxmlTag::TableRow},
+    {"tc", OoxmlNamespace::Wordprocessing, OoxmlTag::TableCell},
+    {"drawing", OoxmlNamespace::Wordprocessing, OoxmlTag::Drawing},
+    {"style", OoxmlNamespace::Wordprocessing, OoxmlTag::Style},
+    {"name", OoxmlNamespace::Wordprocessing, OoxmlTag::StyleName},
+    {"basedOn", OoxmlNamespace::Wordprocessing, OoxmlTag::BasedOn},
+    {"num", OoxmlNamespace::Wordprocessing, OoxmlTag::Num},
+    {"abstractNum", OoxmlNamespace::Wordprocessing, OoxmlTag::AbstractNum},
+    {"abstractNumId", OoxmlNamespace::Wordprocessing, OoxmlTag::AbstractNumId},
+    {"lvl", OoxmlNamespace::Wordprocessing, OoxmlTag::Level},
+    {"numFmt", OoxmlNamespace::Wordprocessing, OoxmlTag::NumberFormat},
+    {"footnote", OoxmlNamespace::Wordprocessing, OoxmlTag::Footnote},
+    {"endnote", OoxmlNamespace::Wordprocessing, OoxmlTag::Endnote},
+    {"blip", OoxmlNamespace::Drawing, OoxmlTag::Blip},
+    {"extent", OoxmlNamespace::WordprocessingDrawing, OoxmlTag::Extent},
+    {"body", OoxmlNamespace::Wordprocessing, OoxmlTag::Body},
+};
+
+constexpr size_t kVocabularySize = sizeof(kVocabulary) / sizeof(kVocabulary[0]);
+constexpr uint8_t kNotFound = 0xFF;
+
+/**
+ * @brief 不使用字典时按字符串查找词表
+ */
+uint8_t findByName(const xmlChar* name) {
+    for (size_t i = 0; i < kVocabularySize; ++i) {
+        if (std::strcmp(kVocabulary[i].localName, reinterpret_cast<const char*>(name)) == 0) {
+            return static_cast<uint8_t>(i);
+        }
+    }
+    return kNotFound;
+}
+
+/**
+ * @brief 命名空间URI（Transitional与Strict）
+ */
+struct NamespaceUri {
+    std::string_view uri;
+    OoxmlNamespace ns;
+};
+
+constexpr NamespaceUri kNamespaceUris[] = {
+    {"http://schemas.openxmlformats.org/wordprocessingml/2006/main", OoxmlNamespace::Wordprocessing},
+    {"http://purl.oclc.org/ooxml/wordprocessingml/main", OoxmlNamespace::Wordprocessing},
+    {"http://schemas.openxmlformats.org/drawingml/2006/main", OoxmlNamespace::Drawing},
+    {"http://purl.oclc.org/ooxml/drawingml/main", OoxmlNamespace::Drawing},
+    {"http://schemas.openxmlformats.org/drawingml/2006/wordprocessingDrawing",
+     OoxmlNamespace::WordprocessingDrawing},
+    {"http://purl.oclc.org/ooxml/drawingml/wordprocessingDrawing", OoxmlNamespace::WordprocessingDrawing},
+    {"http://schemas.openxmlformats.org/drawingml/2006/picture", OoxmlNamespace::Picture},
+    {"http://purl.oclc.org/ooxml/drawingml/picture", OoxmlNamespace::Picture},
+    {"http://schemas.openxmlformats.org/officeDocument/2006/relationships", OoxmlNamespace::Relationships},
+    {"http://purl.oclc.org/ooxml/officeDocument/relationships", OoxmlNamespace::Relationships},
+};
+
+} // namespace
+
+OoxmlNamespace namespaceFromUri(const xmlChar* href) {
+    if (!href) {
+        return OoxmlNamespace::Other;
+    }
+    std::string_view uri(reinterpret_cast<const char*>(href));
+    for (const auto& entry : kNamespaceUris) {
+        if (entry.uri == uri) {
+            return entry.ns;
+        }
+    }
+    return OoxmlNamespace::Other;
+}
+
+std::string attributeValue(xmlNodePtr node, const char* name) {
+    xmlChar* value = xmlGetProp(node, (const xmlChar*)name);
+    std::string result = value ? (const char*)value : "";
+    xmlFree(value);
+    return result;
+}
+
+int intAttributeValue(xmlNodePtr node, const char* name, int fallback) {
+    xmlChar* value = xmlGetProp(node, (const xmlChar*)name);
+    int result = value ? std::atoi((const char*)value) : fallback;
+    xmlFree(value);
+    return result;
+}
+
+void TagTable::bind(xmlDictPtr dict) {
+    static_assert(kVocabularySize <= kMaxVocabulary, "TagTable::kMaxVocabulary is too small");
+    dict_ = dict;
+    interned_.fill(nullptr);
+    if (!dict) {
+        return;
+    }
+    for (size_t i = 0; i < kVocabularySize; ++i) {
+        interned_[i] = xmlDictLookup(dict, reinterpret_cast<const xmlChar*>(kVocabulary[i].localName), -1);
+    }
+}
+
+OoxmlNamespace TagTable::namespaceOf(xmlNsPtr ns) {
+    if (!ns) {
+        return OoxmlNamespace::Other;
+    }
+    // 一个文档中通常只有少数几个命名空间声明，线性查找即可
+    for (const auto& entry : namespaces_) {
+        if (entry.first == ns) {
+            return entry.second;
+        }
+    }
+    OoxmlNamespace result = namespaceFromUri(ns->href);
+    namespaces_.emplace_back(ns, result);
+    return result;
+}
+
+OoxmlTag TagTable::tagOf(xmlNodePtr node) {
+    if (node->type != XML_ELEMENT_NODE || !node->name) {
+        return OoxmlTag::Unknown;
+    }
+
+    xmlDictPtr dict = node->doc ? node->doc->dict : nullptr;
+    if (dict != dict_) {
+        bind(dict);
+    }
+
+    // 词表很小，逐个比较指针比计算哈希更快
+    uint8_t index = kNotFound;
+    for (size_t i = 0; i < kVocabularySize; ++i) {
+        if (interned_[i] == node->name) {
+            index = static_cast<uint8_t>(i);
+            break;
+        }
+    }
+    if (index == kNotFound && (!dict_ || !xmlDictOwns(dict_, node->name))) {
+        // 名称不在字典中（例如以XML_PARSE_NODICT解析），退回字符串比较
+        index = findByName(node->name);
+    }
+    if (index == kNotFound) {
+        return OoxmlTag::Unknown;
+    }
+
+    const Vocabulary& entry = kVocabulary[index];
+    return namespaceOf(node->ns) == entry.ns ? entry.tag : OoxmlTag::Unknown;
+}
+
+} // namespace detail
+} // namespace doc_converter
@@ -0,0 +1,147 @@
+/**
+ * @file ooxml_tags.hpp
+ * @brief WordprocessingML元素名的标签表（内部头文件）
+ *
+ * 解析器按元素分派时不再逐个调用xmlStrcmp：
+ * - 已知的本地名预先在文档所用的libxml2字典中驻留，节点名与按词表顺序存放的驻留指针逐个比较
+ * - 命名空间按URI识别（同时支持Transitional和Strict），并缓存每个xmlNs的结果
+ * 得到的标签是一个枚举值，可直接用于switch。
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <libxml/tree.h>
+#include <libxml/dict.h>
+
+namespace doc_converter {
+namespace detail {
+
+/**
+ * @brief OOXML命名空间
+ */
+enum class OoxmlNamespace : uint8_t {
+    Other,                  ///< 其他命名空间或无命名空间
+    Wordprocessing,         ///< w:
+    Drawing,                ///< a:
+    WordprocessingDrawing,  ///< wp:
+    Picture,                ///< pic:
+    Relationships           ///< r:
+};
+
+/**
+ * @brief 解析器识别的元素
+ */
+enum class OoxmlTag : uint8_t {
+    Unknown,              ///< 未识别的元素
+    Body,                 ///< w:body
+    Paragraph,            ///< w:p
+    ParagraphProperties,  ///< w:pPr
+    ParagraphStyle,       ///< w:pStyle
+    OutlineLevel,         ///< w:outlineLvl
+    NumberingProperties,  ///< w:numPr
+    IndentLevel,          ///< w:ilvl
+    NumberingId,          ///< w:numId
+    Run,                  ///< w:r
+    Text,                 ///< w:t
+    Tab,                  ///< w:tab
+    Break,                ///< w:br
+    CarriageReturn,       ///< w:cr
+    Deleted,              ///< w:del
+    MoveFrom,             ///< w:moveFrom
+    Table,                ///< w:tbl
+    TableRow,             ///< w:tr
+    TableCell,            ///< w:tc
+    Drawing,              ///< w:drawing
+    Style,                ///< w:style（styles.xml）
+    StyleName,            ///< w:name
+    BasedOn,              ///< w:basedOn
+    Num,                  ///< w:num（numbering.xml）
+    AbstractNum,          ///< w:abstractNum
+    AbstractNumId,        ///< w:abstractNumId
+    Level,                ///< w:lvl
+    NumberFormat,         ///< w:numFmt
+    Footnote,             ///< w:footnote（footnotes.xml）
+    Endnote,              ///< w:endnote（endnotes.xml）
+    Blip,                 ///< a:blip
+    Extent                ///< wp:extent
+};
+
+/**
+ * @brief 按URI识别命名空间
+ * @param href 命名空间URI，可以为空
+ * @return OoxmlNamespace 命名空间
+ */
+OoxmlNamespace namespaceFromUri(const xmlChar* href);
+
+/**
+ * @brief 读取属性值（不区分命名空间前缀，如 w:val）
+ * @param node 元素节点
+ * @param name 属性本地名
+ * @return string 属性值，不存在时为空
+ */
+std::string attributeValue(xmlNodePtr node, const char* name);
+
+/**
+ * @brief 读取整数属性值
+ * @param node 元素节点
+ * @param name 属性本地名
+ * @param fallback 属性不存在时的返回值
+ * @return int 属性值
+ */
+int intAttributeValue(xmlNodePtr node, const char* name, int fallback);
+
+/**
+ * @brief 元素标签表
+ *
+ * 绑定到节点所在文档的字典，字典变化时（例如并行分块各自的文档）自动重新驻留。
+ * 非线程安全，每个解析上下文持有一个。
+ */
+class TagTable {
+public:
+    /**
+     * @brief 获取元素节点的标签
+     * @param node XML节点
+     * @return OoxmlTag 标签，非元素节点或未识别的元素返回 OoxmlTag::Unknown
+     */
+    OoxmlTag tagOf(xmlNodePtr node);
+
+    /**
+     * @brief 获取命名空间（带缓存）
+     * @param ns 命名空间节点，可以为空
+     * @return OoxmlNamespace 命名空间
+     */
+    OoxmlNamespace namespaceOf(xmlNsPtr ns);
+
+    /**
+     * @brief 清空命名空间缓存
+     *
+     * 流式解析时reader会释放已处理的节点（连同其上的命名空间声明），
+     * 地址可能被重新使用，每处理完一个块后需要调用。
+     */
+    void forgetNamespaces() { namespaces_.clear(); }
+
+private:
+    /**
+     * @brief 在字典中驻留全部已知本地名
+     * @param dict 文档字典
+     */
+    void bind(xmlDictPtr dict);
+
+    /**
+     * @brief 词表容量（词表项数不超过此值）
+     */
+    static constexpr size_t kMaxVocabulary = 32;
+
+    xmlDictPtr dict_ = nullptr;                               ///< 当前绑定的字典
+    std::array<const xmlChar*, kMaxVocabulary> interned_{};   ///< 按词表下标存放的驻留名指针
+    std::vector<std::pair<xmlNsPtr, OoxmlNamespace>> namespaces_;  ///< 命名空间缓存
+};
+
+} // namespace detail
+} // namespace doc_converter
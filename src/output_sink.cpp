@@ -0,0 +1,147 @@
+/**
+ * @file output_sink.cpp
+ * @brief 转换器输出层的实现
+ */
+
+#include "doc_converter/output_sink.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace doc_converter {
+
+namespace {
+
+std::runtime_error systemError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + ": " + path + " (" + std::strerror(errno) + ")");
+}
+
+} // namespace
+
+OutputSink::OutputSink(size_t bufferSize)
+    : buffer_(new char[std::max<size_t>(bufferSize, 1)]), capacity_(std::max<size_t>(bufferSize, 1)) {}
+
+void OutputSink::fill(char c, size_t count) {
+    while (count > 0) {
+        if (used_ == capacity_) {
+            flushBuffer();
+        }
+        size_t n = std::min(count, capacity_ - used_);
+        std::memset(buffer_.get() + used_, c, n);
+        used_ += n;
+        count -= n;
+    }
+}
+
+void OutputSink::writeLarge(std::string_view text) {
+    if (text.size() >= capacity_ / 2) {
+        // 大段文本不复制，与缓冲区中的内容一次写出
+        std::string_view chunks[2] = {std::string_view(buffer_.get(), used_), text};
+        writeChunks(used_ > 0 ? chunks : chunks + 1, used_ > 0 ? 2 : 1);
+        flushed_ += used_ + text.size();
+        used_ = 0;
+        return;
+    }
+    flushBuffer();
+    std::memcpy(buffer_.get(), text.data(), text.size());
+    used_ = text.size();
+}
+
+void OutputSink::flushBuffer() {
+    if (used_ == 0) {
+        return;
+    }
+    std::string_view chunk(buffer_.get(), used_);
+    writeChunks(&chunk, 1);
+    flushed_ += used_;
+    used_ = 0;
+}
+
+FileSink::FileSink(const std::string& filePath, size_t bufferSize)
+    : OutputSink(bufferSize), path_(filePath),
+      fd_(::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)), owned_(true) {
+    if (fd_ < 0) {
+        throw systemError("Failed to open output file", filePath);
+    }
+}
+
+FileSink::FileSink(int fd, size_t bufferSize)
+    : OutputSink(bufferSize), path_("fd " + std::to_string(fd)), fd_(fd), owned_(false) {}
+
+FileSink::~FileSink() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // 析构时无法报告错误
+    }
+}
+
+void FileSink::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    try {
+        flush();
+    } catch (...) {
+        if (owned_) {
+            ::close(fd_);
+        }
+        fd_ = -1;
+        throw;
+    }
+    int fd = fd_;
+    fd_ = -1;
+    if (owned_ && ::close(fd) != 0) {
+        throw systemError("Failed to close output file", path_);
+    }
+}
+
+void FileSink::writeChunks(const std::string_view* chunks, size_t count) {
+    if (fd_ < 0) {
+        throw std::runtime_error("Output file already closed: " + path_);
+    }
+    constexpr size_t kMaxChunks = 16;
+    struct iovec iov[kMaxChunks];
+    while (count > 0) {
+        size_t n = std::min(count, kMaxChunks);
+        for (size_t i = 0; i < n; ++i) {
+            iov[i].iov_base = const_cast<char*>(chunks[i].data());
+            iov[i].iov_len = chunks[i].size();
+        }
+        // 部分写入时跳过已写出的段，调整第一段的起点后继续
+        struct iovec* pending = iov;
+        size_t remaining = n;
+        while (remaining > 0) {
+            ssize_t written = ::writev(fd_, pending, static_cast<int>(remaining));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw systemError("Failed to write output file", path_);
+            }
+            size_t done = static_cast<size_t>(written);
+            while (remaining > 0 && done >= pending->iov_len) {
+                done -= pending->iov_len;
+                ++pending;
+                --remaining;
+            }
+            if (remaining > 0) {
+                pending->iov_base = static_cast<char*>(pending->iov_base) + done;
+                pending->iov_len -= done;
+            }
+        }
+        chunks += n;
+        count -= n;
+    }
+}
+
+void MemorySink::writeChunks(const std::string_view* chunks, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        data_.append(chunks[i].data(), chunks[i].size());
+    }
+}
+
+} // namespace doc_converter
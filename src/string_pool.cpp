@@ -0,0 +1,43 @@
+/**
+ * @file string_pool.cpp
+ * @brief 文本驻留池的实现
+ */
+
+#include "doc_converter/string_pool.hpp"
+#include <mutex>
+
+namespace doc_converter {
+
+std::string_view StringPool::intern(std::string_view text) {
+    if (text.empty()) {
+        return std::string_view();
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = strings_.find(text);
+        if (it != strings_.end()) {
+            return *it;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // 释放共享锁后其他线程可能已经插入了同样的文本
+    auto it = strings_.find(text);
+    if (it != strings_.end()) {
+        return *it;
+    }
+    std::string_view stored = text_.store(text);
+    strings_.insert(stored);
+    return stored;
+}
+
+size_t StringPool::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return strings_.size();
+}
+
+size_t StringPool::bytesStored() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return text_.bytesStored();
+}
+
+} // namespace doc_converter
@@ -0,0 +1,188 @@
+/**
+ * @file style_table.cpp
+ * @brief styles.xml与numbering.xml解析的实现
+ */
+
+#include "style_table.hpp"
+#include <cctype>
+#include <functional>
+
+namespace doc_converter {
+namespace detail {
+
+namespace {
+
+/**
+ * @brief OOXML允许的最大大纲级别（9 表示正文）
+ */
+constexpr int kBodyTextOutlineLevel = 9;
+
+/**
+ * @brief 编号定义的级别数（w:ilvl 取 0-8）
+ */
+constexpr int kListLevels = 9;
+
+/**
+ * @brief basedOn继承链的最大深度，防止样式循环引用
+ */
+constexpr int kMaxStyleDepth = 32;
+
+/**
+ * @brief 样式定义中与标题级别有关的部分
+ */
+struct StyleDefinition {
+    std::string name;      ///< w:name
+    std::string basedOn;   ///< w:basedOn
+    int outlineLevel = -1; ///< w:pPr/w:outlineLvl（-1 表示未设置）
+};
+
+} // namespace
+
+int headingLevelFromName(std::string_view name) {
+    static constexpr std::string_view kPrefix = "heading";
+    if (name.size() < kPrefix.size()) {
+        return 0;
+    }
+    for (size_t i = 0; i < kPrefix.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(name[i])) != kPrefix[i]) {
+            return 0;
+        }
+    }
+    size_t pos = kPrefix.size();
+    while (pos < name.size() && name[pos] == ' ') {
+        ++pos;
+    }
+    // 只接受单个数字，"Heading 1 Char"之类的字符样式名不会出现在段落样式中
+    if (pos + 1 != name.size() || name[pos] < '1' || name[pos] > '9') {
+        return 0;
+    }
+    return name[pos] - '0';
+}
+
+StyleTable StyleTable::parse(xmlDocPtr doc, TagTable& tags) {
+    std::unordered_map<std::string, StyleDefinition> definitions;
+    xmlNodePtr root = xmlDocGetRootElement(doc);
+    for (xmlNodePtr node = root ? root->children : nullptr; node; node = node->next) {
+        if (tags.tagOf(node) != OoxmlTag::Style) {
+            continue;
+        }
+        // 只有段落样式决定标题级别；未写w:type时默认为段落样式
+        std::string type = attributeValue(node, "type");
+        std::string id = attributeValue(node, "styleId");
+        if (id.empty() || !(type.empty() || type == "paragraph")) {
+            continue;
+        }
+
+        StyleDefinition definition;
+        for (xmlNodePtr child = node->children; child; child = child->next) {
+            switch (tags.tagOf(child)) {
+                case OoxmlTag::StyleName:
+                    definition.name = attributeValue(child, "val");
+                    break;
+                case OoxmlTag::BasedOn:
+                    definition.basedOn = attributeValue(child, "val");
+                    break;
+                case OoxmlTag::ParagraphProperties:
+                    for (xmlNodePtr prop = child->children; prop; prop = prop->next) {
+                        if (tags.tagOf(prop) == OoxmlTag::OutlineLevel) {
+                            definition.outlineLevel = intAttributeValue(prop, "val", kBodyTextOutlineLevel);
+                        }
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        definitions[id] = std::move(definition);
+    }
+
+    // 沿basedOn链展开：自身的大纲级别优先，其次是内置标题样式名，最后继承基础样式
+    StyleTable table;
+    table.levels_.reserve(definitions.size());
+    std::function<int(const std::string&, int)> resolve = [&](const std::string& id, int depth) -> int {
+        auto done = table.levels_.find(id);
+        if (done != table.levels_.end()) {
+            return done->second;
+        }
+        auto it = definitions.find(id);
+        if (it == definitions.end() || depth > kMaxStyleDepth) {
+            return 0;
+        }
+        const StyleDefinition& definition = it->second;
+        int level = 0;
+        if (definition.outlineLevel >= 0) {
+            level = definition.outlineLevel < kBodyTextOutlineLevel ? definition.outlineLevel + 1 : 0;
+        } else if (int named = headingLevelFromName(definition.name)) {
+            level = named;
+        } else if (!definition.basedOn.empty()) {
+            level = resolve(definition.basedOn, depth + 1);
+        }
+        table.levels_[id] = level;
+        return level;
+    };
+    for (const auto& entry : definitions) {
+        resolve(entry.first, 0);
+    }
+    return table;
+}
+
+NumberingTable NumberingTable::parse(xmlDocPtr doc, TagTable& tags) {
+    std::unordered_map<int, std::vector<std::string>> abstractFormats;
+    std::unordered_map<int, int> abstractIds;
+    xmlNodePtr root = xmlDocGetRootElement(doc);
+    for (xmlNodePtr node = root ? root->children : nullptr; node; node = node->next) {
+        switch (tags.tagOf(node)) {
+            case OoxmlTag::AbstractNum: {
+                std::vector<std::string>& levels = abstractFormats[intAttributeValue(node, "abstractNumId", -1)];
+                for (xmlNodePtr lvl = node->children; lvl; lvl = lvl->next) {
+                    if (tags.tagOf(lvl) != OoxmlTag::Level) {
+                        continue;
+                    }
+                    int level = intAttributeValue(lvl, "ilvl", -1);
+                    if (level < 0 || level >= kListLevels) {
+                        continue;
+                    }
+                    if (levels.size() <= static_cast<size_t>(level)) {
+                        levels.resize(static_cast<size_t>(level) + 1);
+                    }
+                    for (xmlNodePtr prop = lvl->children; prop; prop = prop->next) {
+                        if (tags.tagOf(prop) == OoxmlTag::NumberFormat) {
+                            levels[static_cast<size_t>(level)] = attributeValue(prop, "val");
+                        }
+                    }
+                }
+                break;
+            }
+            case OoxmlTag::Num:
+                for (xmlNodePtr child = node->children; child; child = child->next) {
+                    if (tags.tagOf(child) == OoxmlTag::AbstractNumId) {
+                        abstractIds[intAttributeValue(node, "numId", -1)] = intAttributeValue(child, "val", -1);
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    NumberingTable table;
+    table.formats_.reserve(abstractIds.size());
+    for (const auto& entry : abstractIds) {
+        auto it = abstractFormats.find(entry.second);
+        if (it != abstractFormats.end()) {
+            table.formats_[entry.first] = it->second;
+        }
+    }
+    return table;
+}
+
+const std::string* NumberingTable::format(int numId, int level) const {
+    auto it = formats_.find(numId);
+    if (it == formats_.end() || level < 0 || static_cast<size_t>(level) >= it->second.size()) {
+        return nullptr;
+    }
+    return &it->second[static_cast<size_t>(level)];
+}
+
+} // namespace detail
+} // namespace doc_converter
@@ -0,0 +1,95 @@
+/**
+ * @file style_table.hpp
+ * @brief styles.xml与numbering.xml的解析结果（内部头文件）
+ *
+ * 两张表都在加载时一次性构建、之后只读，可以被正文的多个解析线程同时查询：
+ * - StyleTable：段落样式ID到标题级别，basedOn继承链在构建时已展开
+ * - NumberingTable：编号ID和级别到编号格式
+ */
+
+#pragma once
+
+#include "ooxml_tags.hpp"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <libxml/tree.h>
+
+namespace doc_converter {
+namespace detail {
+
+/**
+ * @brief 从样式名称中识别标题级别
+ * @param name 样式名称或ID（如 "heading 1"、"Heading2"，不区分大小写）
+ * @return int 标题级别（1-9），不是标题样式时返回 0
+ */
+int headingLevelFromName(std::string_view name);
+
+/**
+ * @brief 段落样式表
+ */
+class StyleTable {
+public:
+    /**
+     * @brief 从styles.xml构建样式表
+     * @param doc styles.xml文档
+     * @param tags 元素标签表
+     * @return StyleTable 样式表
+     */
+    static StyleTable parse(xmlDocPtr doc, TagTable& tags);
+
+    /**
+     * @brief 判断样式表中是否定义了指定样式
+     * @param styleId 样式ID
+     * @return bool 是否定义
+     */
+    bool contains(const std::string& styleId) const { return levels_.count(styleId) != 0; }
+
+    /**
+     * @brief 获取样式对应的标题级别
+     * @param styleId 样式ID
+     * @return int 标题级别（1-9），非标题样式或未定义的样式返回 0
+     */
+    int headingLevel(const std::string& styleId) const {
+        auto it = levels_.find(styleId);
+        return it == levels_.end() ? 0 : it->second;
+    }
+
+    /**
+     * @brief 获取段落样式数量
+     * @return size_t 样式数量
+     */
+    size_t size() const { return levels_.size(); }
+
+private:
+    std::unordered_map<std::string, int> levels_;  ///< 样式ID到已展开的标题级别
+};
+
+/**
+ * @brief 编号定义表
+ */
+class NumberingTable {
+public:
+    /**
+     * @brief 从numbering.xml构建编号表
+     * @param doc numbering.xml文档
+     * @param tags 元素标签表
+     * @return NumberingTable 编号表
+     */
+    static NumberingTable parse(xmlDocPtr doc, TagTable& tags);
+
+    /**
+     * @brief 获取编号格式
+     * @param numId 编号ID（w:numId）
+     * @param level 列表级别（w:ilvl）
+     * @return const string* 编号格式（w:numFmt），未定义时返回 nullptr
+     */
+    const std::string* format(int numId, int level) const;
+
+private:
+    std::unordered_map<int, std::vector<std::string>> formats_;  ///< 编号ID到各级别的编号格式
+};
+
+} // namespace detail
+} // namespace doc_converter
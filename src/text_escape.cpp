@@ -0,0 +1,233 @@
+/**
+ * @file text_escape.cpp
+ * @brief 转换器输出文本的转义和编码
+ */
+
+#include "text_escape.hpp"
+#include <algorithm>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace doc_converter {
+namespace detail {
+
+namespace {
+
+/**
+ * @brief 需要转义的字符对应的实体，其他字符为空
+ */
+std::string_view htmlEntity(char c) {
+    switch (c) {
+        case '&': return "&amp;";
+        case '<': return "&lt;";
+        case '>': return "&gt;";
+        case '"': return "&quot;";
+        case '\'': return "&#39;";
+        default: return std::string_view();
+    }
+}
+
+bool isHtmlSpecial(char c) {
+    return c == '&' || c == '<' || c == '>' || c == '"' || c == '\'';
+}
+
+#if !defined(__SSE2__)
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighs = 0x8080808080808080ULL;
+
+/**
+ * @brief 机器字中是否有字节等于 c
+ */
+inline uint64_t hasByte(uint64_t word, unsigned char c) {
+    uint64_t x = word ^ (kOnes * c);
+    return (x - kOnes) & ~x & kHighs;
+}
+#endif
+
+/**
+ * @brief Markdown行内标记字符，以及标题和单元格中需要替换的换行
+ */
+const ByteScanner& markdownScanner(MarkdownContext context) {
+    static const ByteScanner inlineScanner("\\`*_~[]<>|&");
+    static const ByteScanner lineScanner("\\`*_~[]<>|&\r\n");
+    return context == MarkdownContext::Paragraph ? inlineScanner : lineScanner;
+}
+
+} // namespace
+
+ByteScanner::ByteScanner(std::string_view bytes) : bytes_(bytes.substr(0, kMaxBytes)) {
+    for (char c : bytes_) {
+        table_[static_cast<unsigned char>(c)] = true;
+    }
+}
+
+size_t ByteScanner::find(std::string_view text) const {
+    const char* p = text.data();
+    const size_t n = text.size();
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i targets[kMaxBytes];
+    const size_t count = bytes_.size();
+    for (size_t k = 0; k < count; ++k) {
+        targets[k] = _mm_set1_epi8(bytes_[k]);
+    }
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i hit = _mm_setzero_si128();
+        for (size_t k = 0; k < count; ++k) {
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, targets[k]));
+        }
+        int mask = _mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+#else
+    for (; i + 8 <= n; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, p + i, sizeof(word));
+        uint64_t hit = 0;
+        for (char c : bytes_) {
+            hit |= hasByte(word, static_cast<unsigned char>(c));
+        }
+        if (hit != 0) {
+            break;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (table_[static_cast<unsigned char>(p[i])]) {
+            return i;
+        }
+    }
+    return n;
+}
+
+size_t findHtmlSpecial(std::string_view text) {
+    const char* p = text.data();
+    const size_t n = text.size();
+    size_t i = 0;
+#if defined(__SSE2__)
+    // '<'(0x3C)与'>'(0x3E)、'&'(0x26)与'\''(0x27)各只差一位，置位后各用一次比较
+    const __m128i bit1 = _mm_set1_epi8(0x02);
+    const __m128i bit0 = _mm_set1_epi8(0x01);
+    const __m128i angle = _mm_set1_epi8('>');
+    const __m128i ampOrApos = _mm_set1_epi8('\'');
+    const __m128i quote = _mm_set1_epi8('"');
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(_mm_or_si128(v, bit1), angle),
+                         _mm_cmpeq_epi8(_mm_or_si128(v, bit0), ampOrApos)),
+            _mm_cmpeq_epi8(v, quote));
+        int mask = _mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+#else
+    for (; i + 8 <= n; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, p + i, sizeof(word));
+        if (hasByte(word, '&') | hasByte(word, '<') | hasByte(word, '>') |
+            hasByte(word, '"') | hasByte(word, '\'')) {
+            break;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (isHtmlSpecial(p[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+void escapeHtml(std::string_view text, OutputSink& out) {
+    while (!text.empty()) {
+        size_t pos = findHtmlSpecial(text);
+        out.write(text.substr(0, pos));
+        if (pos == text.size()) {
+            break;
+        }
+        out.write(htmlEntity(text[pos]));
+        text.remove_prefix(pos + 1);
+    }
+}
+
+void escapeMarkdown(std::string_view text, MarkdownContext context, OutputSink& out) {
+    const ByteScanner& scanner = markdownScanner(context);
+    while (!text.empty()) {
+        size_t pos = scanner.find(text);
+        out.write(text.substr(0, pos));
+        if (pos == text.size()) {
+            break;
+        }
+        char c = text[pos];
+        if (c == '\n') {
+            out << (context == MarkdownContext::TableCell ? "<br>" : " ");
+        } else if (c != '\r') {
+            out << '\\' << c;
+        }
+        text.remove_prefix(pos + 1);
+    }
+}
+
+bool escapeMarkdownBlockStart(std::string_view& text, OutputSink& out) {
+    text.remove_prefix(std::min(text.find_first_not_of(" \t"), text.size()));
+    if (text.empty()) {
+        return false;
+    }
+    char first = text.front();
+    if (first == '#' || first == '-' || first == '+' || first == '=') {
+        out << '\\' << first;
+        text.remove_prefix(1);
+        return true;
+    }
+    // 有序列表标记：数字后跟 '.' 或 ')'
+    size_t digits = 0;
+    while (digits < text.size() && digits < 10 && text[digits] >= '0' && text[digits] <= '9') {
+        ++digits;
+    }
+    if (digits > 0 && digits < text.size() && (text[digits] == '.' || text[digits] == ')')) {
+        out << text.substr(0, digits) << '\\' << text[digits];
+        text.remove_prefix(digits + 1);
+    }
+    return true;
+}
+
+void writeBase64(const uint8_t* data, size_t size, OutputSink& out) {
+    static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    // 每次编码 3 KiB 输入到栈上的缓冲区，整块写出
+    constexpr size_t kBlock = 3 * 1024;
+    char encoded[kBlock / 3 * 4];
+    while (size >= 3) {
+        size_t chunk = std::min(size - size % 3, kBlock);
+        char* o = encoded;
+        for (size_t i = 0; i < chunk; i += 3) {
+            uint32_t v = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+            o[0] = kAlphabet[v >> 18];
+            o[1] = kAlphabet[(v >> 12) & 0x3F];
+            o[2] = kAlphabet[(v >> 6) & 0x3F];
+            o[3] = kAlphabet[v & 0x3F];
+            o += 4;
+        }
+        out.write(std::string_view(encoded, static_cast<size_t>(o - encoded)));
+        data += chunk;
+        size -= chunk;
+    }
+    if (size > 0) {
+        uint32_t v = uint32_t(data[0]) << 16;
+        if (size == 2) {
+            v |= uint32_t(data[1]) << 8;
+        }
+        char tail[4] = {kAlphabet[v >> 18], kAlphabet[(v >> 12) & 0x3F],
+                        size == 2 ? kAlphabet[(v >> 6) & 0x3F] : '=', '='};
+        out.write(std::string_view(tail, 4));
+    }
+}
+
+} // namespace detail
+} // namespace doc_converter
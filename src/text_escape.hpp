@@ -0,0 +1,103 @@
+/**
+ * @file text_escape.hpp
+ * @brief 转换器输出文本的转义和编码（内部头文件）
+ *
+ * 转义是转换器的内层循环：先成块扫描找到下一个需要转义的字符，
+ * 中间不需要转义的片段整段写出，而不是逐个字符判断、逐个字符写出。
+ */
+
+#pragma once
+
+#include "doc_converter/output_sink.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace doc_converter {
+namespace detail {
+
+/**
+ * @brief 在文本中成块查找一组字节中任意一个的扫描器
+ */
+class ByteScanner {
+public:
+    static constexpr size_t kMaxBytes = 16;  ///< 最多查找的字节数
+
+    /**
+     * @brief 构造函数
+     * @param bytes 要查找的字节（最多 kMaxBytes 个）
+     */
+    explicit ByteScanner(std::string_view bytes);
+
+    /**
+     * @brief 查找第一个属于字节集合的字节
+     * @param text 文本
+     * @return size_t 字节位置，没有时返回 text.size()
+     *
+     * 支持SSE2时每次比较16个字节，否则每次按8个字节的机器字比较。
+     */
+    size_t find(std::string_view text) const;
+
+private:
+    std::string bytes_;      ///< 要查找的字节
+    bool table_[256] = {};   ///< 逐字节比较剩余部分用的查找表
+};
+
+/**
+ * @brief Markdown文本所在的位置
+ */
+enum class MarkdownContext {
+    Paragraph,  ///< 段落和列表项（换行原样保留）
+    Heading,    ///< 标题（换行替换为空格）
+    TableCell   ///< 表格单元格（换行替换为 <br>）
+};
+
+/**
+ * @brief 查找第一个需要HTML转义的字符（<、>、&、"、'）
+ * @param text 文本
+ * @return size_t 字符位置，没有时返回 text.size()
+ *
+ * 支持SSE2时每次比较16个字节，否则每次按8个字节的机器字比较。
+ */
+size_t findHtmlSpecial(std::string_view text);
+
+/**
+ * @brief 写出HTML转义后的文本（可用于元素内容和带引号的属性值）
+ * @param text 文本（UTF-8）
+ * @param out 输出层
+ */
+void escapeHtml(std::string_view text, OutputSink& out);
+
+/**
+ * @brief 写出Markdown转义后的文本
+ * @param text 文本（UTF-8）
+ * @param context 文本所在的位置
+ * @param out 输出层
+ *
+ * 转义强调、代码、链接、表格分隔等行内标记（\ ` * _ ~ [ ] < > | &），
+ * 标题和单元格中的换行按 context 替换，使其不会结束所在的块。
+ */
+void escapeMarkdown(std::string_view text, MarkdownContext context, OutputSink& out);
+
+/**
+ * @brief 写出块开头的文本，转义会被当作标题、列表等块标记的前缀（如 "#"、"-"、"1."）
+ * @param text 文本，返回时去掉开头的空白和已写出的前缀
+ * @param out 输出层
+ * @return bool 是否遇到了非空白字符；为 false 时块开头仍在后面的文本中
+ *
+ * 开头的空格和制表符不写出：行首缩进 4 列会变成代码块，少于 4 列时渲染器也会忽略，
+ * 并且会让后面的块标记绕过检查。剩余文本仍需经 escapeMarkdown() 写出。
+ */
+bool escapeMarkdownBlockStart(std::string_view& text, OutputSink& out);
+
+/**
+ * @brief 写出Base64编码的数据（用于data URI）
+ * @param data 数据
+ * @param size 字节数
+ * @param out 输出层
+ */
+void writeBase64(const uint8_t* data, size_t size, OutputSink& out);
+
+} // namespace detail
+} // namespace doc_converter
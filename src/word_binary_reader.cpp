@@ -0,0 +1,266 @@
+/**
+ * @file word_binary_reader.cpp
+ * @brief Word二进制文本提取器的实现
+ */
+
+#include "doc_converter/word_binary_reader.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace doc_converter {
+
+namespace {
+
+constexpr uint16_t kWordIdent = 0xA5EC;
+constexpr uint16_t kMinWord97Fib = 0x00C1;
+constexpr uint16_t kFlagEncrypted = 0x0100;
+constexpr uint16_t kFlagWhichTable = 0x0200;
+constexpr size_t kFcClxIndex = 33;  // FibRgFcLcb97中fcClx/lcbClx的序号
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+/**
+ * @brief cp1252中0x80-0x9F区间对应的Unicode码点（其余与Latin-1相同）
+ */
+constexpr char16_t kCp1252High[32] = {
+    0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+    0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178,
+};
+
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+/**
+ * @brief 把字符流组装成段落
+ *
+ * 处理段落边界、域代码嵌套以及UTF-16代理对。
+ */
+class ParagraphAssembler {
+public:
+    explicit ParagraphAssembler(std::vector<std::string>& out) : out_(out) {}
+
+    void put(char16_t c) {
+        // 代理对
+        if (c >= 0xD800 && c <= 0xDBFF) {
+            highSurrogate_ = c;
+            return;
+        }
+        uint32_t cp = c;
+        if (c >= 0xDC00 && c <= 0xDFFF) {
+            if (!highSurrogate_) {
+                return;
+            }
+            cp = 0x10000 + ((static_cast<uint32_t>(highSurrogate_) - 0xD800) << 10) + (c - 0xDC00);
+        }
+        highSurrogate_ = 0;
+
+        switch (cp) {
+            case 0x13:  // 域开始：先是域代码
+                fieldStack_.push_back(true);
+                ++codeFields_;
+                return;
+            case 0x14:  // 域分隔符：之后是域结果
+                if (!fieldStack_.empty() && fieldStack_.back()) {
+                    fieldStack_.back() = false;
+                    --codeFields_;
+                }
+                return;
+            case 0x15:  // 域结束
+                if (!fieldStack_.empty()) {
+                    codeFields_ -= fieldStack_.back() ? 1 : 0;
+                    fieldStack_.pop_back();
+                }
+                return;
+            default:
+                break;
+        }
+        // 任一层域处于域代码部分时，字符都不属于正文
+        if (codeFields_ > 0) {
+            return;
+        }
+
+        switch (cp) {
+            case 0x0D:  // 段落标记
+            case 0x07:  // 单元格/行结束标记
+            case 0x0C:  // 分页符/分节符
+                flush();
+                break;
+            case 0x0B:  // 手动换行
+                current_.push_back(' ');
+                break;
+            case 0x09:
+                current_.push_back('\t');
+                break;
+            case 0x1E:  // 不间断连字符
+                current_.push_back('-');
+                break;
+            default:
+                // 其余控制字符是图片、脚注引用等对象的占位符
+                if (cp >= 0x20) {
+                    appendUtf8(current_, cp);
+                }
+                break;
+        }
+    }
+
+    void flush() {
+        size_t begin = current_.find_first_not_of(" \t");
+        if (begin != std::string::npos) {
+            size_t end = current_.find_last_not_of(" \t");
+            out_.push_back(current_.substr(begin, end - begin + 1));
+        }
+        current_.clear();
+    }
+
+private:
+    std::vector<std::string>& out_;
+    std::string current_;
+    std::vector<bool> fieldStack_;  ///< 每层域是否处于域代码部分
+    size_t codeFields_ = 0;         ///< 处于域代码部分的层数
+    char16_t highSurrogate_ = 0;
+};
+
+} // namespace
+
+WordBinaryReader::WordBinaryReader(const CompoundFile& file)
+    : wordDocument_(file.readStream("WordDocument")) {
+    const std::vector<uint8_t>& wd = wordDocument_;
+    if (wd.size() < 0x22 || readU16(wd.data()) != kWordIdent) {
+        throw std::runtime_error("Not a Word binary document");
+    }
+    uint16_t nFib = readU16(wd.data() + 0x02);
+    uint16_t flags = readU16(wd.data() + 0x0A);
+    if (nFib < kMinWord97Fib) {
+        throw std::runtime_error("Word 95 and earlier documents are not supported");
+    }
+    if (flags & kFlagEncrypted) {
+        throw std::runtime_error("Encrypted Word documents are not supported");
+    }
+
+    // FIB：FibBase(32) + csw + fibRgW + cslw + fibRgLw + cbRgFcLcb + fibRgFcLcbBlob
+    size_t pos = 0x20;
+    uint16_t csw = readU16(wd.data() + pos);
+    pos += 2 + csw * 2;
+    if (pos + 2 > wd.size()) {
+        throw std::runtime_error("Truncated FIB");
+    }
+    uint16_t cslw = readU16(wd.data() + pos);
+    size_t fibRgLw = pos + 2;
+    pos = fibRgLw + cslw * 4;
+    if (cslw < 4 || pos + 2 > wd.size()) {
+        throw std::runtime_error("Truncated FIB");
+    }
+    ccpText_ = readU32(wd.data() + fibRgLw + 12);
+    uint16_t cbRgFcLcb = readU16(wd.data() + pos);
+    size_t fcLcb = pos + 2;
+    if (cbRgFcLcb <= kFcClxIndex || fcLcb + (kFcClxIndex + 1) * 8 > wd.size()) {
+        throw std::runtime_error("Truncated FIB");
+    }
+    uint32_t fcClx = readU32(wd.data() + fcLcb + kFcClxIndex * 8);
+    uint32_t lcbClx = readU32(wd.data() + fcLcb + kFcClxIndex * 8 + 4);
+
+    std::vector<uint8_t> table = file.readStream((flags & kFlagWhichTable) ? "1Table" : "0Table");
+    parsePieceTable(table, fcClx, lcbClx);
+}
+
+void WordBinaryReader::parsePieceTable(const std::vector<uint8_t>& table, uint32_t fcClx, uint32_t lcbClx) {
+    if (lcbClx == 0 || static_cast<uint64_t>(fcClx) + lcbClx > table.size()) {
+        throw std::runtime_error("Invalid CLX location");
+    }
+    const uint8_t* p = table.data() + fcClx;
+    const uint8_t* end = p + lcbClx;
+
+    // 跳过Prc（格式属性组），找到Pcdt
+    // 长度来自不可信的文件，按剩余字节数比较，指针不越过end
+    while (p < end && *p == 0x01) {
+        if (end - p < 3) {
+            throw std::runtime_error("Truncated CLX");
+        }
+        int16_t cbGrpprl = std::max<int16_t>(static_cast<int16_t>(readU16(p + 1)), 0);
+        if (cbGrpprl > end - p - 3) {
+            throw std::runtime_error("Truncated CLX");
+        }
+        p += 3 + cbGrpprl;
+    }
+    if (end - p < 5 || *p != 0x02) {
+        throw std::runtime_error("Piece table not found");
+    }
+    uint32_t lcb = readU32(p + 1);
+    const uint8_t* plc = p + 5;
+    if (lcb < 4 || lcb > static_cast<size_t>(end - plc) || (lcb - 4) % 12 != 0) {
+        throw std::runtime_error("Invalid piece table");
+    }
+
+    // PlcPcd：n+1个CP，随后n个8字节PCD
+    size_t count = (lcb - 4) / 12;
+    const uint8_t* pcds = plc + (count + 1) * 4;
+    pieces_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Piece piece;
+        piece.cpStart = readU32(plc + i * 4);
+        piece.cpEnd = readU32(plc + (i + 1) * 4);
+        uint32_t fc = readU32(pcds + i * 8 + 2);
+        piece.compressed = (fc & 0x40000000) != 0;
+        piece.offset = piece.compressed ? (fc & 0x3FFFFFFF) / 2 : fc;
+        if (piece.cpEnd < piece.cpStart) {
+            throw std::runtime_error("Invalid piece table entry");
+        }
+        pieces_.push_back(piece);
+    }
+}
+
+std::vector<std::string> WordBinaryReader::readParagraphs() const {
+    std::vector<std::string> paragraphs;
+    ParagraphAssembler assembler(paragraphs);
+
+    for (const Piece& piece : pieces_) {
+        if (piece.cpStart >= ccpText_) {
+            break;
+        }
+        // 只取正文部分（CP < ccpText），脚注、页眉等位于其后
+        uint32_t count = std::min(piece.cpEnd, ccpText_) - piece.cpStart;
+        uint64_t bytes = static_cast<uint64_t>(count) * (piece.compressed ? 1 : 2);
+        if (piece.offset + bytes > wordDocument_.size()) {
+            throw std::runtime_error("Piece text out of range");
+        }
+        const uint8_t* text = wordDocument_.data() + piece.offset;
+        if (piece.compressed) {
+            for (uint32_t i = 0; i < count; ++i) {
+                uint8_t b = text[i];
+                assembler.put(b >= 0x80 && b < 0xA0 ? kCp1252High[b - 0x80] : static_cast<char16_t>(b));
+            }
+        } else {
+            for (uint32_t i = 0; i < count; ++i) {
+                assembler.put(static_cast<char16_t>(readU16(text + i * 2)));
+            }
+        }
+    }
+    assembler.flush();
+    return paragraphs;
+}
+
+} // namespace doc_converter
@@ -7,16 +7,384 @@
 
 #include "doc_converter/word_document.hpp"
 #include "doc_converter/document_elements.hpp"
+#include "doc_converter/document_builder.hpp"
+#include "doc_converter/compound_file.hpp"
 #include "doc_converter/logger.hpp"
+#include "doc_converter/mapped_file.hpp"
+#include "doc_converter/word_binary_reader.hpp"
+#include "doc_converter/zip_archive.hpp"
+#include "antiword_extractor.hpp"
+#include "ooxml_tags.hpp"
+#include "style_table.hpp"
+#include "xml_block_scanner.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <future>
 #include <stdexcept>
-#include <fstream>
-#include <sstream>
+#include <thread>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <optional>
+#include <cctype>
 
 namespace doc_converter {
 
+namespace {
+
+/**
+ * @brief libxml2解析选项：禁止网络访问，允许超大文本节点
+ */
+constexpr int kXmlParseOptions = XML_PARSE_NONET | XML_PARSE_HUGE;
+
+/**
+ * @brief 每个正文块平均占用的document.xml字节数（偏小的估计，用于流式解析前预留元素容量）
+ */
+constexpr size_t kXmlBytesPerBlock = 1024;
+
+/**
+ * @brief libxml2为每字节XML建立的树大约占用的字节数（偏大的估计，用于加载前检查预算）
+ */
+constexpr size_t kDomBytesPerXmlByte = 4;
+
+/**
+ * @brief 并行解析时每个分块至少包含的正文块数
+ */
+constexpr size_t kMinBlocksPerChunk = 256;
+
+/**
+ * @brief 判断路径是否以指定扩展名结尾
+ */
+bool hasExtension(const std::string& path, const std::string& ext) {
+    return path.size() >= ext.size() &&
+           path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+/**
+ * @brief xmlReadIO读取回调：从ZIP条目中按需解压
+ */
+int readZipEntry(void* context, char* buffer, int len) {
+    try {
+        return static_cast<int>(static_cast<ZipEntryReader*>(context)->read(buffer, static_cast<size_t>(len)));
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("解压XML部件失败: " + std::string(e.what()));
+        return -1;
+    }
+}
+
+/**
+ * @brief 指向ZIP容器内某个部件的图片数据源
+ *
+ * 只持有归档的共享引用和部件名，调用 load() 时才解压数据。
+ */
+class ZipPartImageSource : public ImageSource {
+public:
+    ZipPartImageSource(std::shared_ptr<const ZipArchive> archive, const std::string& partName)
+        : archive_(std::move(archive)), partName_(partName) {}
+
+    std::vector<uint8_t> load() const override { return archive_->readEntry(partName_); }
+
+    size_t size() const override {
+        const ZipEntry* entry = archive_->findEntry(partName_);
+        return entry ? static_cast<size_t>(entry->uncompressedSize) : 0;
+    }
+
+private:
+    std::shared_ptr<const ZipArchive> archive_;  ///< 所属归档
+    std::string partName_;                       ///< 部件名
+};
+
+/**
+ * @brief 从容器中解压部件并直接送入libxml2解析
+ */
+xmlDocPtr parseZipXmlPart(const ZipArchive& archive, const std::string& partName) {
+    auto reader = archive.openEntry(partName);
+    xmlDocPtr doc = xmlReadIO(readZipEntry, nullptr, reader.get(),
+                              partName.c_str(), nullptr, kXmlParseOptions);
+    if (!doc) {
+        throw std::runtime_error("Failed to parse XML part: " + partName);
+    }
+    return doc;
+}
+
+/**
+ * @brief 解析样式表或编号表部件
+ * @return 解析结果；部件不存在或解析失败时返回空表，正文按样式名推断
+ */
+template <typename Table>
+std::shared_ptr<const Table> loadTablePart(std::shared_ptr<const ZipArchive> archive, std::string partName) {
+    if (archive->hasEntry(partName)) {
+        try {
+            xmlDocPtr doc = parseZipXmlPart(*archive, partName);
+            std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> guard(doc, xmlFreeDoc);
+            detail::TagTable tags;
+            return std::make_shared<const Table>(Table::parse(doc, tags));
+        } catch (const std::exception& e) {
+            Logger::getInstance().warn("Failed to parse " + partName + ": " + std::string(e.what()));
+        }
+    }
+    return std::make_shared<const Table>();
+}
+
+/**
+ * @brief 单独解析的一个部件或分块的结果
+ */
+struct PartResult {
+    std::vector<std::shared_ptr<DocumentElement>> elements;  ///< 元素（按文档顺序）
+    std::unique_ptr<TextArena> arena;                        ///< 文本存储区
+    std::shared_ptr<ElementArena> elementArena;              ///< 元素存储区
+};
+
+/**
+ * @brief 判断关系类型是否为页眉、页脚、脚注或尾注
+ */
+bool isAuxiliaryRelationship(std::string_view type) {
+    static constexpr std::string_view kTypes[] = {"/header", "/footer", "/footnotes", "/endnotes"};
+    for (std::string_view suffix : kTypes) {
+        if (type.size() >= suffix.size() && type.substr(type.size() - suffix.size()) == suffix) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 在子树中查找第一个指定标签的元素节点
+ */
+xmlNodePtr findDescendant(detail::TagTable& tags, xmlNodePtr node, detail::OoxmlTag tag) {
+    for (xmlNodePtr child = node->children; child; child = child->next) {
+        if (child->type != XML_ELEMENT_NODE) {
+            continue;
+        }
+        if (tags.tagOf(child) == tag) {
+            return child;
+        }
+        if (xmlNodePtr found = findDescendant(tags, child, tag)) {
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief 追加w:t元素内的文本节点
+ */
+void appendTextContent(xmlNodePtr textElement, std::string& out) {
+    for (xmlNodePtr child = textElement->children; child; child = child->next) {
+        if ((child->type == XML_TEXT_NODE || child->type == XML_CDATA_SECTION_NODE) && child->content) {
+            out += (const char*)child->content;
+        }
+    }
+}
+
+/**
+ * @brief 递归收集子树中的文本（w:t内容，w:tab转换为制表符）
+ */
+void collectText(detail::TagTable& tags, xmlNodePtr node, std::string& out) {
+    for (xmlNodePtr child = node->children; child; child = child->next) {
+        if (child->type != XML_ELEMENT_NODE) {
+            continue;
+        }
+        switch (tags.tagOf(child)) {
+            case detail::OoxmlTag::Text:
+                appendTextContent(child, out);
+                break;
+            case detail::OoxmlTag::Tab:
+                out += '\t';
+                break;
+            case detail::OoxmlTag::Deleted:
+            case detail::OoxmlTag::MoveFrom:
+                break;
+            default:
+                collectText(tags, child, out);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief 获取文本运行（w:r）的文本
+ * @param tags 标签表
+ * @param run w:r节点
+ * @param scratch 需要拼接时使用的缓冲区
+ * @return string_view 文本视图
+ *
+ * 常见的只含一个w:t文本节点的运行直接返回节点内容的视图，不做拷贝；
+ * 视图只在XML节点和scratch都未改变时有效。
+ */
+std::string_view runText(detail::TagTable& tags, xmlNodePtr run, std::string& scratch) {
+    xmlNodePtr single = nullptr;
+    size_t parts = 0;
+    bool simple = true;
+    for (xmlNodePtr child = run->children; child; child = child->next) {
+        switch (tags.tagOf(child)) {
+            case detail::OoxmlTag::Text:
+                ++parts;
+                single = child;
+                break;
+            case detail::OoxmlTag::Tab:
+            case detail::OoxmlTag::Break:
+            case detail::OoxmlTag::CarriageReturn:
+                simple = false;
+                break;
+            default:
+                break;
+        }
+    }
+    if (simple && parts == 1 && single->children && !single->children->next &&
+        single->children->type == XML_TEXT_NODE && single->children->content) {
+        return std::string_view((const char*)single->children->content);
+    }
+
+    scratch.clear();
+    for (xmlNodePtr child = run->children; child; child = child->next) {
+        switch (tags.tagOf(child)) {
+            case detail::OoxmlTag::Text:
+                appendTextContent(child, scratch);
+                break;
+            case detail::OoxmlTag::Tab:
+                scratch += '\t';
+                break;
+            case detail::OoxmlTag::Break:
+            case detail::OoxmlTag::CarriageReturn:
+                scratch += '\n';
+                break;
+            default:
+                break;
+        }
+    }
+    return scratch;
+}
+
+/**
+ * @brief 统计指定标签的直接子元素数（用于预留容量）
+ */
+size_t countChildren(detail::TagTable& tags, xmlNodePtr node, detail::OoxmlTag tag) {
+    size_t count = 0;
+    for (xmlNodePtr child = node->children; child; child = child->next) {
+        if (tags.tagOf(child) == tag) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 遍历段落中的文本运行，包括超链接、修订插入等容器内的运行
+ */
+template <typename Visitor>
+void forEachRun(detail::TagTable& tags, xmlNodePtr node, Visitor&& visit) {
+    for (xmlNodePtr child = node->children; child; child = child->next) {
+        if (child->type != XML_ELEMENT_NODE) {
+            continue;
+        }
+        switch (tags.tagOf(child)) {
+            case detail::OoxmlTag::Run:
+                visit(child);
+                break;
+            case detail::OoxmlTag::ParagraphProperties:
+            case detail::OoxmlTag::Deleted:
+            case detail::OoxmlTag::MoveFrom:
+                break;
+            default:
+                forEachRun(tags, child, visit);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief 在文本运行中查找w:drawing
+ */
+template <typename Visitor>
+void forEachDrawing(detail::TagTable& tags, xmlNodePtr run, Visitor&& visit) {
+    for (xmlNodePtr child = run->children; child; child = child->next) {
+        if (tags.tagOf(child) == detail::OoxmlTag::Drawing) {
+            visit(child);
+        }
+    }
+}
+
+/**
+ * @brief 将相对于源部件所在目录的关系目标解析为部件名
+ */
+std::string resolvePartName(const std::string& baseDirectory, const std::string& target) {
+    if (!target.empty() && target[0] == '/') {
+        return target.substr(1);
+    }
+    std::string base = baseDirectory;
+    std::string rest = target;
+    while (rest.compare(0, 3, "../") == 0) {
+        base = base.substr(0, base.find_last_of('/') == std::string::npos ? 0 : base.find_last_of('/'));
+        rest = rest.substr(3);
+    }
+    return base.empty() ? rest : base + "/" + rest;
+}
+
+} // namespace
+
+struct WordDocument::ParseContext {
+    explicit ParseContext(std::vector<std::shared_ptr<DocumentElement>>& output) : builder(output) {}
+
+    DocumentBuilder builder;  ///< 按文档顺序输出解析出的元素，并按存储方式创建元素
+    TextArena* arena = nullptr;  ///< 文本存储区，为空时文本元素持有副本
+    std::vector<std::unique_ptr<TextArena>>* chunkArenas = nullptr;  ///< 接收并行分块的存储区
+    std::vector<std::shared_ptr<ElementArena>>* chunkElementArenas = nullptr;  ///< 接收并行分块的元素存储区
+    std::shared_ptr<StringPool> stringPool;  ///< 文本驻留池，设置时优先于文本存储区
+    std::shared_ptr<ImageStore> imageStore;  ///< 图片数据去重使用的存储
+    std::string scratch;  ///< 拼接多段文本时复用的缓冲区
+    detail::TagTable tags;  ///< 元素标签表
+    const RelationshipMap* relationships = nullptr;  ///< 当前部件的关系
+    std::shared_future<std::shared_ptr<const detail::StyleTable>> styles;  ///< 与正文并行解析的样式表
+    std::shared_future<std::shared_ptr<const detail::NumberingTable>> numbering;  ///< 与正文并行解析的编号表
+
+    /**
+     * @brief 为单独解析的部件或分块创建存储区
+     * @param result 接收存储区的解析结果
+     * @param useTextArena 是否使用文本存储区
+     * @param useElementArena 是否使用元素存储区（文本随之写入其中）
+     */
+    void attachStorage(PartResult& result, bool useTextArena, bool useElementArena) {
+        if (useElementArena) {
+            result.elementArena = std::make_shared<ElementArena>();
+            // 元素中驻留的文本指向池，池与元素同生命周期
+            result.elementArena->retain(stringPool);
+            builder.setArena(result.elementArena.get());
+            arena = &result.elementArena->text();
+        } else if (useTextArena) {
+            result.arena = std::make_unique<TextArena>();
+            arena = result.arena.get();
+        }
+    }
+
+    /**
+     * @brief 获取样式表，第一次调用时等待其解析完成
+     * @return 样式表，没有styles.xml（如扁平XML）时返回 nullptr
+     */
+    const detail::StyleTable* styleTable() {
+        if (!styleTable_ && styles.valid()) {
+            styleTable_ = styles.get().get();
+        }
+        return styleTable_;
+    }
+
+    /**
+     * @brief 获取编号表，第一次调用时等待其解析完成
+     * @return 编号表，没有numbering.xml时返回 nullptr
+     */
+    const detail::NumberingTable* numberingTable() {
+        if (!numberingTable_ && numbering.valid()) {
+            numberingTable_ = numbering.get().get();
+        }
+        return numberingTable_;
+    }
+
+private:
+    const detail::StyleTable* styleTable_ = nullptr;
+    const detail::NumberingTable* numberingTable_ = nullptr;
+};
+
 WordDocument::WordDocument(const std::string& title) {
     title_ = title;
 }
@@ -34,45 +402,38 @@ bool WordDocument::loadFromFile(const std::string& filePath) {
         // 保存文件路径
         docxPath_ = filePath;
 
-        // 根据文件扩展名选择解析方法
-        if (filePath.length() >= 4 && 
-            filePath.substr(filePath.length() - 4) == ".docx") {
-            // 使用现有的.docx解析代码
-            std::ifstream file(filePath, std::ios::binary);
-            if (!file.is_open()) {
-                throw std::runtime_error("Failed to open file: " + filePath);
-            }
-
-            // 读取文件内容
-            std::vector<char> buffer(std::istreambuf_iterator<char>(file), {});
-            file.close();
-
-            // 解析XML文档
-            xmlDocPtr doc = xmlReadMemory(buffer.data(), buffer.size(), nullptr, nullptr, 0);
-            if (!doc) {
-                throw std::runtime_error("Failed to parse XML document");
-            }
-
-            // 解析文档内容
-            parseDocument(doc);
+        // 设置了预算时，从已有的占用开始计入新元素
+        std::unique_ptr<MemoryBudget> budget;
+        if (memoryBudget_ > 0) {
+            budget = std::make_unique<MemoryBudget>(memoryBudget_, getMemoryUsage().total());
+        }
+        budget_ = budget.get();
 
-            // 清理XML文档
-            xmlFreeDoc(doc);
-        } else if (filePath.length() >= 3 && 
-                   filePath.substr(filePath.length() - 3) == ".doc") {
-            // 使用antiword解析.doc文件
+        // 根据文件扩展名选择解析方法
+        if (hasExtension(filePath, ".docx")) {
+            loadDocx(filePath);
+        } else if (hasExtension(filePath, ".doc")) {
             parseDocDocument(filePath);
         } else {
             throw std::runtime_error("Unsupported file format: " + filePath);
         }
 
+        budget_ = nullptr;
         return true;
     } catch (const std::exception& e) {
+        budget_ = nullptr;
         Logger::getInstance().error("Failed to load document: " + std::string(e.what()));
         return false;
     }
 }
 
+bool WordDocument::streamFromFile(const std::string& filePath, ElementQueue& queue) {
+    queue_ = &queue;
+    bool loaded = loadFromFile(filePath);
+    queue_ = nullptr;
+    return loaded;
+}
+
 std::string WordDocument::getTitle() const {
     return title_;
 }
@@ -81,11 +442,282 @@ const std::vector<std::shared_ptr<DocumentElement>>& WordDocument::getElements()
     return elements_;
 }
 
+MemoryUsage WordDocument::getMemoryUsage() const {
+    MemoryUsage usage = Document::getMemoryUsage();
+    for (const auto& entry : auxiliaryElements_) {
+        for (const auto& element : entry.second) {
+            if (element) {
+                element->addMemoryUsage(usage);
+            }
+        }
+        usage.containerBytes += MemoryUsage::heapBytes(entry.second);
+    }
+    // 元素对象已按元素计入，存储区只计文本
+    for (const auto& arena : textArenas_) {
+        usage.containerBytes += arena->bytesStored();
+    }
+    for (const auto& arena : elementArenas_) {
+        usage.containerBytes += arena->text().bytesStored();
+    }
+    if (stringPool_) {
+        usage.containerBytes += stringPool_->bytesStored();
+    }
+    return usage;
+}
+
 void WordDocument::addElement(std::shared_ptr<DocumentElement> element) {
-    elements_.push_back(element);
+    elements_.push_back(std::move(element));
+}
+
+std::vector<std::string> WordDocument::getAuxiliaryParts() const {
+    std::vector<std::string> parts;
+    parts.reserve(auxiliaryElements_.size());
+    for (const auto& entry : auxiliaryElements_) {
+        parts.push_back(entry.first);
+    }
+    return parts;
+}
+
+const std::vector<std::shared_ptr<DocumentElement>>& WordDocument::getAuxiliaryElements(
+    const std::string& partName) const {
+    static const std::vector<std::shared_ptr<DocumentElement>> empty;
+    auto it = auxiliaryElements_.find(partName);
+    return it == auxiliaryElements_.end() ? empty : it->second;
+}
+
+bool WordDocument::hasPart(const std::string& partName) const {
+    return archive_ && archive_->hasEntry(partName);
+}
+
+std::vector<uint8_t> WordDocument::readPart(const std::string& partName) const {
+    if (!archive_) {
+        throw std::runtime_error("No .docx container is open");
+    }
+    return archive_->readEntry(partName);
+}
+
+xmlDocPtr WordDocument::parseXmlPart(const std::string& partName) const {
+    return parseZipXmlPart(*archive_, partName);
+}
+
+WordDocument::RelationshipMap WordDocument::loadRelationships(const std::string& partName,
+                                                              std::vector<std::string>* auxiliaryParts) const {
+    // word/document.xml的关系位于word/_rels/document.xml.rels
+    size_t slash = partName.find_last_of('/');
+    std::string directory = slash == std::string::npos ? std::string() : partName.substr(0, slash);
+    std::string fileName = slash == std::string::npos ? partName : partName.substr(slash + 1);
+    const std::string relsPart = (directory.empty() ? "" : directory + "/") + "_rels/" + fileName + ".rels";
+
+    RelationshipMap relationships;
+    if (!archive_->hasEntry(relsPart)) {
+        return relationships;
+    }
+
+    xmlDocPtr rels = parseXmlPart(relsPart);
+    std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> guard(rels, xmlFreeDoc);
+    xmlNodePtr root = xmlDocGetRootElement(rels);
+    for (xmlNodePtr node = root ? root->children : nullptr; node; node = node->next) {
+        if (node->type != XML_ELEMENT_NODE ||
+            xmlStrcmp(node->name, (const xmlChar*)"Relationship") != 0) {
+            continue;
+        }
+        xmlChar* id = xmlGetProp(node, (const xmlChar*)"Id");
+        xmlChar* target = xmlGetProp(node, (const xmlChar*)"Target");
+        xmlChar* mode = xmlGetProp(node, (const xmlChar*)"TargetMode");
+        xmlChar* type = xmlGetProp(node, (const xmlChar*)"Type");
+        // 外部链接不在容器内
+        if (id && target && !(mode && xmlStrcmp(mode, (const xmlChar*)"External") == 0)) {
+            std::string part = resolvePartName(directory, (const char*)target);
+            if (auxiliaryParts && type && isAuxiliaryRelationship((const char*)type) &&
+                archive_->hasEntry(part)) {
+                auxiliaryParts->push_back(part);
+            }
+            relationships[(const char*)id] = std::move(part);
+        }
+        xmlFree(id);
+        xmlFree(target);
+        xmlFree(mode);
+        xmlFree(type);
+    }
+    Logger::getInstance().debug(partName + ": 加载了 " + std::to_string(relationships.size()) + " 个关系");
+    return relationships;
+}
+
+void WordDocument::loadDocx(const std::string& filePath) {
+    // 直接在映射的字节上解析，不经过iostream拷贝；
+    // ZIP容器先读尾部的中央目录，再跳到各本地头和延迟加载的媒体部件，按随机访问映射
+    MappedFile file(filePath, MappedFile::Access::Random);
+
+    // OPC容器：只解压word/document.xml，边解压边解析；否则按扁平XML处理（允许XML声明前有空白）
+    const char* flatData = nullptr;
+    int flatSize = 0;
+    relationships_.clear();
+    auxiliaryElements_.clear();
+    std::vector<std::string> auxiliaryParts;
+    if (ZipArchive::isZipData(file.data(), file.size())) {
+        archive_ = std::make_shared<ZipArchive>(std::move(file));
+        relationships_ = loadRelationships("word/document.xml", &auxiliaryParts);
+    } else {
+        archive_.reset();
+        std::string_view xml = file.view();
+        size_t start = std::min(xml.find_first_not_of(" \t\r\n"), xml.size());
+        if (xml.size() - start > static_cast<size_t>(INT_MAX)) {
+            throw std::runtime_error("XML document too large: " + filePath);
+        }
+        flatData = xml.data() + start;
+        flatSize = static_cast<int>(xml.size() - start);
+    }
+
+    // 正文解析期间的临时占用在解析结束、XML树释放前一直计入预算，与新元素一起受限：
+    // DOM模式建立完整的XML树，并行模式另需解压后的正文和各分块的副本，流式解析只占用固定窗口
+    std::optional<MemoryBudget::Reservation> transient;
+    if (budget_ && parseMode_ != ParseMode::Streaming) {
+        size_t xmlSize = archive_ ? static_cast<size_t>(archive_->openEntry("word/document.xml")->size())
+                                  : static_cast<size_t>(flatSize);
+        size_t factor = kDomBytesPerXmlByte + (parseMode_ == ParseMode::Parallel ? 2 : 0);
+        transient.emplace(*budget_, xmlSize > SIZE_MAX / factor ? SIZE_MAX : xmlSize * factor);
+    }
+
+    ParseContext ctx{elements_};
+    ctx.builder.setQueue(queue_);
+    ctx.builder.setBudget(budget_);
+    ctx.relationships = &relationships_;
+    ctx.stringPool = stringPool_;
+    // 未共享图片存储时至少在文档内去重
+    ctx.imageStore = imageStore_ ? imageStore_ : std::make_shared<ImageStore>();
+    const bool useElementArena = elementStorage_ == ElementStorage::Arena;
+    const bool useArena = textStorage_ == TextStorage::Arena;
+    if (useElementArena) {
+        elementArenas_.push_back(std::make_shared<ElementArena>());
+        elementArenas_.back()->retain(stringPool_);
+        ctx.builder.setArena(elementArenas_.back().get());
+        ctx.arena = &elementArenas_.back()->text();
+        ctx.chunkElementArenas = &elementArenas_;
+    } else if (useArena) {
+        textArenas_.push_back(std::make_unique<TextArena>());
+        ctx.arena = textArenas_.back().get();
+        ctx.chunkArenas = &textArenas_;
+    }
+
+    // 样式表、编号表以及页眉、页脚、脚注和尾注与正文并行解析；
+    // 正文在第一个需要样式的段落处才等待样式表
+    std::vector<std::pair<std::string, std::future<PartResult>>> auxiliary;
+    if (archive_) {
+        // libxml2要求在多线程使用前先在主线程初始化
+        xmlInitParser();
+        std::shared_ptr<const ZipArchive> archive = archive_;
+        ctx.styles = std::async(std::launch::async, loadTablePart<detail::StyleTable>,
+                                archive, std::string("word/styles.xml")).share();
+        ctx.numbering = std::async(std::launch::async, loadTablePart<detail::NumberingTable>,
+                                   archive, std::string("word/numbering.xml")).share();
+
+        auxiliary.reserve(auxiliaryParts.size());
+        for (const std::string& part : auxiliaryParts) {
+            auto styles = ctx.styles;
+            auto numbering = ctx.numbering;
+            auto stringPool = ctx.stringPool;
+            auto imageStore = ctx.imageStore;
+            MemoryBudget* budget = budget_;
+            auxiliary.emplace_back(part, std::async(std::launch::async, [this, part, styles, numbering, useArena,
+                                                                    useElementArena, stringPool, imageStore,
+                                                                    budget] {
+                PartResult result;
+                RelationshipMap relationships = loadRelationships(part);
+                ParseContext partCtx{result.elements};
+                partCtx.builder.setBudget(budget);
+                partCtx.relationships = &relationships;
+                partCtx.styles = styles;
+                partCtx.numbering = numbering;
+                partCtx.stringPool = stringPool;
+                partCtx.imageStore = imageStore;
+                partCtx.attachStorage(result, useArena, useElementArena);
+                parseAuxiliaryPart(part, partCtx);
+                return result;
+            }));
+        }
+    }
+
+    if (parseMode_ == ParseMode::Streaming) {
+        std::unique_ptr<ZipEntryReader> entry;
+        xmlTextReaderPtr reader = nullptr;
+        if (archive_) {
+            entry = archive_->openEntry("word/document.xml");
+            ctx.builder.reserve(static_cast<size_t>(entry->size()) / kXmlBytesPerBlock);
+            reader = xmlReaderForIO(readZipEntry, nullptr, entry.get(),
+                                    "word/document.xml", nullptr, kXmlParseOptions);
+        } else {
+            ctx.builder.reserve(static_cast<size_t>(flatSize) / kXmlBytesPerBlock);
+            reader = xmlReaderForMemory(flatData, flatSize, nullptr, nullptr, kXmlParseOptions);
+        }
+        if (!reader) {
+            throw std::runtime_error("Failed to create XML reader");
+        }
+        std::unique_ptr<xmlTextReader, decltype(&xmlFreeTextReader)> guard(reader, xmlFreeTextReader);
+        parseDocumentStream(reader, ctx);
+    } else if (parseMode_ == ParseMode::Parallel) {
+        // 切分需要完整的document.xml
+        if (archive_) {
+            std::vector<uint8_t> xml = archive_->readEntry("word/document.xml");
+            parseDocumentParallel(reinterpret_cast<const char*>(xml.data()), xml.size(), ctx);
+        } else {
+            parseDocumentParallel(flatData, static_cast<size_t>(flatSize), ctx);
+        }
+    } else {
+        xmlDocPtr doc = archive_ ? parseXmlPart("word/document.xml")
+                                 : xmlReadMemory(flatData, flatSize, nullptr, nullptr, kXmlParseOptions);
+        if (!doc) {
+            throw std::runtime_error("Failed to parse XML document");
+        }
+        std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> guard(doc, xmlFreeDoc);
+        parseDocument(doc, ctx);
+    }
+    ctx.builder.flush();
+    transient.reset();
+
+    // 附属部件解析失败不影响正文
+    for (auto& entry : auxiliary) {
+        try {
+            PartResult result = entry.second.get();
+            if (result.arena) {
+                textArenas_.push_back(std::move(result.arena));
+            }
+            if (result.elementArena) {
+                elementArenas_.push_back(std::move(result.elementArena));
+            }
+            auxiliaryElements_[entry.first] = std::move(result.elements);
+        } catch (const MemoryBudgetExceeded&) {
+            throw;
+        } catch (const std::exception& e) {
+            Logger::getInstance().warn("Failed to parse " + entry.first + ": " + std::string(e.what()));
+        }
+    }
+}
+
+void WordDocument::parseAuxiliaryPart(const std::string& partName, ParseContext& ctx) const {
+    xmlDocPtr doc = parseXmlPart(partName);
+    std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> guard(doc, xmlFreeDoc);
+    xmlNodePtr root = xmlDocGetRootElement(doc);
+
+    // 页眉（w:hdr）和页脚（w:ftr）直接包含段落和表格；脚注和尾注多一层w:footnote/w:endnote
+    for (xmlNodePtr node = root ? root->children : nullptr; node; node = node->next) {
+        detail::OoxmlTag tag = ctx.tags.tagOf(node);
+        if (tag != detail::OoxmlTag::Footnote && tag != detail::OoxmlTag::Endnote) {
+            parseBodyNode(node, ctx);
+            continue;
+        }
+        // 分隔线等特殊注释不含用户内容
+        std::string type = detail::attributeValue(node, "type");
+        if (!type.empty() && type != "normal") {
+            continue;
+        }
+        for (xmlNodePtr child = node->children; child; child = child->next) {
+            parseBodyNode(child, ctx);
+        }
+    }
+    Logger::getInstance().debug("解析了 " + partName + " 中的 " + std::to_string(ctx.builder.size()) + " 个元素");
 }
 
-void WordDocument::parseDocument(xmlDocPtr xmlDoc) {
+void WordDocument::parseDocument(xmlDocPtr xmlDoc, ParseContext& ctx) const {
     Logger::getInstance().debug("开始解析文档");
     xmlNodePtr root = xmlDocGetRootElement(xmlDoc);
     if (!root) {
@@ -93,170 +725,408 @@ void WordDocument::parseDocument(xmlDocPtr xmlDoc) {
         return;
     }
 
-    // 遍历文档节点
+    // 正文位于w:document/w:body之下
+    xmlNodePtr body = root;
     for (xmlNodePtr node = root->children; node; node = node->next) {
+        if (ctx.tags.tagOf(node) == detail::OoxmlTag::Body) {
+            body = node;
+            break;
+        }
+    }
+
+    // 遍历文档节点；每个正文块最多产生一个元素（内嵌图片除外）
+    ctx.builder.reserve(xmlChildElementCount(body));
+    for (xmlNodePtr node = body->children; node; node = node->next) {
         if (node->type == XML_ELEMENT_NODE) {
-            if (xmlStrcmp(node->name, (const xmlChar*)"p") == 0) {
-                parseParagraph(node);
-            } else if (xmlStrcmp(node->name, (const xmlChar*)"tbl") == 0) {
-                parseTable(node);
-            } else if (xmlStrcmp(node->name, (const xmlChar*)"drawing") == 0) {
-                parseImage(node);
-            }
+            parseBodyNode(node, ctx);
         }
     }
     Logger::getInstance().debug("文档解析完成");
 }
 
-void WordDocument::parseParagraph(xmlNodePtr node) {
-    // 检查段落样式，判断是否为标题
-    xmlChar* style = xmlGetProp(node, (const xmlChar*)"style");
-    if (style && xmlStrstr(style, (const xmlChar*)"Heading")) {
-        // 获取标题级别
-        const char* levelStr = (const char*)xmlStrstr(style, (const xmlChar*)" ") + 1;
-        int level = std::atoi(levelStr);
-        xmlFree(style);
+void WordDocument::parseDocumentStream(xmlTextReaderPtr reader, ParseContext& ctx) const {
+    Logger::getInstance().debug("开始流式解析文档");
 
-        // 创建标题元素
-        auto heading = std::make_shared<HeadingElement>(
-            getNodeText(node),
-            level
-        );
-        addElement(heading);
-        Logger::getInstance().debug("添加标题元素: " + heading->getText() + " (级别: " + std::to_string(level) + ")");
-    } else {
-        // 创建段落元素
-        auto paragraph = std::make_shared<ParagraphElement>();
-        std::string paragraphText;
+    // 根元素深度为0；出现w:body后正文块位于深度2
+    int blockDepth = 1;
+    int ret = xmlTextReaderRead(reader);
+    while (ret == 1) {
+        if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
+            ret = xmlTextReaderRead(reader);
+            continue;
+        }
 
-        // 遍历段落中的文本
-        for (xmlNodePtr child = node->children; child; child = child->next) {
-            if (child->type == XML_TEXT_NODE && child->content) {
-                std::string text = std::string((const char*)child->content);
-                paragraphText += text;
-                paragraph->addText(text);
+        int depth = xmlTextReaderDepth(reader);
+        if (depth == 1 && xmlStrcmp(xmlTextReaderConstLocalName(reader), (const xmlChar*)"body") == 0 &&
+            detail::namespaceFromUri(xmlTextReaderConstNamespaceUri(reader)) ==
+                detail::OoxmlNamespace::Wordprocessing) {
+            blockDepth = 2;
+            ret = xmlTextReaderRead(reader);
+        } else if (depth == blockDepth) {
+            // 读到块的结束标签为止，转换后跳过整个子树，reader随即释放这些节点
+            xmlNodePtr node = xmlTextReaderExpand(reader);
+            if (!node) {
+                ret = -1;
+                break;
             }
+            parseBodyNode(node, ctx);
+            ctx.tags.forgetNamespaces();
+            ret = xmlTextReaderNext(reader);
+        } else {
+            ret = xmlTextReaderRead(reader);
         }
+    }
 
-        // 如果段落不为空，添加到文档
-        if (!paragraph->getTexts().empty()) {
-            addElement(paragraph);
-            Logger::getInstance().debug("添加段落元素: " + paragraphText);
-        }
+    if (ret != 0) {
+        throw std::runtime_error("Failed to parse XML document");
     }
+    Logger::getInstance().debug("流式解析完成");
 }
 
-std::string WordDocument::getNodeText(xmlNodePtr node) {
-    std::string text;
-    xmlChar* content = xmlNodeGetContent(node);
-    if (content) {
-        text = (const char*)content;
-        xmlFree(content);
+void WordDocument::parseDocumentParallel(const char* data, size_t size, ParseContext& ctx) const {
+    std::string_view xml(data, size);
+    detail::XmlBodyLayout layout;
+    unsigned threads = parseThreads_ ? parseThreads_ : std::thread::hardware_concurrency();
+    size_t blockCount = 0;
+    if (threads > 1 && detail::scanBodyLayout(xml, layout)) {
+        blockCount = layout.blockOffsets.size() - 1;
     }
-    return text;
-}
 
-void WordDocument::parseDocDocument(const std::string& filePath) {
-    // 使用antiword命令解析.doc文件
-    std::string cmd = "antiword -t " + filePath;
-    FILE* pipe = popen(cmd.c_str(), "r");
-    if (!pipe) {
-        throw std::runtime_error("Failed to execute antiword command");
+    // 块数不足以分给两个以上的线程时，顺序解析更快
+    size_t chunkCount = std::min<size_t>(threads, blockCount / kMinBlocksPerChunk);
+    if (chunkCount < 2) {
+        // xmlReadMemory的长度参数是int；分块解析时只要求每个分块不超过INT_MAX
+        if (size > static_cast<size_t>(INT_MAX)) {
+            throw std::runtime_error("XML document too large: " + std::to_string(size) + " bytes");
+        }
+        xmlDocPtr doc = xmlReadMemory(data, static_cast<int>(size), nullptr, nullptr, kXmlParseOptions);
+        if (!doc) {
+            throw std::runtime_error("Failed to parse XML document");
+        }
+        std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> guard(doc, xmlFreeDoc);
+        parseDocument(doc, ctx);
+        return;
     }
 
-    // 读取antiword的输出
-    std::string output;
-    char buffer[4096];
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-        output += buffer;
+    // 按字节数把正文块均分成chunkCount个连续区间
+    const std::vector<size_t>& offsets = layout.blockOffsets;
+    const size_t target = (offsets.back() - offsets.front()) / chunkCount;
+    std::vector<std::pair<size_t, size_t>> ranges;
+    size_t first = 0;
+    for (size_t i = 1; i < blockCount && ranges.size() + 1 < chunkCount; ++i) {
+        if (offsets[i] - offsets[first] >= target) {
+            ranges.emplace_back(first, i);
+            first = i;
+        }
     }
+    ranges.emplace_back(first, blockCount);
+    Logger::getInstance().debug("并行解析 " + std::to_string(blockCount) + " 个正文块，分为 " +
+                                std::to_string(ranges.size()) + " 个分块");
+
+    // libxml2要求在多线程使用前先在主线程初始化
+    xmlInitParser();
+
+    // 每个分块输出自己的元素列表和文本存储区
+    const bool useElementArena = ctx.builder.arena() != nullptr;
+    const bool useArena = !useElementArena && ctx.arena != nullptr;
+    const RelationshipMap* relationships = ctx.relationships;
+    auto styles = ctx.styles;
+    auto numbering = ctx.numbering;
+    auto stringPool = ctx.stringPool;
+    auto imageStore = ctx.imageStore;
+    MemoryBudget* budget = budget_;
+    std::vector<std::future<PartResult>> futures;
+    futures.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        futures.push_back(std::async(std::launch::async, [this, &layout, &offsets, xml, range, useArena, useElementArena,
+                                                          relationships, styles, numbering, stringPool,
+                                                          imageStore, budget] {
+            std::string_view blocks = xml.substr(offsets[range.first],
+                                                 offsets[range.second] - offsets[range.first]);
+            // 补上根元素和w:body标签，使分块成为带完整命名空间声明的独立文档
+            std::string chunk;
+            chunk.reserve(layout.rootStartTag.size() + layout.bodyStartTag.size() + blocks.size() +
+                          layout.bodyName.size() + layout.rootName.size() + 6);
+            chunk.append(layout.rootStartTag).append(layout.bodyStartTag).append(blocks);
+            chunk.append("</").append(layout.bodyName).append("></").append(layout.rootName).append(">");
 
-    // 关闭管道
-    int status = pclose(pipe);
-    if (status != 0) {
-        throw std::runtime_error("antiword command failed");
+            if (chunk.size() > static_cast<size_t>(INT_MAX)) {
+                throw std::runtime_error("XML document too large: chunk of " + std::to_string(chunk.size()) +
+                                         " bytes");
+            }
+            xmlDocPtr doc = xmlReadMemory(chunk.data(), static_cast<int>(chunk.size()),
+                                          nullptr, "UTF-8", kXmlParseOptions);
+            if (!doc) {
+                throw std::runtime_error("Failed to parse XML document chunk");
+            }
+            std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> guard(doc, xmlFreeDoc);
+
+            PartResult result;
+            ParseContext chunkCtx{result.elements};
+            chunkCtx.builder.setBudget(budget);
+            chunkCtx.relationships = relationships;
+            chunkCtx.styles = styles;
+            chunkCtx.numbering = numbering;
+            chunkCtx.stringPool = stringPool;
+            chunkCtx.imageStore = imageStore;
+            chunkCtx.attachStorage(result, useArena, useElementArena);
+            parseDocument(doc, chunkCtx);
+            return result;
+        }));
     }
 
-    // 从输出中提取文本内容
-    extractTextFromAntiwordOutput(output);
+    // 按文档顺序合并：每个分块完成后立即输出，不必等待后面的分块；
+    // 任一分块失败时等待其余分块结束后抛出其异常
+    // 每个正文块最多输出一个元素；分块的元素在解析时已计入预算
+    ctx.builder.reserve(blockCount);
+    ctx.builder.setBudget(nullptr);
+    std::exception_ptr failure;
+    for (auto& future : futures) {
+        PartResult part;
+        try {
+            part = future.get();
+        } catch (...) {
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            continue;
+        }
+        if (failure) {
+            continue;
+        }
+        for (auto& element : part.elements) {
+            ctx.builder.emit(std::move(element));
+        }
+        if (part.arena && ctx.chunkArenas) {
+            ctx.chunkArenas->push_back(std::move(part.arena));
+        }
+        if (part.elementArena && ctx.chunkElementArenas) {
+            ctx.chunkElementArenas->push_back(std::move(part.elementArena));
+        }
+    }
+    ctx.builder.setBudget(budget);
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
 }
 
-void WordDocument::extractTextFromAntiwordOutput(const std::string& output) {
-    // 将输出按行分割
-    std::istringstream stream(output);
-    std::string line;
-    std::string currentParagraph;
+void WordDocument::parseBodyNode(xmlNodePtr node, ParseContext& ctx) const {
+    switch (ctx.tags.tagOf(node)) {
+        case detail::OoxmlTag::Paragraph:
+            parseParagraph(node, ctx);
+            break;
+        case detail::OoxmlTag::Table:
+            parseTable(node, ctx);
+            break;
+        case detail::OoxmlTag::Drawing:
+            parseImage(node, ctx);
+            break;
+        default:
+            break;
+    }
+}
 
-    while (std::getline(stream, line)) {
-        // 跳过空行
-        if (line.empty()) {
-            if (!currentParagraph.empty()) {
-                // 创建段落元素
-                auto paragraph = std::make_shared<ParagraphElement>();
-                paragraph->addText(currentParagraph);
-                elements_.push_back(paragraph);
-                currentParagraph.clear();
-            }
+void WordDocument::parseParagraph(xmlNodePtr node, ParseContext& ctx) const {
+    // 段落属性：样式、直接设置的大纲级别和编号
+    std::string styleId;
+    int outlineLevel = -1;
+    int numId = 0;
+    int listLevel = 0;
+    for (xmlNodePtr child = node->children; child; child = child->next) {
+        if (ctx.tags.tagOf(child) != detail::OoxmlTag::ParagraphProperties) {
             continue;
         }
+        for (xmlNodePtr prop = child->children; prop; prop = prop->next) {
+            switch (ctx.tags.tagOf(prop)) {
+                case detail::OoxmlTag::ParagraphStyle:
+                    styleId = detail::attributeValue(prop, "val");
+                    break;
+                case detail::OoxmlTag::OutlineLevel:
+                    outlineLevel = detail::intAttributeValue(prop, "val", 9);
+                    break;
+                case detail::OoxmlTag::NumberingProperties:
+                    for (xmlNodePtr num = prop->children; num; num = num->next) {
+                        switch (ctx.tags.tagOf(num)) {
+                            case detail::OoxmlTag::IndentLevel:
+                                listLevel = detail::intAttributeValue(num, "val", 0);
+                                break;
+                            case detail::OoxmlTag::NumberingId:
+                                numId = detail::intAttributeValue(num, "val", 0);
+                                break;
+                            default:
+                                break;
+                        }
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        break;
+    }
+
+    // 标题级别：直接设置的大纲级别（9 表示正文）优先，其次是段落样式（含basedOn继承）
+    int level = 0;
+    if (outlineLevel >= 0) {
+        level = outlineLevel < 9 ? outlineLevel + 1 : 0;
+    } else if (!styleId.empty()) {
+        const detail::StyleTable* styles = ctx.styleTable();
+        level = styles && styles->contains(styleId) ? styles->headingLevel(styleId)
+                                                    : detail::headingLevelFromName(styleId);
+    } else {
+        // 兼容段落上的style属性（如 style="Heading 2"），没有级别时按1级处理
+        xmlChar* style = xmlGetProp(node, (const xmlChar*)"style");
+        if (const xmlChar* heading = style ? xmlStrstr(style, (const xmlChar*)"Heading") : nullptr) {
+            level = std::max(1, detail::headingLevelFromName((const char*)heading));
+        }
+        xmlFree(style);
+    }
+
+    if (level > 0) {
+        // 创建标题元素
+        auto heading = ctx.builder.make<HeadingElement>(
+            getNodeText(node, ctx),
+            level
+        );
+        Logger::getInstance().debug("添加标题元素: " + heading->getText() + " (级别: " + std::to_string(level) + ")");
+        ctx.builder.emit(std::move(heading));
 
-        // 如果是新段落（以特定格式开头）
-        if (line[0] == ' ' || line[0] == '\t') {
-            if (!currentParagraph.empty()) {
-                // 创建段落元素
-                auto paragraph = std::make_shared<ParagraphElement>();
-                paragraph->addText(currentParagraph);
-                elements_.push_back(paragraph);
-                currentParagraph.clear();
+        forEachRun(ctx.tags, node, [&](xmlNodePtr run) {
+            forEachDrawing(ctx.tags, run, [&](xmlNodePtr drawing) { parseImage(drawing, ctx); });
+        });
+    } else {
+        // 创建段落元素，每个w:r一个文本运行
+        auto paragraph = ctx.builder.make<ParagraphElement>();
+        std::vector<xmlNodePtr> drawings;
+        forEachRun(ctx.tags, node, [&](xmlNodePtr run) {
+            std::string_view text = runText(ctx.tags, run, ctx.scratch);
+            if (!text.empty()) {
+                if (ctx.stringPool) {
+                    paragraph->addTextView(ctx.stringPool->intern(text));
+                } else if (ctx.arena) {
+                    paragraph->addTextView(ctx.arena->store(text));
+                } else {
+                    paragraph->addText(std::string(text));
+                }
             }
-            // 移除开头的空白字符
-            line = line.substr(line.find_first_not_of(" \t"));
+            forEachDrawing(ctx.tags, run, [&](xmlNodePtr drawing) { drawings.push_back(drawing); });
+        });
+
+        // w:numId为0表示取消样式带来的编号
+        if (numId > 0) {
+            const detail::NumberingTable* numbering = ctx.numberingTable();
+            const std::string* format = numbering ? numbering->format(numId, listLevel) : nullptr;
+            paragraph->setListInfo(listLevel, format ? *format : std::string());
+        }
+
+        // 如果段落不为空，添加到文档
+        if (!paragraph->getTexts().empty()) {
+            Logger::getInstance().debug("添加段落元素: " + std::to_string(paragraph->getTexts().size()) + " 个文本运行");
+            ctx.builder.emit(std::move(paragraph));
         }
 
-        // 将当前行添加到段落中
-        if (!currentParagraph.empty()) {
-            currentParagraph += " ";
+        // 段落中的内嵌图片（w:r/w:drawing）
+        for (xmlNodePtr drawing : drawings) {
+            parseImage(drawing, ctx);
         }
-        currentParagraph += line;
     }
+}
+
+std::string WordDocument::getNodeText(xmlNodePtr node, ParseContext& ctx) const {
+    // 只收集w:t中的文本，忽略格式元素之间的空白、删除的修订和域代码（w:instrText）
+    std::string text;
+    collectText(ctx.tags, node, text);
+    return text;
+}
+
+void WordDocument::parseDocDocument(const std::string& filePath) {
+    // 优先在进程内读取CFB容器和片段表
+    try {
+        CompoundFile file(filePath);
+        WordBinaryReader reader(file);
+        std::vector<std::string> paragraphs = reader.readParagraphs();
 
-    // 处理最后一个段落
-    if (!currentParagraph.empty()) {
-        auto paragraph = std::make_shared<ParagraphElement>();
-        paragraph->addText(currentParagraph);
-        elements_.push_back(paragraph);
+        DocumentBuilder builder(elements_);
+        builder.setQueue(queue_);
+        builder.setBudget(budget_);
+        builder.reserve(paragraphs.size());
+        for (const std::string& text : paragraphs) {
+            builder.emit(makeParagraph(text));
+        }
+        Logger::getInstance().debug("从.doc文件中提取了 " + std::to_string(paragraphs.size()) + " 个段落");
+        return;
+    } catch (const StreamCancelled&) {
+        throw;
+    } catch (const MemoryBudgetExceeded&) {
+        throw;
+    } catch (const std::exception& e) {
+        // 加密、Word 95等不支持的格式交给antiword处理
+        Logger::getInstance().warn("Native .doc parsing failed, falling back to antiword: " +
+                                   std::string(e.what()));
     }
+    parseDocWithAntiword(filePath);
+}
+
+void WordDocument::parseDocWithAntiword(const std::string& filePath) {
+    // 段落随antiword的输出逐个生成，不保留完整输出
+    size_t count = 0;
+    DocumentBuilder builder(elements_);
+    builder.setQueue(queue_);
+    builder.setBudget(budget_);
+    detail::AntiwordOutputSplitter splitter([this, &builder, &count](std::string&& text) {
+        builder.emit(makeParagraph(text));
+        ++count;
+    });
+    detail::runAntiword(filePath, splitter);
 
-    Logger::getInstance().debug("从antiword输出中提取了 " + std::to_string(elements_.size()) + " 个段落");
+    Logger::getInstance().debug("从antiword输出中提取了 " + std::to_string(count) + " 个段落");
 }
 
-void WordDocument::parseTable(xmlNodePtr node) {
+std::shared_ptr<ParagraphElement> WordDocument::makeParagraph(std::string_view text) {
+    ElementArena* arena = nullptr;
+    if (elementStorage_ == ElementStorage::Arena) {
+        if (elementArenas_.empty()) {
+            elementArenas_.push_back(std::make_shared<ElementArena>());
+            elementArenas_.back()->retain(stringPool_);
+        }
+        arena = elementArenas_.back().get();
+    }
+    auto paragraph = arena ? arena->make<ParagraphElement>() : std::make_shared<ParagraphElement>();
+    if (stringPool_) {
+        paragraph->addTextView(stringPool_->intern(text));
+    } else if (arena) {
+        paragraph->addTextView(arena->text().store(text));
+    } else {
+        paragraph->addText(std::string(text));
+    }
+    return paragraph;
+}
+
+void WordDocument::parseTable(xmlNodePtr node, ParseContext& ctx) const {
     Logger::getInstance().debug("开始解析表格");
-    auto table = std::make_shared<TableElement>();
+    auto table = ctx.builder.make<TableElement>();
+    table->reserveRows(countChildren(ctx.tags, node, detail::OoxmlTag::TableRow));
 
     // 遍历表格行
     for (xmlNodePtr rowNode = node->children; rowNode; rowNode = rowNode->next) {
-        if (rowNode->type == XML_ELEMENT_NODE && 
-            xmlStrcmp(rowNode->name, (const xmlChar*)"tr") == 0) {
-            TableRow row = parseTableRow(rowNode);
-            table->addRow(row);
+        if (ctx.tags.tagOf(rowNode) == detail::OoxmlTag::TableRow) {
+            table->addRow(parseTableRow(rowNode, ctx));
         }
     }
 
-    addElement(table);
+    ctx.builder.emit(std::move(table));
     Logger::getInstance().debug("表格解析完成");
 }
 
-TableRow WordDocument::parseTableRow(xmlNodePtr node) {
+TableRow WordDocument::parseTableRow(xmlNodePtr node, ParseContext& ctx) const {
     TableRow row;
     Logger::getInstance().debug("开始解析表格行");
+    row.reserveCells(countChildren(ctx.tags, node, detail::OoxmlTag::TableCell));
 
     // 遍历单元格
     for (xmlNodePtr cellNode = node->children; cellNode; cellNode = cellNode->next) {
-        if (cellNode->type == XML_ELEMENT_NODE && 
-            xmlStrcmp(cellNode->name, (const xmlChar*)"tc") == 0) {
-            TableCell cell = parseTableCell(cellNode);
-            row.addCell(cell);
+        if (ctx.tags.tagOf(cellNode) == detail::OoxmlTag::TableCell) {
+            row.addCell(parseTableCell(cellNode, ctx));
         }
     }
 
@@ -264,16 +1134,15 @@ TableRow WordDocument::parseTableRow(xmlNodePtr node) {
     return row;
 }
 
-TableCell WordDocument::parseTableCell(xmlNodePtr node) {
+TableCell WordDocument::parseTableCell(xmlNodePtr node, ParseContext& ctx) const {
     Logger::getInstance().debug("开始解析表格单元格");
     std::string cellText;
 
     // 遍历单元格内容
     for (xmlNodePtr contentNode = node->children; contentNode; contentNode = contentNode->next) {
-        if (contentNode->type == XML_ELEMENT_NODE && 
-            xmlStrcmp(contentNode->name, (const xmlChar*)"p") == 0) {
+        if (ctx.tags.tagOf(contentNode) == detail::OoxmlTag::Paragraph) {
             // 获取段落文本
-            std::string paragraphText = getNodeText(contentNode);
+            std::string paragraphText = getNodeText(contentNode, ctx);
             if (!cellText.empty()) {
                 cellText += "\n";
             }
@@ -282,106 +1151,81 @@ TableCell WordDocument::parseTableCell(xmlNodePtr node) {
     }
 
     Logger::getInstance().debug("表格单元格解析完成: " + cellText);
-    return TableCell(cellText);
+    if (ctx.stringPool) {
+        return TableCell(ctx.stringPool->intern(cellText), TextViewTag{});
+    }
+    return TableCell(std::move(cellText));
 }
 
-void WordDocument::parseImage(xmlNodePtr node) {
+void WordDocument::parseImage(xmlNodePtr node, ParseContext& ctx) const {
     Logger::getInstance().debug("开始解析图片");
-    
-    // 查找图片ID
-    xmlNodePtr blipNode = nullptr;
-    for (xmlNodePtr child = node->children; child; child = child->next) {
-        if (child->type == XML_ELEMENT_NODE && 
-            xmlStrcmp(child->name, (const xmlChar*)"blip") == 0) {
-            blipNode = child;
-            break;
-        }
-    }
 
+    // 查找图片引用（w:drawing/wp:inline/a:graphic/.../a:blip）
+    xmlNodePtr blipNode = findDescendant(ctx.tags, node, detail::OoxmlTag::Blip);
     if (!blipNode) {
         Logger::getInstance().error("未找到图片节点");
         return;
     }
 
-    // 获取图片ID
+    // 获取图片关系ID（r:embed）
     xmlChar* imageId = xmlGetProp(blipNode, (const xmlChar*)"embed");
     if (!imageId) {
         Logger::getInstance().error("未找到图片ID");
         return;
     }
+    std::string partName = resolvePart(ctx, (const char*)imageId);
+    xmlFree(imageId);
+    if (partName.empty()) {
+        Logger::getInstance().error("无法定位图片数据");
+        return;
+    }
 
-    // 获取图片格式
+    // 图片格式取自部件扩展名；输出图片文件时会用作文件名后缀，
+    // 部件名来自不可信的容器，只接受1-8个小写字母或数字
     std::string format = "png";  // 默认格式
-    xmlNodePtr formatNode = nullptr;
-    for (xmlNodePtr child = node->children; child; child = child->next) {
-        if (child->type == XML_ELEMENT_NODE && 
-            xmlStrcmp(child->name, (const xmlChar*)"ext") == 0) {
-            xmlChar* ext = xmlGetProp(child, (const xmlChar*)"uri");
-            if (ext) {
-                std::string uri = (const char*)ext;
-                if (uri == "http://schemas.openxmlformats.org/drawingml/2006/wordprocessingDrawing") {
-                    format = "png";
-                } else if (uri == "http://schemas.openxmlformats.org/drawingml/2006/jpeg") {
-                    format = "jpg";
-                }
-                xmlFree(ext);
-            }
-            break;
+    size_t dot = partName.find_last_of('.');
+    if (dot != std::string::npos) {
+        format = partName.substr(dot + 1);
+        for (auto& c : format) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        if (!ImageStore::isSafeFormat(format)) {
+            format = "bin";
+        } else if (format == "jpeg") {
+            format = "jpg";
         }
     }
 
     // 获取图片尺寸
     int width = 0, height = 0;
-    for (xmlNodePtr child = node->children; child; child = child->next) {
-        if (child->type == XML_ELEMENT_NODE && 
-            xmlStrcmp(child->name, (const xmlChar*)"extent") == 0) {
-            xmlChar* cx = xmlGetProp(child, (const xmlChar*)"cx");
-            xmlChar* cy = xmlGetProp(child, (const xmlChar*)"cy");
-            if (cx && cy) {
-                // 转换EMU到像素（1 EMU = 1/9525 像素）
-                width = std::atoi((const char*)cx) / 9525;
-                height = std::atoi((const char*)cy) / 9525;
-                xmlFree(cx);
-                xmlFree(cy);
-            }
-            break;
+    if (xmlNodePtr extent = findDescendant(ctx.tags, node, detail::OoxmlTag::Extent)) {
+        xmlChar* cx = xmlGetProp(extent, (const xmlChar*)"cx");
+        xmlChar* cy = xmlGetProp(extent, (const xmlChar*)"cy");
+        if (cx && cy) {
+            // 转换EMU到像素（1 像素 = 9525 EMU）
+            width = static_cast<int>(std::atoll((const char*)cx) / 9525);
+            height = static_cast<int>(std::atoll((const char*)cy) / 9525);
         }
+        xmlFree(cx);
+        xmlFree(cy);
     }
 
-    // 提取图片数据
-    std::vector<uint8_t> imageData = extractImageData((const char*)imageId, format);
-    xmlFree(imageId);
-
-    if (!imageData.empty()) {
-        // 创建图片元素
-        auto image = std::make_shared<ImageElement>(imageData, format, width, height);
-        addElement(image);
-        Logger::getInstance().debug("添加图片元素: " + std::to_string(width) + "x" + std::to_string(height));
-    } else {
-        Logger::getInstance().error("无法提取图片数据");
-    }
+    // 图片数据在转换器请求时才从容器中解压
+    auto source = std::make_shared<ZipPartImageSource>(archive_, partName);
+    ctx.builder.emit(ctx.builder.make<ImageElement>(std::move(source), format, width, height, ctx.imageStore));
+    Logger::getInstance().debug("添加图片元素: " + std::to_string(width) + "x" + std::to_string(height));
 }
 
-std::vector<uint8_t> WordDocument::extractImageData(const std::string& imageId, const std::string& format) {
-    // 构建图片文件路径
-    std::string imagePath = docxPath_.substr(0, docxPath_.find_last_of("/") + 1) + 
-                           "word/media/image" + imageId + "." + format;
-
-    // 读取图片文件
-    std::ifstream file(imagePath, std::ios::binary);
-    if (!file.is_open()) {
-        Logger::getInstance().error("无法打开图片文件: " + imagePath);
-        return std::vector<uint8_t>();
+std::string WordDocument::resolvePart(const ParseContext& ctx, const std::string& relationshipId) const {
+    if (!archive_ || !ctx.relationships) {
+        return std::string();
     }
-
-    // 读取图片数据
-    std::vector<uint8_t> data(
-        (std::istreambuf_iterator<char>(file)),
-        std::istreambuf_iterator<char>()
-    );
-    file.close();
-
-    return data;
+    auto it = ctx.relationships->find(relationshipId);
+    if (it == ctx.relationships->end() || !archive_->hasEntry(it->second)) {
+        Logger::getInstance().error("无法找到关系对应的部件: " + relationshipId);
+        return std::string();
+    }
+    return it->second;
 }
 
-} // namespace doc_converter 
\ No newline at end of file
+} // namespace doc_converter
@@ -0,0 +1,142 @@
+/**
+ * @file xml_block_scanner.cpp
+ * @brief document.xml正文块边界扫描的实现
+ */
+
+#include "xml_block_scanner.hpp"
+
+namespace doc_converter {
+namespace detail {
+
+namespace {
+
+constexpr size_t npos = std::string_view::npos;
+
+/**
+ * @brief 跳过到终止串之后
+ * @return size_t 终止串之后的位置，找不到时返回npos
+ */
+size_t skipPast(std::string_view xml, size_t pos, std::string_view terminator) {
+    size_t found = xml.find(terminator, pos);
+    return found == npos ? npos : found + terminator.size();
+}
+
+/**
+ * @brief 查找标签结尾的'>'，跳过引号中的属性值
+ */
+size_t findTagEnd(std::string_view xml, size_t pos) {
+    char quote = 0;
+    for (; pos < xml.size(); ++pos) {
+        char c = xml[pos];
+        if (quote) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '>') {
+            return pos;
+        }
+    }
+    return npos;
+}
+
+/**
+ * @brief 取出'<'或'</'之后的限定名
+ */
+std::string_view tagName(std::string_view xml, size_t lt) {
+    size_t begin = lt + 1;
+    if (begin < xml.size() && xml[begin] == '/') {
+        ++begin;
+    }
+    size_t end = begin;
+    while (end < xml.size()) {
+        char c = xml[end];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '>' || c == '/') {
+            break;
+        }
+        ++end;
+    }
+    return xml.substr(begin, end - begin);
+}
+
+std::string_view localName(std::string_view qname) {
+    size_t colon = qname.find(':');
+    return colon == npos ? qname : qname.substr(colon + 1);
+}
+
+} // namespace
+
+bool scanBodyLayout(std::string_view xml, XmlBodyLayout& layout) {
+    layout = XmlBodyLayout();
+    int depth = 0;       // 当前打开的元素数
+    bool inBody = false;
+    size_t pos = 0;
+
+    while (true) {
+        size_t lt = xml.find('<', pos);
+        if (lt == npos || lt + 1 >= xml.size()) {
+            return false;
+        }
+
+        // 注释、CDATA、处理指令、DOCTYPE
+        if (xml.compare(lt, 4, "<!--") == 0) {
+            pos = skipPast(xml, lt + 4, "-->");
+        } else if (xml.compare(lt, 9, "<![CDATA[") == 0) {
+            pos = skipPast(xml, lt + 9, "]]>");
+        } else if (xml[lt + 1] == '?') {
+            pos = skipPast(xml, lt + 2, "?>");
+        } else if (xml[lt + 1] == '!') {
+            if (depth > 0) {
+                return false;
+            }
+            size_t gt = findTagEnd(xml, lt + 2);
+            pos = gt == npos ? npos : gt + 1;
+        } else {
+            size_t gt = findTagEnd(xml, lt + 1);
+            if (gt == npos) {
+                return false;
+            }
+            std::string_view name = tagName(xml, lt);
+            if (xml[lt + 1] == '/') {
+                if (inBody && depth == 2) {
+                    // w:body结束，作为最后一个块的结束位置
+                    layout.blockOffsets.push_back(lt);
+                    return true;
+                }
+                if (--depth < 0) {
+                    return false;
+                }
+            } else {
+                bool selfClosing = xml[gt - 1] == '/';
+                if (depth == 0) {
+                    if (selfClosing) {
+                        return false;
+                    }
+                    layout.rootStartTag = xml.substr(lt, gt - lt + 1);
+                    layout.rootName = name;
+                } else if (depth == 1 && !inBody && localName(name) == "body") {
+                    if (selfClosing) {
+                        return false;
+                    }
+                    layout.bodyStartTag = xml.substr(lt, gt - lt + 1);
+                    layout.bodyName = name;
+                    inBody = true;
+                } else if (inBody && depth == 2) {
+                    layout.blockOffsets.push_back(lt);
+                }
+                if (!selfClosing) {
+                    ++depth;
+                }
+            }
+            pos = gt + 1;
+        }
+
+        if (pos == npos) {
+            return false;
+        }
+    }
+}
+
+} // namespace detail
+} // namespace doc_converter
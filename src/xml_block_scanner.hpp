@@ -0,0 +1,38 @@
+/**
+ * @file xml_block_scanner.hpp
+ * @brief document.xml正文块边界扫描（内部头文件）
+ *
+ * 不构建DOM，只识别根元素、w:body以及w:body的直接子元素的起始位置，
+ * 用于把正文切分成可以独立解析的分块。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace doc_converter {
+namespace detail {
+
+/**
+ * @brief document.xml的正文布局
+ */
+struct XmlBodyLayout {
+    std::string_view rootStartTag;     ///< 根元素开始标签（含命名空间声明）
+    std::string_view rootName;         ///< 根元素限定名（如 "w:document"）
+    std::string_view bodyStartTag;     ///< w:body开始标签
+    std::string_view bodyName;         ///< w:body限定名
+    std::vector<size_t> blockOffsets;  ///< 每个正文块的起始偏移，最后一项为w:body结束标签的偏移
+};
+
+/**
+ * @brief 扫描正文块边界
+ * @param xml document.xml的完整内容（UTF-8）
+ * @param layout 输出的正文布局
+ * @return bool 是否成功识别出w:body及其子元素
+ */
+bool scanBodyLayout(std::string_view xml, XmlBodyLayout& layout);
+
+} // namespace detail
+} // namespace doc_converter
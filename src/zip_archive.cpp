@@ -0,0 +1,331 @@
+/**
+ * @file zip_archive.cpp
+ * @brief OPC/ZIP 容器读取器的实现
+ */
+
+#include "doc_converter/zip_archive.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace doc_converter {
+
+namespace {
+
+constexpr uint32_t kLocalHeaderSignature = 0x04034b50;
+constexpr uint32_t kCentralHeaderSignature = 0x02014b50;
+constexpr uint32_t kEndOfCentralDirSignature = 0x06054b50;
+constexpr uint32_t kZip64EndOfCentralDirSignature = 0x06064b50;
+constexpr uint32_t kZip64LocatorSignature = 0x07064b50;
+constexpr uint16_t kZip64ExtraFieldId = 0x0001;
+constexpr size_t kEndOfCentralDirSize = 22;
+constexpr size_t kCentralHeaderSize = 46;
+constexpr size_t kLocalHeaderSize = 30;
+
+/**
+ * @brief deflate 的最大压缩比（每个长度为 258 的匹配最少占 2 bit）及小条目的余量
+ */
+constexpr uint64_t kMaxDeflateRatio = 1032;
+constexpr uint64_t kDeflateSizeSlack = 1024;
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readU64(const uint8_t* p) {
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+/**
+ * @brief 规范化部件名：去掉前导 '/'
+ */
+std::string normalizePartName(const std::string& name) {
+    size_t start = 0;
+    while (start < name.size() && name[start] == '/') {
+        ++start;
+    }
+    return name.substr(start);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ZipEntryReader
+// ---------------------------------------------------------------------------
+
+ZipEntryReader::ZipEntryReader(const ZipArchive& archive, const ZipEntry& entry)
+    : entry_(entry)
+    , input_(archive.entryData(entry)) {
+    // 解压大小来自不可信的文件头，调用方按它分配缓冲区，超出压缩方法可能达到的大小时拒绝
+    const uint64_t maxInflated = entry_.compressedSize > (UINT64_MAX - kDeflateSizeSlack) / kMaxDeflateRatio
+        ? UINT64_MAX
+        : entry_.compressedSize * kMaxDeflateRatio + kDeflateSizeSlack;
+    const bool plausible = entry_.method == 0 ? entry_.uncompressedSize == entry_.compressedSize
+                                              : entry_.uncompressedSize <= maxInflated;
+    if (!plausible) {
+        throw std::runtime_error("Implausible uncompressed size for " + entry_.name);
+    }
+    if (entry_.method == 8) {
+        // 原始 deflate 流（无 zlib 头）
+        if (inflateInit2(&stream_, -MAX_WBITS) != Z_OK) {
+            throw std::runtime_error("Failed to initialize inflater for " + entry_.name);
+        }
+        inflating_ = true;
+    } else if (entry_.method != 0) {
+        throw std::runtime_error("Unsupported compression method " +
+                                 std::to_string(entry_.method) + " for " + entry_.name);
+    }
+}
+
+ZipEntryReader::~ZipEntryReader() {
+    if (inflating_) {
+        inflateEnd(&stream_);
+    }
+}
+
+size_t ZipEntryReader::read(char* buffer, size_t size) {
+    if (finished_ || size == 0) {
+        return 0;
+    }
+
+    // zlib 的 avail_in/avail_out 是 uInt，单次最多处理 1GB，超过 4GB 的条目分段读取
+    constexpr uint64_t kMaxChunk = 1u << 30;
+    size = static_cast<size_t>(std::min<uint64_t>(size, kMaxChunk));
+
+    size_t produced = 0;
+    if (entry_.method == 0) {
+        uint64_t remaining = entry_.compressedSize - consumed_;
+        produced = static_cast<size_t>(std::min<uint64_t>(remaining, size));
+        std::memcpy(buffer, input_ + consumed_, produced);
+        consumed_ += produced;
+        if (consumed_ == entry_.compressedSize) {
+            finished_ = true;
+        }
+    } else {
+        stream_.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream_.avail_out = static_cast<uInt>(size);
+        while (stream_.avail_out > 0 && !finished_) {
+            if (stream_.avail_in == 0) {
+                uint64_t remaining = entry_.compressedSize - consumed_;
+                uInt chunk = static_cast<uInt>(std::min(remaining, kMaxChunk));
+                stream_.next_in = const_cast<Bytef*>(input_ + consumed_);
+                stream_.avail_in = chunk;
+                consumed_ += chunk;
+            }
+            int ret = inflate(&stream_, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END) {
+                finished_ = true;
+            } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                throw std::runtime_error("Corrupt deflate data in " + entry_.name);
+            } else if (stream_.avail_in == 0 && stream_.avail_out > 0 &&
+                       consumed_ == entry_.compressedSize) {
+                throw std::runtime_error("Truncated deflate data in " + entry_.name);
+            }
+        }
+        produced = static_cast<size_t>(reinterpret_cast<char*>(stream_.next_out) - buffer);
+    }
+
+    crc_ = static_cast<uint32_t>(::crc32(crc_, reinterpret_cast<const Bytef*>(buffer),
+                                         static_cast<uInt>(produced)));
+    produced_ += produced;
+    if (finished_) {
+        if (produced_ != entry_.uncompressedSize || crc_ != entry_.crc32) {
+            throw std::runtime_error("CRC mismatch in " + entry_.name);
+        }
+    }
+    return produced;
+}
+
+// ---------------------------------------------------------------------------
+// ZipArchive
+// ---------------------------------------------------------------------------
+
+ZipArchive::ZipArchive(const std::string& filePath) : data_(filePath, MappedFile::Access::Random) {
+    parseCentralDirectory();
+}
+
+ZipArchive::ZipArchive(std::vector<uint8_t> data) : data_(std::move(data)) {
+    parseCentralDirectory();
+}
+
+ZipArchive::ZipArchive(MappedFile file) : data_(std::move(file)) {
+    parseCentralDirectory();
+}
+
+bool ZipArchive::isZipData(const void* data, size_t size) {
+    return size >= 4 && readU32(static_cast<const uint8_t*>(data)) == kLocalHeaderSignature;
+}
+
+void ZipArchive::parseCentralDirectory() {
+    const uint8_t* base = data_.data();
+    const size_t size = data_.size();
+    if (size < kEndOfCentralDirSize) {
+        throw std::runtime_error("Not a ZIP archive: file too small");
+    }
+
+    // 从文件尾部向前查找中央目录结束记录（注释最长 65535 字节）
+    size_t eocd = std::string::npos;
+    size_t lowest = size > kEndOfCentralDirSize + 0xFFFF ? size - kEndOfCentralDirSize - 0xFFFF : 0;
+    for (size_t pos = size - kEndOfCentralDirSize + 1; pos-- > lowest;) {
+        if (readU32(base + pos) == kEndOfCentralDirSignature) {
+            eocd = pos;
+            break;
+        }
+    }
+    if (eocd == std::string::npos) {
+        throw std::runtime_error("Not a ZIP archive: end of central directory not found");
+    }
+
+    uint64_t entryCount = readU16(base + eocd + 10);
+    uint64_t cdSize = readU32(base + eocd + 12);
+    uint64_t cdOffset = readU32(base + eocd + 16);
+
+    // ZIP64：字段溢出时从 ZIP64 结束记录中读取
+    if ((entryCount == 0xFFFF || cdSize == 0xFFFFFFFF || cdOffset == 0xFFFFFFFF) &&
+        eocd >= 20 && readU32(base + eocd - 20) == kZip64LocatorSignature) {
+        uint64_t eocd64 = readU64(base + eocd - 20 + 8);
+        // 偏移量来自不可信的定位记录，按剩余长度比较以免相加溢出；ZIP64 结束记录必须位于定位记录之前
+        if (eocd64 > eocd - 20 || eocd - 20 - eocd64 < 56 ||
+            readU32(base + eocd64) != kZip64EndOfCentralDirSignature) {
+            throw std::runtime_error("Corrupt ZIP64 end of central directory");
+        }
+        entryCount = readU64(base + eocd64 + 32);
+        cdSize = readU64(base + eocd64 + 40);
+        cdOffset = readU64(base + eocd64 + 48);
+    }
+
+    if (cdOffset > size || cdSize > size - cdOffset) {
+        throw std::runtime_error("Corrupt ZIP central directory");
+    }
+
+    entries_.reserve(static_cast<size_t>(std::min<uint64_t>(entryCount, cdSize / kCentralHeaderSize)));
+    index_.reserve(entries_.capacity());
+
+    const uint8_t* p = base + cdOffset;
+    const uint8_t* end = p + cdSize;
+    for (uint64_t i = 0; i < entryCount; ++i) {
+        if (p + kCentralHeaderSize > end || readU32(p) != kCentralHeaderSignature) {
+            throw std::runtime_error("Corrupt ZIP central directory entry");
+        }
+        uint16_t flags = readU16(p + 8);
+        uint16_t nameLength = readU16(p + 28);
+        uint16_t extraLength = readU16(p + 30);
+        uint16_t commentLength = readU16(p + 32);
+        if (p + kCentralHeaderSize + nameLength + extraLength + commentLength > end) {
+            throw std::runtime_error("Corrupt ZIP central directory entry");
+        }
+
+        ZipEntry entry;
+        entry.method = readU16(p + 10);
+        entry.crc32 = readU32(p + 16);
+        entry.compressedSize = readU32(p + 20);
+        entry.uncompressedSize = readU32(p + 24);
+        entry.localHeaderOffset = readU32(p + 42);
+        entry.name = normalizePartName(
+            std::string(reinterpret_cast<const char*>(p + kCentralHeaderSize), nameLength));
+
+        // ZIP64 扩展字段：只包含溢出的字段，顺序固定
+        const uint8_t* extra = p + kCentralHeaderSize + nameLength;
+        const uint8_t* extraEnd = extra + extraLength;
+        while (extra + 4 <= extraEnd) {
+            uint16_t id = readU16(extra);
+            uint16_t length = readU16(extra + 2);
+            const uint8_t* field = extra + 4;
+            const uint8_t* fieldEnd = std::min(field + length, extraEnd);
+            if (id == kZip64ExtraFieldId) {
+                if (entry.uncompressedSize == 0xFFFFFFFF && field + 8 <= fieldEnd) {
+                    entry.uncompressedSize = readU64(field);
+                    field += 8;
+                }
+                if (entry.compressedSize == 0xFFFFFFFF && field + 8 <= fieldEnd) {
+                    entry.compressedSize = readU64(field);
+                    field += 8;
+                }
+                if (entry.localHeaderOffset == 0xFFFFFFFF && field + 8 <= fieldEnd) {
+                    entry.localHeaderOffset = readU64(field);
+                }
+            }
+            extra += 4 + length;
+        }
+
+        p += kCentralHeaderSize + nameLength + extraLength + commentLength;
+
+        // 跳过目录条目和加密条目
+        if (entry.name.empty() || entry.name.back() == '/' || (flags & 0x0001)) {
+            continue;
+        }
+        index_.emplace(entry.name, entries_.size());
+        entries_.push_back(std::move(entry));
+    }
+}
+
+const uint8_t* ZipArchive::entryData(const ZipEntry& entry) const {
+    const size_t size = data_.size();
+    if (entry.localHeaderOffset > size || size - entry.localHeaderOffset < kLocalHeaderSize) {
+        throw std::runtime_error("Corrupt ZIP local header for " + entry.name);
+    }
+    const uint8_t* header = data_.data() + entry.localHeaderOffset;
+    if (readU32(header) != kLocalHeaderSignature) {
+        throw std::runtime_error("Corrupt ZIP local header for " + entry.name);
+    }
+    // 本地头的扩展字段长度可能与中央目录不同，必须以本地头为准
+    uint64_t dataOffset = entry.localHeaderOffset + kLocalHeaderSize +
+                          readU16(header + 26) + readU16(header + 28);
+    if (dataOffset > size || entry.compressedSize > size - dataOffset) {
+        throw std::runtime_error("Truncated ZIP entry: " + entry.name);
+    }
+    return data_.data() + dataOffset;
+}
+
+const ZipEntry* ZipArchive::findEntry(const std::string& name) const {
+    auto it = index_.find(normalizePartName(name));
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    return &entries_[it->second];
+}
+
+std::unique_ptr<ZipEntryReader> ZipArchive::openEntry(const std::string& name) const {
+    const ZipEntry* entry = findEntry(name);
+    if (!entry) {
+        throw std::runtime_error("ZIP entry not found: " + name);
+    }
+    return std::make_unique<ZipEntryReader>(*this, *entry);
+}
+
+std::vector<uint8_t> ZipArchive::readEntry(const std::string& name) const {
+    auto reader = openEntry(name);
+    std::vector<uint8_t> data(static_cast<size_t>(reader->size()));
+    size_t filled = 0;
+    while (filled < data.size()) {
+        size_t n = reader->read(reinterpret_cast<char*>(data.data()) + filled, data.size() - filled);
+        if (n == 0) {
+            break;
+        }
+        filled += n;
+    }
+    // 触发结尾的 CRC 校验
+    char tail;
+    if (reader->read(&tail, 1) != 0 || filled != data.size()) {
+        throw std::runtime_error("Size mismatch in ZIP entry: " + name);
+    }
+    return data;
+}
+
+void ZipArchive::readEntry(const std::string& name,
+                           const std::function<void(const char*, size_t)>& sink) const {
+    auto reader = openEntry(name);
+    std::vector<char> buffer(64 * 1024);
+    size_t n;
+    while ((n = reader->read(buffer.data(), buffer.size())) > 0) {
+        sink(buffer.data(), n);
+    }
+}
+
+} // namespace doc_converter
@@ -0,0 +1,75 @@
+/**
+ * @file antiword_extractor_test.cpp
+ * @brief antiword输出段落切分的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "antiword_extractor.hpp"
+#include "doc_converter/word_document.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace doc_converter;
+
+namespace {
+
+std::vector<std::string> split(const std::string& output, size_t blockSize) {
+    std::vector<std::string> paragraphs;
+    detail::AntiwordOutputSplitter splitter([&paragraphs](std::string&& text) {
+        paragraphs.push_back(std::move(text));
+    });
+    for (size_t offset = 0; offset < output.size(); offset += blockSize) {
+        splitter.feed(output.data() + offset, std::min(blockSize, output.size() - offset));
+    }
+    splitter.finish();
+    return paragraphs;
+}
+
+} // namespace
+
+// 测试段落切分规则
+TEST(AntiwordExtractorTest, SplitParagraphs) {
+    const std::string output =
+        "First line\n"
+        "continues here\n"
+        "\n"
+        "  Indented starts new\n"
+        "\t  \n"
+        "Last without newline";
+    std::vector<std::string> expected = {
+        "First line continues here",
+        "Indented starts new",
+        "Last without newline",
+    };
+    EXPECT_EQ(split(output, output.size()), expected);
+}
+
+// 测试数据块在任意位置切开时结果不变
+TEST(AntiwordExtractorTest, SplitAcrossBlocks) {
+    std::string output;
+    for (int i = 0; i < 200; ++i) {
+        output += "Paragraph " + std::to_string(i) + " line one\nline two\n\n";
+    }
+    std::vector<std::string> whole = split(output, output.size());
+    ASSERT_EQ(whole.size(), 200);
+    EXPECT_EQ(whole[42], "Paragraph 42 line one line two");
+    for (size_t blockSize : {1, 3, 7, 64, 1000}) {
+        EXPECT_EQ(split(output, blockSize), whole) << "block size " << blockSize;
+    }
+}
+
+// 测试原生解析失败且antiword不可用或失败时返回错误
+TEST(AntiwordExtractorTest, FallbackFailure) {
+    std::string docPath = "not a compound file.doc";
+    {
+        std::ofstream file(docPath, std::ios::binary);
+        file << "plain text, not a Word document";
+    }
+    WordDocument doc;
+    EXPECT_FALSE(doc.loadFromFile(docPath));
+    EXPECT_TRUE(doc.getElements().empty());
+    std::filesystem::remove(docPath);
+}
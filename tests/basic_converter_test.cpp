@@ -97,4 +97,24 @@ TEST_F(BasicConverterTest, ConvertEmptyDocument) {
     EXPECT_EQ(line, "Empty Document");
     
     file.close();
-} 
\ No newline at end of file
+} 
+// 测试列式文档与原文档的转换结果一致
+TEST_F(BasicConverterTest, ConvertFlatDocument) {
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText("Second");
+    para->addText("paragraph.");
+    doc_->addElement(para);
+    doc_->addElement(std::make_shared<TextElement>("Loose text"));
+
+    auto readAll = [](const std::string& path) {
+        std::ifstream file(path);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    ASSERT_TRUE(converter_->convert(*doc_, "test_output.txt"));
+    std::string expected = readAll("test_output.txt");
+
+    FlatDocument flat(*doc_);
+    ASSERT_TRUE(converter_->convert(flat, "test_output.txt"));
+    EXPECT_EQ(readAll("test_output.txt"), expected);
+    EXPECT_FALSE(converter_->convert(flat, "/nonexistent/path/test.txt"));
+}
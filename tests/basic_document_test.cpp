@@ -63,14 +63,61 @@ TEST_F(BasicDocumentTest, LoadFromFile) {
     auto para1 = std::dynamic_pointer_cast<ParagraphElement>(elements[1]);
     ASSERT_NE(para1, nullptr);
     ASSERT_EQ(para1->getTexts().size(), 1);
-    EXPECT_EQ(para1->getTexts()[0]->getText(), "First paragraph.");
+    EXPECT_EQ(para1->getTexts()[0], "First paragraph.");
     
     // 检查第二个段落
     ASSERT_EQ(elements[2]->getType(), ElementType::Paragraph);
     auto para2 = std::dynamic_pointer_cast<ParagraphElement>(elements[2]);
     ASSERT_NE(para2, nullptr);
     ASSERT_EQ(para2->getTexts().size(), 1);
-    EXPECT_EQ(para2->getTexts()[0]->getText(), "Second paragraph.");
+    EXPECT_EQ(para2->getTexts()[0], "Second paragraph.");
+}
+
+// 测试最后一行没有换行符的文件
+TEST_F(BasicDocumentTest, LoadFileWithoutTrailingNewline) {
+    {
+        std::ofstream file("test_doc_no_newline.txt");
+        file << "Title\nBody line";
+    }
+    BasicDocument doc;
+    EXPECT_TRUE(doc.loadFromFile("test_doc_no_newline.txt"));
+    EXPECT_EQ(doc.getTitle(), "Title");
+    ASSERT_EQ(doc.getElements().size(), 2);
+    auto para = std::dynamic_pointer_cast<ParagraphElement>(doc.getElements()[1]);
+    ASSERT_NE(para, nullptr);
+    EXPECT_EQ(para->getTexts()[0], "Body line");
+    std::remove("test_doc_no_newline.txt");
+}
+
+// 测试元素存储区模式
+TEST_F(BasicDocumentTest, LoadIntoElementArena) {
+    {
+        std::ofstream file("test_doc_arena.txt");
+        file << "Title\nFirst\n\nSecond\n";
+    }
+    auto owner = std::make_unique<BasicDocument>();
+    BasicDocument& doc = *owner;
+    doc.setElementStorage(ElementStorage::Arena);
+    ASSERT_TRUE(doc.loadFromFile("test_doc_arena.txt"));
+    const auto& elements = doc.getElements();
+    ASSERT_EQ(elements.size(), 3);
+    auto heading = std::dynamic_pointer_cast<HeadingElement>(elements[0]);
+    ASSERT_NE(heading, nullptr);
+    EXPECT_EQ(heading->getText(), "Title");
+    auto para = std::dynamic_pointer_cast<ParagraphElement>(elements[2]);
+    ASSERT_NE(para, nullptr);
+    EXPECT_EQ(para->getTexts()[0], "Second");
+    EXPECT_GT(elements[1].use_count(), 1);  // 元素与文档的存储区共用控制块
+
+    // 仍可混合添加单独分配的元素
+    doc.addElement(std::make_shared<ParagraphElement>());
+    EXPECT_EQ(doc.getElements().size(), 4);
+
+    // 元素指针使存储区在文档销毁后继续有效
+    owner.reset();
+    EXPECT_EQ(heading->getText(), "Title");
+    EXPECT_EQ(para->getTexts()[0], "Second");
+    std::remove("test_doc_arena.txt");
 }
 
 // 测试添加元素
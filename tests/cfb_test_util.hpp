@@ -0,0 +1,351 @@
+/**
+ * @file cfb_test_util.hpp
+ * @brief 测试用的最小CFB复合文档和Word二进制文档写入工具
+ *
+ * 用于在测试中生成.doc文件，避免依赖外部测试文件。
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace doc_converter {
+namespace testing {
+
+/**
+ * @brief 最小CFB写入器（版本3，512字节扇区，只支持根存储下的流）
+ *
+ * 小于4096字节的流写入迷你流，其余写入普通扇区。FAT只占一个扇区，
+ * 因此生成的文件不超过128个扇区（64KB），足够测试使用。
+ */
+class CompoundFileWriter {
+public:
+    /**
+     * @brief 添加流
+     * @param name 流名称
+     * @param data 流内容
+     */
+    void add(const std::string& name, std::vector<uint8_t> data) {
+        streams_.emplace_back(name, std::move(data));
+    }
+
+    /**
+     * @brief 生成完整的CFB字节
+     * @return vector<uint8_t> 复合文档数据
+     */
+    std::vector<uint8_t> finish() const {
+        std::vector<uint8_t> sectors;
+        std::vector<uint32_t> fat;
+
+        // 开头预留文件头，扇区0固定为FAT扇区
+        fat.push_back(kFatSector);
+        sectors.resize(kSectorSize);
+
+        // 迷你流
+        std::vector<uint8_t> miniStream;
+        std::vector<uint32_t> miniFat;
+        std::vector<uint32_t> starts(streams_.size(), kEndOfChain);
+        for (size_t i = 0; i < streams_.size(); ++i) {
+            const std::vector<uint8_t>& data = streams_[i].second;
+            if (data.size() >= kCutoff || data.empty()) {
+                continue;
+            }
+            uint32_t first = static_cast<uint32_t>(miniFat.size());
+            size_t count = (data.size() + kMiniSectorSize - 1) / kMiniSectorSize;
+            for (size_t n = 0; n < count; ++n) {
+                miniFat.push_back(n + 1 < count ? first + static_cast<uint32_t>(n) + 1 : kEndOfChain);
+            }
+            miniStream.insert(miniStream.end(), data.begin(), data.end());
+            miniStream.resize(miniFat.size() * kMiniSectorSize);
+            starts[i] = first;
+        }
+
+        // 目录：根目录项之后依次排列各个流，用右兄弟串成一条链
+        std::vector<uint8_t> directory;
+        appendEntry(directory, "Root Entry", 5, kNoStream, streams_.empty() ? kNoStream : 1, 0,
+                    miniStream.size());
+        size_t directoryStart = directory.size();
+        for (size_t i = 0; i < streams_.size(); ++i) {
+            appendEntry(directory, streams_[i].first, 2,
+                        i + 1 < streams_.size() ? static_cast<uint32_t>(i + 2) : kNoStream, kNoStream, 0,
+                        streams_[i].second.size());
+        }
+        while (directory.size() % kSectorSize != 0) {
+            appendEntry(directory, "", 0, kNoStream, kNoStream, 0, 0);
+        }
+
+        uint32_t directorySector = allocate(sectors, fat, directory);
+        std::vector<uint8_t> miniFatBytes;
+        for (uint32_t v : miniFat) {
+            put32(miniFatBytes, v);
+        }
+        uint32_t miniFatSector = allocate(sectors, fat, miniFatBytes);
+        uint32_t miniStreamSector = allocate(sectors, fat, miniStream);
+        put32At(directory, 0x74, miniStreamSector);
+        for (size_t i = 0; i < streams_.size(); ++i) {
+            if (streams_[i].second.size() >= kCutoff) {
+                starts[i] = allocate(sectors, fat, streams_[i].second);
+            }
+            put32At(directory, directoryStart + i * kEntrySize + 0x74, starts[i]);
+        }
+        // 目录内容在分配后才补齐起始扇区，重新写回
+        std::copy(directory.begin(), directory.end(), sectors.begin() + (directorySector + 1) * kSectorSize);
+
+        if (fat.size() > kSectorSize / 4) {
+            throw std::runtime_error("CompoundFileWriter: file too large");
+        }
+        fat.resize(kSectorSize / 4, kFreeSector);
+        for (size_t i = 0; i < fat.size(); ++i) {
+            put32At(sectors, kSectorSize + i * 4, fat[i]);
+        }
+
+        // 文件头
+        std::vector<uint8_t> header(kSectorSize, 0);
+        const uint8_t signature[8] = {0xD0, 0xCF, 0x11, 0xE0, 0xA1, 0xB1, 0x1A, 0xE1};
+        std::copy(signature, signature + 8, header.begin());
+        put16At(header, 0x18, 0x003E);
+        put16At(header, 0x1A, 0x0003);
+        put16At(header, 0x1C, 0xFFFE);
+        put16At(header, 0x1E, 9);
+        put16At(header, 0x20, 6);
+        put32At(header, 0x2C, 1);
+        put32At(header, 0x30, directorySector);
+        put32At(header, 0x38, kCutoff);
+        put32At(header, 0x3C, miniFat.empty() ? kEndOfChain : miniFatSector);
+        put32At(header, 0x40, static_cast<uint32_t>((miniFatBytes.size() + kSectorSize - 1) / kSectorSize));
+        put32At(header, 0x44, kEndOfChain);
+        put32At(header, 0x4C, 0);
+        for (size_t i = 1; i < 109; ++i) {
+            put32At(header, 0x4C + i * 4, kFreeSector);
+        }
+
+        // sectors 开头预留的512字节即文件头
+        std::copy(header.begin(), header.end(), sectors.begin());
+        return sectors;
+    }
+
+    /**
+     * @brief 写入文件
+     * @param filePath 文件路径
+     */
+    void writeTo(const std::string& filePath) const {
+        std::vector<uint8_t> bytes = finish();
+        std::ofstream file(filePath, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+private:
+    static constexpr size_t kSectorSize = 512;
+    static constexpr size_t kMiniSectorSize = 64;
+    static constexpr size_t kEntrySize = 128;
+    static constexpr uint32_t kCutoff = 4096;
+    static constexpr uint32_t kEndOfChain = 0xFFFFFFFE;
+    static constexpr uint32_t kFreeSector = 0xFFFFFFFF;
+    static constexpr uint32_t kFatSector = 0xFFFFFFFD;
+    static constexpr uint32_t kNoStream = 0xFFFFFFFF;
+
+    /**
+     * @brief 分配扇区链并写入数据
+     *
+     * sectors 的前512字节占位代表文件头，扇区n位于 (n + 1) * 512。
+     */
+    static uint32_t allocate(std::vector<uint8_t>& sectors, std::vector<uint32_t>& fat,
+                             const std::vector<uint8_t>& data) {
+        if (data.empty()) {
+            return kEndOfChain;
+        }
+        uint32_t first = static_cast<uint32_t>(fat.size());
+        size_t count = (data.size() + kSectorSize - 1) / kSectorSize;
+        for (size_t n = 0; n < count; ++n) {
+            fat.push_back(n + 1 < count ? first + static_cast<uint32_t>(n) + 1 : kEndOfChain);
+        }
+        sectors.resize((first + 1) * kSectorSize);
+        sectors.insert(sectors.end(), data.begin(), data.end());
+        sectors.resize((fat.size() + 1) * kSectorSize);
+        return first;
+    }
+
+    static void appendEntry(std::vector<uint8_t>& out, const std::string& name, uint8_t type,
+                            uint32_t right, uint32_t child, uint32_t start, uint64_t size) {
+        size_t base = out.size();
+        out.resize(base + kEntrySize, 0);
+        for (size_t i = 0; i < name.size(); ++i) {
+            out[base + i * 2] = static_cast<uint8_t>(name[i]);
+        }
+        put16At(out, base + 0x40, static_cast<uint16_t>(name.empty() ? 0 : (name.size() + 1) * 2));
+        out[base + 0x42] = type;
+        out[base + 0x43] = 1;
+        put32At(out, base + 0x44, kNoStream);
+        put32At(out, base + 0x48, right);
+        put32At(out, base + 0x4C, child);
+        put32At(out, base + 0x74, start);
+        put32At(out, base + 0x78, static_cast<uint32_t>(size));
+    }
+
+    static void put32(std::vector<uint8_t>& out, uint32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+        }
+    }
+
+    static void put16At(std::vector<uint8_t>& out, size_t offset, uint16_t v) {
+        out[offset] = static_cast<uint8_t>(v);
+        out[offset + 1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    static void put32At(std::vector<uint8_t>& out, size_t offset, uint32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            out[offset + i] = static_cast<uint8_t>(v >> (i * 8));
+        }
+    }
+
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> streams_;
+};
+
+/**
+ * @brief 最小Word 97二进制文档写入器
+ *
+ * 生成FIB、片段表（1Table流）和正文文本，每个片段可以选择压缩（cp1252）或UTF-16LE编码。
+ * 字符串按字节原样写入，UTF-16片段使用 std::u16string。
+ */
+class WordBinaryWriter {
+public:
+    /**
+     * @brief 添加8位压缩片段
+     * @param text cp1252编码的文本
+     */
+    void addCompressed(const std::string& text) {
+        std::u16string chars;
+        for (char c : text) {
+            chars.push_back(static_cast<unsigned char>(c));
+        }
+        pieces_.push_back({chars, true});
+    }
+
+    /**
+     * @brief 添加UTF-16片段
+     * @param text UTF-16文本
+     */
+    void addUnicode(const std::u16string& text) {
+        pieces_.push_back({text, false});
+    }
+
+    /**
+     * @brief 设置正文字符数（默认为全部片段的字符数）
+     * @param ccpText 正文字符数
+     */
+    void setTextLength(uint32_t ccpText) { ccpText_ = ccpText; }
+
+    /**
+     * @brief 设置FIB标志位
+     * @param flags 附加到默认标志（fWhichTblStm）上的标志
+     */
+    void setExtraFlags(uint16_t flags) { extraFlags_ = flags; }
+
+    /**
+     * @brief 生成CFB字节
+     * @return vector<uint8_t> .doc文件数据
+     */
+    std::vector<uint8_t> finish() const {
+        std::vector<uint8_t> word(kTextOffset, 0);
+        std::vector<uint32_t> cps = {0};
+        std::vector<uint32_t> fcs;
+        for (const auto& piece : pieces_) {
+            uint32_t offset = static_cast<uint32_t>(word.size());
+            if (piece.compressed) {
+                fcs.push_back((offset * 2) | 0x40000000);
+                for (char16_t c : piece.text) {
+                    word.push_back(static_cast<uint8_t>(c));
+                }
+            } else {
+                fcs.push_back(offset);
+                for (char16_t c : piece.text) {
+                    word.push_back(static_cast<uint8_t>(c));
+                    word.push_back(static_cast<uint8_t>(c >> 8));
+                }
+            }
+            cps.push_back(cps.back() + static_cast<uint32_t>(piece.text.size()));
+        }
+        // WordDocument流至少4096字节，保证写入普通扇区
+        word.resize(std::max<size_t>(word.size(), 4096), 0);
+
+        // FIB
+        put16At(word, 0x00, 0xA5EC);
+        put16At(word, 0x02, 0x00C1);
+        put16At(word, 0x0A, static_cast<uint16_t>(0x0200 | extraFlags_));
+        put16At(word, 0x20, 14);             // csw
+        put16At(word, 0x3E, 22);             // cslw
+        put32At(word, 0x40 + 12, ccpText_ ? ccpText_ : cps.back());
+        put16At(word, 0x98, 93);             // cbRgFcLcb
+
+        // CLX：一个Prc和Pcdt
+        std::vector<uint8_t> table = {0x01, 0x02, 0x00, 0xAA, 0xBB, 0x02};
+        uint32_t lcb = static_cast<uint32_t>(cps.size() * 4 + fcs.size() * 8);
+        put32(table, lcb);
+        for (uint32_t cp : cps) {
+            put32(table, cp);
+        }
+        for (uint32_t fc : fcs) {
+            table.push_back(0);
+            table.push_back(0);
+            put32(table, fc);
+            table.push_back(0);
+            table.push_back(0);
+        }
+        put32At(word, 0x9A + 33 * 8, 0);
+        put32At(word, 0x9A + 33 * 8 + 4, static_cast<uint32_t>(table.size()));
+
+        CompoundFileWriter cfb;
+        cfb.add("WordDocument", word);
+        cfb.add("1Table", table);
+        return cfb.finish();
+    }
+
+    /**
+     * @brief 写入文件
+     * @param filePath 文件路径
+     */
+    void writeTo(const std::string& filePath) const {
+        std::vector<uint8_t> bytes = finish();
+        std::ofstream file(filePath, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+private:
+    static constexpr size_t kTextOffset = 0x400;
+
+    struct Piece {
+        std::u16string text;
+        bool compressed;
+    };
+
+    static void put32(std::vector<uint8_t>& out, uint32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+        }
+    }
+
+    static void put16At(std::vector<uint8_t>& out, size_t offset, uint16_t v) {
+        out[offset] = static_cast<uint8_t>(v);
+        out[offset + 1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    static void put32At(std::vector<uint8_t>& out, size_t offset, uint32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            out[offset + i] = static_cast<uint8_t>(v >> (i * 8));
+        }
+    }
+
+    std::vector<Piece> pieces_;
+    uint32_t ccpText_ = 0;
+    uint16_t extraFlags_ = 0;
+};
+
+} // namespace testing
+} // namespace doc_converter
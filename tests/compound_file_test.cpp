@@ -0,0 +1,161 @@
+/**
+ * @file compound_file_test.cpp
+ * @brief CFB复合文档读取器和Word二进制文本提取器的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/compound_file.hpp"
+#include "doc_converter/word_binary_reader.hpp"
+#include "cfb_test_util.hpp"
+#include <stdexcept>
+#include <string>
+
+using namespace doc_converter;
+
+namespace {
+
+std::vector<uint8_t> bytesOf(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+/**
+ * @brief 生成包含压缩片段、Unicode片段、域和脚注文本的测试文档
+ */
+doc_converter::testing::WordBinaryWriter makeSampleDocument() {
+    const std::string compressed = "Hello world\r\x93Quoted\x94\r";
+    const std::u16string unicode = u"See \x13 HYPERLINK \"http://example.com\" \x14link\x15 and 中文\r"
+                                   u"Cell A\x07" u"Cell B\x07\x07"
+                                   u"Line\x0B" u"break\r";
+    doc_converter::testing::WordBinaryWriter writer;
+    writer.addCompressed(compressed);
+    writer.addUnicode(unicode);
+    // 正文之后的脚注文本不应出现在结果中
+    writer.addUnicode(u"Footnote\r");
+    writer.setTextLength(static_cast<uint32_t>(compressed.size() + unicode.size()));
+    return writer;
+}
+
+} // namespace
+
+// 测试普通流和迷你流的读取
+TEST(CompoundFileTest, ReadStreams) {
+    std::string large(10000, 'x');
+    for (size_t i = 0; i < large.size(); i += 7) {
+        large[i] = static_cast<char>('a' + i % 26);
+    }
+    doc_converter::testing::CompoundFileWriter writer;
+    writer.add("Large", bytesOf(large));
+    writer.add("Small", bytesOf("small stream"));
+    writer.add("Medium", bytesOf(std::string(200, 'm')));
+    std::vector<uint8_t> data = writer.finish();
+
+    EXPECT_TRUE(CompoundFile::isCompoundFile(data.data(), data.size()));
+    CompoundFile file(data);
+    EXPECT_TRUE(file.hasStream("Large"));
+    EXPECT_TRUE(file.hasStream("SMALL"));  // 目录名不区分大小写
+    EXPECT_FALSE(file.hasStream("Missing"));
+
+    auto largeData = file.readStream("Large");
+    EXPECT_EQ(std::string(largeData.begin(), largeData.end()), large);
+    auto smallData = file.readStream("Small");
+    EXPECT_EQ(std::string(smallData.begin(), smallData.end()), "small stream");
+    auto mediumData = file.readStream("Medium");
+    EXPECT_EQ(std::string(mediumData.begin(), mediumData.end()), std::string(200, 'm'));
+
+    EXPECT_THROW(file.readStream("Missing"), std::runtime_error);
+}
+
+// 测试非CFB数据和损坏的扇区链
+TEST(CompoundFileTest, RejectInvalidData) {
+    EXPECT_THROW(CompoundFile(bytesOf(std::string(1024, 'x'))), std::runtime_error);
+
+    doc_converter::testing::CompoundFileWriter writer;
+    writer.add("Large", bytesOf(std::string(5000, 'x')));
+    std::vector<uint8_t> data = writer.finish();
+    data.resize(data.size() - 1024);  // 截掉流的最后两个扇区
+    CompoundFile file(data);
+    EXPECT_THROW(file.readStream("Large"), std::runtime_error);
+}
+
+// 测试文件头和目录项中不可信的计数与大小不会导致过量分配
+TEST(CompoundFileTest, RejectOversizedCounts) {
+    doc_converter::testing::CompoundFileWriter writer;
+    writer.add("Large", bytesOf(std::string(5000, 'x')));
+    const std::vector<uint8_t> data = writer.finish();
+    auto put32 = [](std::vector<uint8_t>& bytes, size_t offset, uint32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            bytes[offset + i] = static_cast<uint8_t>(v >> (i * 8));
+        }
+    };
+
+    // FAT和DIFAT扇区数超出文件大小，DIFAT链指向自身
+    std::vector<uint8_t> counts = data;
+    put32(counts, 0x2C, 0xFFFFFFFF);
+    put32(counts, 0x44, 0);
+    put32(counts, 0x48, 0xFFFFFFFF);
+    EXPECT_THROW(CompoundFile{counts}, std::runtime_error);
+
+    // 迷你流分界值必须是4096
+    std::vector<uint8_t> cutoff = data;
+    put32(cutoff, 0x38, 0xFFFFFFFF);
+    EXPECT_THROW(CompoundFile{cutoff}, std::runtime_error);
+
+    // 目录项声明的流大小远大于文件
+    std::vector<uint8_t> huge = data;
+    uint32_t directorySector = huge[0x30] | (huge[0x31] << 8);
+    size_t largeEntry = (directorySector + 1) * 512 + 128;
+    put32(huge, largeEntry + 0x78, 0xFFFFFFF0);
+    CompoundFile file(huge);
+    EXPECT_THROW(file.readStream("Large"), std::runtime_error);
+}
+
+// 测试正文段落提取
+TEST(WordBinaryReaderTest, ExtractParagraphs) {
+    CompoundFile file(makeSampleDocument().finish());
+    WordBinaryReader reader(file);
+    std::vector<std::string> paragraphs = reader.readParagraphs();
+
+    ASSERT_EQ(paragraphs.size(), 6);
+    EXPECT_EQ(paragraphs[0], "Hello world");
+    EXPECT_EQ(paragraphs[1], "\xE2\x80\x9CQuoted\xE2\x80\x9D");  // cp1252引号
+    EXPECT_EQ(paragraphs[2], "See link and \xE4\xB8\xAD\xE6\x96\x87");  // 只保留域结果
+    EXPECT_EQ(paragraphs[3], "Cell A");
+    EXPECT_EQ(paragraphs[4], "Cell B");
+    EXPECT_EQ(paragraphs[5], "Line break");
+}
+
+// 测试嵌套域只保留最外层的域结果，大量嵌套时按线性时间处理
+TEST(WordBinaryReaderTest, NestedFields) {
+    std::u16string text = u"A \x13 outer \x13 inner \x14hidden\x15 code \x14shown\x15 B\r";
+    const size_t depth = 5000;
+    for (size_t i = 0; i < depth; ++i) {
+        text += u"\x13\x14";
+    }
+    text += std::u16string(depth, u'x');
+    text += std::u16string(depth, u'\x15');
+    text += u"\r";
+
+    doc_converter::testing::WordBinaryWriter writer;
+    writer.addUnicode(text);
+    writer.setTextLength(static_cast<uint32_t>(text.size()));
+    CompoundFile file(writer.finish());
+    std::vector<std::string> paragraphs = WordBinaryReader(file).readParagraphs();
+
+    ASSERT_EQ(paragraphs.size(), 2);
+    EXPECT_EQ(paragraphs[0], "A shown B");
+    // 每层域都已进入域结果部分
+    EXPECT_EQ(paragraphs[1], std::string(depth, 'x'));
+}
+
+// 测试不支持的文档
+TEST(WordBinaryReaderTest, RejectUnsupportedDocuments) {
+    doc_converter::testing::WordBinaryWriter encrypted = makeSampleDocument();
+    encrypted.setExtraFlags(0x0100);
+    CompoundFile encryptedFile(encrypted.finish());
+    EXPECT_THROW(WordBinaryReader reader(encryptedFile), std::runtime_error);
+
+    doc_converter::testing::CompoundFileWriter writer;
+    writer.add("Contents", bytesOf("not a word document"));
+    CompoundFile other(writer.finish());
+    EXPECT_THROW(WordBinaryReader reader(other), std::runtime_error);
+}
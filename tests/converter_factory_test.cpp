@@ -0,0 +1,136 @@
+/**
+ * @file converter_factory_test.cpp
+ * @brief 转换器工厂的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/document.hpp"
+#include "doc_converter/basic_converter.hpp"
+#include "doc_converter/html_converter.hpp"
+#include <atomic>
+#include <set>
+#include <thread>
+
+using namespace doc_converter;
+
+namespace {
+
+/**
+ * @brief 注册一个统计创建次数的转换器
+ * @return atomic<int>& 创建次数
+ */
+std::atomic<int>& registerCounting(const std::string& name, ConverterReuse reuse) {
+    auto created = std::make_shared<std::atomic<int>>(0);
+    ConverterFactory::registerConverter(name, [created, name] {
+        ++*created;
+        return std::make_shared<BasicConverter>(name, std::vector<std::string>{"txt"});
+    }, reuse);
+    // 注册保存在快照中，一直有效
+    return *created;
+}
+
+std::shared_ptr<Converter> getOnOtherThread(const std::string& name) {
+    std::shared_ptr<Converter> converter;
+    std::thread([&] { converter = ConverterFactory::getConverter(name); }).join();
+    return converter;
+}
+
+} // namespace
+
+// 测试不复用时每次创建新实例
+TEST(ConverterFactoryTest, NoReuse) {
+    std::atomic<int>& created = registerCounting("FactoryNoReuse", ConverterReuse::None);
+    auto first = ConverterFactory::getConverter("FactoryNoReuse");
+    auto second = ConverterFactory::getConverter("FactoryNoReuse");
+    ASSERT_NE(first, nullptr);
+    EXPECT_NE(first, second);
+    EXPECT_NE(ConverterFactory::createConverter("FactoryNoReuse"), first);
+    EXPECT_EQ(created.load(), 3);
+    EXPECT_EQ(ConverterFactory::getConverter("FactoryUnknown"), nullptr);
+}
+
+// 测试每个线程复用一个实例，重新注册后使用新的注册
+TEST(ConverterFactoryTest, PerThreadReuse) {
+    std::atomic<int>& created = registerCounting("FactoryPerThread", ConverterReuse::PerThread);
+    auto first = ConverterFactory::getConverter("FactoryPerThread");
+    EXPECT_EQ(ConverterFactory::getConverter("FactoryPerThread"), first);
+    EXPECT_EQ(created.load(), 1);
+
+    auto other = getOnOtherThread("FactoryPerThread");
+    ASSERT_NE(other, nullptr);
+    EXPECT_NE(other, first);
+    EXPECT_EQ(created.load(), 2);
+
+    // createConverter() 总是创建新实例
+    EXPECT_NE(ConverterFactory::createConverter("FactoryPerThread"), first);
+
+    std::atomic<int>& replaced = registerCounting("FactoryPerThread", ConverterReuse::PerThread);
+    auto fresh = ConverterFactory::getConverter("FactoryPerThread");
+    EXPECT_NE(fresh, first);
+    EXPECT_EQ(replaced.load(), 1);
+    EXPECT_EQ(ConverterFactory::getConverter("FactoryPerThread"), fresh);
+}
+
+// 测试所有线程共用一个实例，并发获取时只创建一次
+TEST(ConverterFactoryTest, SharedReuse) {
+    std::atomic<int>& created = registerCounting("FactoryShared", ConverterReuse::Shared);
+    std::vector<std::shared_ptr<Converter>> converters(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < converters.size(); ++i) {
+        threads.emplace_back([&converters, i] { converters[i] = ConverterFactory::getConverter("FactoryShared"); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(created.load(), 1);
+    for (const auto& converter : converters) {
+        ASSERT_NE(converter, nullptr);
+        EXPECT_EQ(converter, converters.front());
+    }
+
+    // 内置转换器共用实例
+    auto html = ConverterFactory::getConverter("HTML");
+    ASSERT_NE(dynamic_cast<HtmlConverter*>(html.get()), nullptr);
+    EXPECT_EQ(getOnOtherThread("HTML"), html);
+    EXPECT_NE(ConverterFactory::createConverter("HTML"), html);
+}
+
+// 测试工作线程查找的同时注册新的转换器
+TEST(ConverterFactoryTest, ConcurrentRegistrationAndLookup) {
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto html = ConverterFactory::getConverter("HTML");
+                auto markdown = ConverterFactory::createConverter("Markdown");
+                if (!html || !markdown || html->getName() != "HTML") {
+                    ++failures;
+                }
+                ConverterFactory::getConverter("FactoryConcurrent7");
+            }
+        });
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        std::string name = "FactoryConcurrent" + std::to_string(i % 20);
+        ConverterReuse reuse = static_cast<ConverterReuse>(i % 3);
+        ConverterFactory::registerConverter(name, [name] {
+            return std::make_shared<BasicConverter>(name, std::vector<std::string>{});
+        }, reuse);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+
+    std::set<std::string> names;
+    for (int i = 0; i < 20; ++i) {
+        auto converter = ConverterFactory::getConverter("FactoryConcurrent" + std::to_string(i));
+        ASSERT_NE(converter, nullptr);
+        names.insert(converter->getName());
+    }
+    EXPECT_EQ(names.size(), 20);
+}
@@ -0,0 +1,69 @@
+/**
+ * @file document_builder_test.cpp
+ * @brief 文档构建器的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/document_builder.hpp"
+#include "doc_converter/document_elements.hpp"
+#include <string>
+#include <vector>
+
+using namespace doc_converter;
+
+// 测试元素按移动输出
+TEST(DocumentBuilderTest, EmitMovesElements) {
+    std::vector<std::shared_ptr<DocumentElement>> elements;
+    DocumentBuilder builder(elements);
+    builder.reserve(3);
+    EXPECT_GE(elements.capacity(), 3);
+
+    auto heading = builder.make<HeadingElement>("Title", 1);
+    builder.emit(std::move(heading));
+    EXPECT_FALSE(heading);
+    ParagraphElement& paragraph = builder.emplace<ParagraphElement>();
+    paragraph.addText("Body");
+
+    ASSERT_EQ(builder.size(), 2);
+    EXPECT_EQ(elements[0].use_count(), 1);
+    EXPECT_EQ(elements[1].get(), &paragraph);
+    EXPECT_EQ(paragraph.getTexts()[0], "Body");
+}
+
+// 测试构建器在元素存储区中创建元素
+TEST(DocumentBuilderTest, ArenaStorage) {
+    std::vector<std::shared_ptr<DocumentElement>> elements;
+    auto arena = std::make_shared<ElementArena>();
+    DocumentBuilder builder(elements, arena.get());
+    builder.emplace<HeadingElement>("Title", 2);
+    builder.emit(builder.make<ParagraphElement>());
+
+    EXPECT_EQ(arena->objectCount(), 2);
+    EXPECT_EQ(arena.use_count(), 3);  // 元素与存储区共用控制块
+    builder.setArena(nullptr);
+    builder.emplace<ParagraphElement>();
+    EXPECT_EQ(elements[2].use_count(), 1);
+    EXPECT_EQ(arena->objectCount(), 2);
+}
+
+// 测试图片数据、单元格和表格行按移动传入时不复制
+TEST(DocumentBuilderTest, MoveElementPayloads) {
+    std::vector<uint8_t> payload(4096, 0x5a);
+    const uint8_t* data = payload.data();
+    ImageElement image(std::move(payload), "png", 10, 20);
+    EXPECT_EQ(image.getImageData().data(), data);
+    EXPECT_EQ(image.getDataSize(), 4096);
+
+    std::string text(64, 'x');
+    const char* textData = text.data();
+    TableRow row;
+    row.reserveCells(1);
+    row.addCell(TableCell(std::move(text)));
+    const TableCell* cell = &row.getCells()[0];
+    EXPECT_EQ(cell->getText().data(), textData);
+
+    TableElement table;
+    table.reserveRows(1);
+    table.addRow(std::move(row));
+    EXPECT_EQ(table.getRows()[0].getCells()[0].getText().data(), textData);
+}
@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 #include "doc_converter/document_elements.hpp"
+#include "doc_converter/element_arena.hpp"
+#include "doc_converter/text_arena.hpp"
 
 using namespace doc_converter;
 
@@ -21,6 +23,64 @@ TEST(DocumentElementsTest, TextElement) {
     EXPECT_EQ(text.getText(), "Hello, World!");
 }
 
+// 测试引用文本存储区的文本元素
+TEST(DocumentElementsTest, TextArenaView) {
+    TextArena arena(16);
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 1000; ++i) {
+        views.push_back(arena.store("run " + std::to_string(i)));
+    }
+    // 存储区扩容后之前的视图仍然有效
+    EXPECT_EQ(views[0], "run 0");
+    EXPECT_EQ(views[999], "run 999");
+    EXPECT_TRUE(arena.store("").empty());
+
+    ParagraphElement paragraph;
+    paragraph.addTextView(views[42]);
+    EXPECT_EQ(paragraph.getTexts()[0], "run 42");
+    EXPECT_EQ(paragraph.getTexts()[0].data(), views[42].data());
+}
+
+// 测试在元素存储区中构造元素
+TEST(DocumentElementsTest, ElementArena) {
+    struct Tracked {
+        explicit Tracked(std::vector<int>& log, int id) : log(log), id(id) {}
+        ~Tracked() { log.push_back(id); }
+        std::vector<int>& log;
+        int id;
+    };
+
+    std::vector<int> destroyed;
+    std::shared_ptr<ParagraphElement> paragraph;
+    {
+        auto arena = std::make_shared<ElementArena>(64);
+        arena->make<Tracked>(destroyed, 1);
+        arena->make<Tracked>(destroyed, 2);
+        paragraph = arena->make<ParagraphElement>();
+        paragraph->addTextView(arena->text().store("arena run"));
+        for (int i = 0; i < 1000; ++i) {
+            arena->make<HeadingElement>("Heading " + std::to_string(i), 2);
+        }
+
+        // 元素指针与存储区共用一个控制块
+        EXPECT_EQ(paragraph.use_count(), 2);
+        std::shared_ptr<DocumentElement> copy = paragraph;
+        EXPECT_EQ(arena.use_count(), 3);
+        EXPECT_EQ(arena->objectCount(), 1003);
+        EXPECT_TRUE(destroyed.empty());
+    }
+    // 存储区由剩下的元素指针保持存活
+    EXPECT_TRUE(destroyed.empty());
+    EXPECT_EQ(paragraph->getTexts()[0], "arena run");
+    paragraph.reset();
+    // 存储区销毁时按创建的逆序析构
+    EXPECT_EQ(destroyed, (std::vector<int>{2, 1}));
+
+    // 不由 shared_ptr 持有的存储区不能创建元素
+    ElementArena unowned;
+    EXPECT_THROW(unowned.make<ParagraphElement>(), std::bad_weak_ptr);
+}
+
 // 测试段落元素
 TEST(DocumentElementsTest, ParagraphElement) {
     ParagraphElement para;
@@ -35,8 +95,41 @@ TEST(DocumentElementsTest, ParagraphElement) {
     // 测试获取文本
     auto texts = para.getTexts();
     ASSERT_EQ(texts.size(), 2);
-    EXPECT_EQ(texts[0]->getText(), "First sentence.");
-    EXPECT_EQ(texts[1]->getText(), "Second sentence.");
+    EXPECT_EQ(texts[0], "First sentence.");
+    EXPECT_EQ(texts[1], "Second sentence.");
+}
+
+// 测试段落文本运行的内嵌存储与溢出
+TEST(DocumentElementsTest, ParagraphRuns) {
+    ParagraphElement para;
+    std::string first(100, 'a');
+    const char* firstData = first.data();
+    para.addText(std::move(first));
+    // 缓冲区为空时直接接管字符串
+    EXPECT_EQ(para.getTexts()[0].data(), firstData);
+
+    std::string external = "borrowed";
+    para.addTextView(external);
+    para.addText(std::string());
+    for (int i = 0; i < 10; ++i) {
+        para.addText("run " + std::to_string(i));
+    }
+
+    auto texts = para.getTexts();
+    ASSERT_EQ(texts.size(), 13);
+    EXPECT_EQ(texts[0], std::string(100, 'a'));
+    EXPECT_EQ(texts[1], "borrowed");
+    EXPECT_EQ(texts[1].data(), external.data());
+    EXPECT_TRUE(texts[2].empty());
+    EXPECT_EQ(texts[12], "run 9");
+    std::vector<std::string> collected(texts.begin(), texts.end());
+    EXPECT_EQ(collected[3], "run 0");
+
+    // 复制后运行仍指向各自的缓冲区
+    ParagraphElement copy = para;
+    EXPECT_EQ(copy.getTexts()[12], "run 9");
+    EXPECT_NE(copy.getTexts()[0].data(), para.getTexts()[0].data());
+    EXPECT_EQ(copy.getTexts()[1].data(), external.data());
 }
 
 // 测试标题元素
@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 #include "doc_converter/document.hpp"
+#include "doc_converter/document_elements.hpp"
 
 namespace doc_converter {
 namespace testing {
@@ -163,5 +164,37 @@ TEST(ConverterTest, BasicOperations) {
     EXPECT_EQ(converter.getLastOutputPath(), "output.test");
 }
 
+// 访问者按文档顺序得到具体类型的元素
+TEST(DocumentTest, VisitElements) {
+    struct Recorder : ElementVisitor {
+        void visit(const TextElement& text) override { log.push_back("text:" + std::string(text.getText())); }
+        void visit(const ParagraphElement& para) override {
+            log.push_back("paragraph:" + std::to_string(para.getTexts().size()));
+        }
+        void visit(const HeadingElement& heading) override {
+            log.push_back("heading:" + std::to_string(heading.getLevel()));
+        }
+        void visitOther(const DocumentElement& element) override {
+            log.push_back("other:" + std::to_string(static_cast<int>(element.getType())));
+        }
+        std::vector<std::string> log;
+    };
+
+    TestDocument doc;
+    doc.addElement(std::make_shared<HeadingElement>("Title", 3));
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText("a");
+    para->addText("b");
+    doc.addElement(para);
+    doc.addElement(std::make_shared<TestElement>(ElementType::List));
+    doc.addElement(std::make_shared<TableElement>());  // 未重写的重载默认忽略
+    doc.addElement(std::make_shared<TextElement>("t"));
+
+    Recorder recorder;
+    doc.visitElements(recorder);
+    EXPECT_EQ(recorder.log, (std::vector<std::string>{"heading:3", "paragraph:2", "other:5", "text:t"}));
+    EXPECT_EQ(para.use_count(), 2);  // 访问不复制元素指针
+}
+
 } // namespace testing
 } // namespace doc_converter 
\ No newline at end of file
@@ -0,0 +1,165 @@
+/**
+ * @file element_cursor_test.cpp
+ * @brief 元素游标和有界元素队列的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/element_cursor.hpp"
+#include "doc_converter/basic_converter.hpp"
+#include "doc_converter/basic_document.hpp"
+#include "doc_converter/word_document.hpp"
+#include "test_util.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace doc_converter;
+
+using doc_converter::testing::readFile;
+using doc_converter::testing::writeDocx;
+
+// 测试有界队列按顺序传递元素，满时生产者等待消费者
+TEST(ElementCursorTest, BoundedQueue) {
+    ElementQueue queue(2);
+    EXPECT_EQ(queue.capacity(), 2);
+
+    std::thread producer([&queue] {
+        for (int i = 0; i < 100; ++i) {
+            queue.push(std::make_shared<TextElement>(std::to_string(i)));
+        }
+        queue.close();
+    });
+
+    std::shared_ptr<DocumentElement> element;
+    int expected = 0;
+    while (queue.pop(element)) {
+        auto text = std::dynamic_pointer_cast<TextElement>(element);
+        ASSERT_TRUE(text);
+        EXPECT_EQ(text->getText(), std::to_string(expected++));
+    }
+    producer.join();
+    EXPECT_EQ(expected, 100);
+    EXPECT_FALSE(queue.pop(element));
+}
+
+// 测试放弃元素流后阻塞的生产者收到异常，丢弃模式下不再阻塞
+TEST(ElementCursorTest, CancelAndDiscard) {
+    ElementQueue cancelled(1);
+    cancelled.push(std::make_shared<TextElement>("first"));
+    std::thread producer([&cancelled] {
+        EXPECT_THROW(cancelled.push(std::make_shared<TextElement>("second")), StreamCancelled);
+    });
+    cancelled.cancel();
+    producer.join();
+
+    ElementQueue discarded(1);
+    discarded.push(std::make_shared<TextElement>("first"));
+    discarded.discard();
+    discarded.push(std::make_shared<TextElement>("second"));
+    discarded.close();
+    std::shared_ptr<DocumentElement> element;
+    EXPECT_FALSE(discarded.pop(element));
+}
+
+// 测试未重写 streamFromFile() 的文档在加载完成后送出全部元素
+TEST(ElementCursorTest, DefaultStreamingDocument) {
+    std::string path = "test_cursor_basic.txt";
+    std::ofstream(path) << "Basic Title\nline one\n\nline two\n";
+
+    auto doc = std::make_shared<BasicDocument>();
+    ElementCursor cursor(doc, path, 1);
+    EXPECT_EQ(cursor.getTitle(), "Basic Title");
+    std::vector<std::shared_ptr<DocumentElement>> elements;
+    while (auto element = cursor.next()) {
+        elements.push_back(element);
+    }
+    EXPECT_EQ(cursor.next(), nullptr);
+    ASSERT_TRUE(cursor.finish());
+    EXPECT_EQ(elements, doc->getElements());
+    ASSERT_EQ(elements.size(), 3);
+    EXPECT_EQ(elements[0]->getType(), ElementType::Heading);
+
+    std::remove(path.c_str());
+}
+
+// 测试各种解析模式下游标按文档顺序送出与 loadFromFile() 相同的正文元素
+TEST(ElementCursorTest, WordDocumentStreamsBodyElements) {
+    std::string path = "test_cursor.docx";
+    writeDocx(path, 2000, 10);
+
+    WordDocument expected;
+    ASSERT_TRUE(expected.loadFromFile(path));
+    ASSERT_EQ(expected.getElements().size(), 2200);
+
+    for (ParseMode mode : {ParseMode::Dom, ParseMode::Streaming, ParseMode::Parallel}) {
+        auto doc = std::make_shared<WordDocument>("Streamed");
+        doc->setParseMode(mode);
+        doc->setParseThreads(4);
+        ElementCursor cursor(doc, path, 8);
+        EXPECT_EQ(cursor.getTitle(), "Streamed");
+
+        size_t index = 0;
+        while (auto element = cursor.next()) {
+            ASSERT_LT(index, expected.getElements().size());
+            const auto& reference = expected.getElements()[index++];
+            ASSERT_EQ(element->getType(), reference->getType());
+            if (auto paragraph = std::dynamic_pointer_cast<ParagraphElement>(element)) {
+                EXPECT_EQ(*paragraph->getTexts().begin(),
+                          *std::static_pointer_cast<ParagraphElement>(reference)->getTexts().begin());
+            }
+        }
+        EXPECT_EQ(index, expected.getElements().size());
+        EXPECT_TRUE(cursor.finish());
+        EXPECT_EQ(doc->getElements().size(), expected.getElements().size());
+    }
+
+    std::filesystem::remove(path);
+}
+
+// 测试边加载边转换的输出与先加载后转换相同
+TEST(ElementCursorTest, ConvertFromCursor) {
+    std::string path = "test_cursor_convert.docx";
+    writeDocx(path, 300, 10);
+
+    WordDocument loaded("Report");
+    ASSERT_TRUE(loaded.loadFromFile(path));
+    BasicConverter converter("Text", {"txt"});
+    ASSERT_TRUE(converter.convert(loaded, "test_cursor_expected.txt"));
+
+    ElementCursor cursor(std::make_shared<WordDocument>("Report"), path, 4);
+    ASSERT_TRUE(converter.convert(cursor, "test_cursor_actual.txt"));
+    EXPECT_EQ(readFile("test_cursor_actual.txt"), readFile("test_cursor_expected.txt"));
+
+    // 通过基类接口调用时同样使用流式输出
+    ElementCursor second(std::make_shared<WordDocument>("Report"), path);
+    Converter& base = converter;
+    ASSERT_TRUE(base.convert(second, "test_cursor_base.txt"));
+    EXPECT_EQ(readFile("test_cursor_base.txt"), readFile("test_cursor_expected.txt"));
+
+    std::filesystem::remove(path);
+    std::remove("test_cursor_expected.txt");
+    std::remove("test_cursor_actual.txt");
+    std::remove("test_cursor_base.txt");
+}
+
+// 测试加载失败和提前放弃游标
+TEST(ElementCursorTest, FailureAndEarlyDestruction) {
+    ElementCursor missing(std::make_shared<WordDocument>(), "nonexistent_cursor.docx");
+    EXPECT_EQ(missing.next(), nullptr);
+    EXPECT_FALSE(missing.finish());
+    EXPECT_FALSE(missing.finish());
+
+    std::string path = "test_cursor_abandon.docx";
+    writeDocx(path, 1000, 10);
+    auto doc = std::make_shared<WordDocument>();
+    doc->setParseMode(ParseMode::Streaming);
+    {
+        ElementCursor cursor(doc, path, 1);
+        ASSERT_NE(cursor.next(), nullptr);
+    }
+    // 解析器最多领先队列容量，放弃后不再继续解析
+    EXPECT_LT(doc->getElements().size(), 10);
+
+    std::filesystem::remove(path);
+}
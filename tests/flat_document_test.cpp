@@ -0,0 +1,240 @@
+/**
+ * @file flat_document_test.cpp
+ * @brief 列式文档的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/flat_document.hpp"
+#include "doc_converter/basic_document.hpp"
+#include "doc_converter/basic_converter.hpp"
+#include "test_util.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace doc_converter;
+
+// 测试各类元素压平后的内容
+TEST(FlatDocumentTest, BuildFromDocument) {
+    BasicDocument doc("Flat");
+    doc.addElement(std::make_shared<HeadingElement>("Intro", 2));
+
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText("one");
+    para->addText("two");
+    para->setListInfo(1, "decimal");
+    doc.addElement(para);
+
+    doc.addElement(std::make_shared<TextElement>("loose"));
+
+    auto table = std::make_shared<TableElement>();
+    TableRow row1;
+    row1.addCell(TableCell("A1"));
+    row1.addCell(TableCell("B1"));
+    table->addRow(row1);
+    TableRow row2;
+    row2.addCell(TableCell("A2"));
+    table->addRow(row2);
+    doc.addElement(table);
+
+    auto image = std::make_shared<ImageElement>(std::vector<uint8_t>{1, 2, 3}, "png", 40, 30);
+    doc.addElement(image);
+    doc.addElement(std::make_shared<ParagraphElement>());
+
+    FlatDocument flat(doc);
+    EXPECT_EQ(flat.getTitle(), "Flat");
+    ASSERT_EQ(flat.size(), 6);
+
+    std::vector<ElementType> types;
+    for (const auto& element : flat) {
+        types.push_back(element.type());
+    }
+    EXPECT_EQ(types, (std::vector<ElementType>{ElementType::Heading, ElementType::Paragraph, ElementType::Text,
+                                               ElementType::Table, ElementType::Image, ElementType::Paragraph}));
+
+    EXPECT_EQ(flat[0].text(), "Intro");
+    EXPECT_EQ(flat[0].headingLevel(), 2);
+
+    auto runs = flat[1].runs();
+    ASSERT_EQ(runs.size(), 2);
+    EXPECT_EQ(runs[0], "one");
+    EXPECT_EQ(std::vector<std::string_view>(runs.begin(), runs.end()),
+              (std::vector<std::string_view>{"one", "two"}));
+    EXPECT_EQ(flat[1].listLevel(), 1);
+    EXPECT_EQ(flat[1].listFormat(), "decimal");
+    EXPECT_EQ(flat[1].headingLevel(), 0);  // 类型不符时返回空值
+
+    EXPECT_EQ(flat[2].text(), "loose");
+
+    auto rows = flat[3].rows();
+    ASSERT_EQ(rows.size(), 2);
+    EXPECT_EQ(rows[0].size(), 2);
+    EXPECT_EQ(rows[0][1], "B1");
+    ASSERT_EQ(rows[1].size(), 1);
+    EXPECT_EQ(rows[1][0], "A2");
+
+    const FlatDocument::ImageInfo* info = flat[4].image();
+    ASSERT_NE(info, nullptr);
+    EXPECT_EQ(info->width, 40);
+    EXPECT_EQ(info->height, 30);
+    EXPECT_EQ(flat.text(info->format), "png");
+    EXPECT_EQ(info->dataSize, 3);
+    EXPECT_EQ(flat[4].imageElement(), image);
+    EXPECT_EQ(flat[0].imageElement(), nullptr);
+    EXPECT_EQ(flat[0].image(), nullptr);
+
+    EXPECT_TRUE(flat[5].runs().empty());
+    EXPECT_EQ(flat[5].listLevel(), -1);
+}
+
+// 测试空文档
+TEST(FlatDocumentTest, EmptyDocument) {
+    BasicDocument doc("Empty");
+    FlatDocument flat(doc);
+    EXPECT_TRUE(flat.empty());
+    EXPECT_EQ(flat.begin(), flat.end());
+    EXPECT_EQ(flat.textBytes(), 0);
+}
+
+using doc_converter::testing::readFile;
+
+// 测试快照保存后映射加载，内容与原文档一致
+TEST(FlatDocumentTest, SnapshotRoundTrip) {
+    BasicDocument doc("Snapshot");
+    doc.addElement(std::make_shared<HeadingElement>("Intro", 3));
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText("alpha");
+    para->addText("beta");
+    para->setListInfo(2, "bullet");
+    doc.addElement(para);
+    auto table = std::make_shared<TableElement>();
+    TableRow row;
+    row.addCell(TableCell("A1"));
+    row.addCell(TableCell("B1"));
+    table->addRow(row);
+    doc.addElement(table);
+    std::vector<uint8_t> logo(4096, 0x7f);
+    doc.addElement(std::make_shared<ImageElement>(logo, "png", 16, 8));
+    doc.addElement(std::make_shared<ImageElement>(logo, "png", 32, 16));
+    doc.addElement(std::make_shared<TextElement>("loose"));
+
+    FlatDocument flat(doc);
+    std::string path = "test_snapshot.dsnap";
+    ASSERT_TRUE(flat.saveSnapshot(path));
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+    FlatDocument loaded;
+    ASSERT_TRUE(loaded.loadFromSnapshot(path));
+    EXPECT_EQ(loaded.getTitle(), "Snapshot");
+    ASSERT_EQ(loaded.size(), 6);
+    EXPECT_EQ(loaded.textBytes(), flat.textBytes());
+    EXPECT_EQ(loaded[0].text(), "Intro");
+    EXPECT_EQ(loaded[0].headingLevel(), 3);
+    auto runs = loaded[1].runs();
+    EXPECT_EQ(std::vector<std::string_view>(runs.begin(), runs.end()),
+              (std::vector<std::string_view>{"alpha", "beta"}));
+    EXPECT_EQ(loaded[1].listLevel(), 2);
+    EXPECT_EQ(loaded[1].listFormat(), "bullet");
+    EXPECT_EQ(loaded[2].rows()[0][1], "B1");
+    EXPECT_EQ(loaded[5].text(), "loose");
+
+    const FlatDocument::ImageInfo* info = loaded[4].image();
+    ASSERT_NE(info, nullptr);
+    EXPECT_EQ(info->width, 32);
+    EXPECT_EQ(loaded.text(info->format), "png");
+    EXPECT_EQ(loaded[4].imageElement()->getImageData(), logo);
+    EXPECT_EQ(loaded[4].imageElement()->getFormat(), "png");
+    // 相同的图片数据在快照中只保存一份
+    EXPECT_EQ(loaded[3].image()->dataOffset, info->dataOffset);
+    EXPECT_LT(std::filesystem::file_size(path), 2 * logo.size());
+
+    // 快照与原文档的转换结果相同
+    BasicConverter converter("Text", {"txt"});
+    ASSERT_TRUE(converter.convert(flat, "test_snapshot_original.txt"));
+    ASSERT_TRUE(converter.convert(loaded, "test_snapshot_loaded.txt"));
+    EXPECT_EQ(readFile("test_snapshot_loaded.txt"), readFile("test_snapshot_original.txt"));
+
+    // 复制共享底层映射，删除文件后仍然可用
+    FlatDocument copy = loaded;
+    loaded = FlatDocument();
+    std::remove(path.c_str());
+    EXPECT_EQ(copy[0].text(), "Intro");
+    EXPECT_EQ(copy[3].imageElement()->getImageData(), logo);
+
+    std::remove("test_snapshot_original.txt");
+    std::remove("test_snapshot_loaded.txt");
+}
+
+// 测试拒绝损坏或版本不符的快照
+TEST(FlatDocumentTest, SnapshotRejectsInvalidFiles) {
+    BasicDocument doc("Broken");
+    doc.addElement(std::make_shared<HeadingElement>("Title", 1));
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText("text");
+    doc.addElement(para);
+    std::string path = "test_snapshot_invalid.dsnap";
+    ASSERT_TRUE(FlatDocument(doc).saveSnapshot(path));
+    std::string good = readFile(path);
+
+    auto writeAndLoad = [&path](const std::string& bytes) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+        FlatDocument flat;
+        bool ok = flat.loadFromSnapshot(path);
+        // 加载失败时文档保持原状
+        EXPECT_TRUE(ok || flat.empty());
+        return ok;
+    };
+    EXPECT_TRUE(writeAndLoad(good));
+
+    std::string badMagic = good;
+    badMagic[0] = 'X';
+    EXPECT_FALSE(writeAndLoad(badMagic));
+
+    std::string badVersion = good;
+    badVersion[8] = 99;
+    EXPECT_FALSE(writeAndLoad(badVersion));
+
+    EXPECT_FALSE(writeAndLoad(good.substr(0, 16)));
+    EXPECT_FALSE(writeAndLoad(good.substr(0, good.size() - 8)));
+
+    // 文本段超出文本区
+    std::string badSpan = good;
+    size_t spansOffset = 0;
+    std::memcpy(&spansOffset, badSpan.data() + 24 + 4 * 16, sizeof(spansOffset));
+    uint32_t hugeLength = 1000;
+    std::memcpy(&badSpan[spansOffset + 4], &hugeLength, sizeof(hugeLength));
+    EXPECT_FALSE(writeAndLoad(badSpan));
+
+    std::remove(path.c_str());
+}
+
+// 测试拒绝图片格式被篡改的快照（格式会用作输出文件的扩展名）
+TEST(FlatDocumentTest, SnapshotRejectsTamperedImageFormat) {
+    BasicDocument doc("Images");
+    doc.addElement(std::make_shared<ImageElement>(std::vector<uint8_t>(64, 0x11), "png", 4, 4));
+    std::string path = "test_snapshot_format.dsnap";
+    ASSERT_TRUE(FlatDocument(doc).saveSnapshot(path));
+    std::string good = readFile(path);
+    size_t format = good.find("png");
+    ASSERT_NE(format, std::string::npos);
+
+    for (const char* tampered : {"/..", "P\\G", "p.g"}) {
+        std::string bad = good;
+        bad.replace(format, 3, tampered);
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bad;
+        FlatDocument flat;
+        EXPECT_FALSE(flat.loadFromSnapshot(path)) << tampered;
+        EXPECT_TRUE(flat.empty());
+    }
+
+    FlatDocument loaded;
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << good;
+    ASSERT_TRUE(loaded.loadFromSnapshot(path));
+    EXPECT_EQ(loaded[0].imageElement()->getFormat(), "png");
+
+    std::remove(path.c_str());
+}
+
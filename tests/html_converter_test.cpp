@@ -0,0 +1,239 @@
+/**
+ * @file html_converter_test.cpp
+ * @brief HTML转换器和HTML转义的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/html_converter.hpp"
+#include "doc_converter/basic_document.hpp"
+#include "doc_converter/document_elements.hpp"
+#include "text_escape.hpp"
+#include "test_util.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+using namespace doc_converter;
+
+namespace {
+
+using doc_converter::testing::readFile;
+
+std::string escape(std::string_view text) {
+    MemorySink sink(8);
+    detail::escapeHtml(text, sink);
+    return sink.str();
+}
+
+/**
+ * @brief 逐个字符转义的参照实现
+ */
+std::string referenceEscape(std::string_view text) {
+    std::string result;
+    for (char c : text) {
+        switch (c) {
+            case '&': result += "&amp;"; break;
+            case '<': result += "&lt;"; break;
+            case '>': result += "&gt;"; break;
+            case '"': result += "&quot;"; break;
+            case '\'': result += "&#39;"; break;
+            default: result += c; break;
+        }
+    }
+    return result;
+}
+
+std::string base64(const std::string& data) {
+    MemorySink sink;
+    detail::writeBase64(reinterpret_cast<const uint8_t*>(data.data()), data.size(), sink);
+    return sink.str();
+}
+
+const std::string kHtmlHead =
+    "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>";
+
+} // namespace
+
+// 测试转义全部五个特殊字符，其他字符（包括UTF-8多字节字符）原样写出
+TEST(HtmlEscapeTest, EscapesSpecialCharacters) {
+    EXPECT_EQ(escape(""), "");
+    EXPECT_EQ(escape("plain text"), "plain text");
+    EXPECT_EQ(escape("<a href=\"x\">Tom & Jerry's</a>"),
+              "&lt;a href=&quot;x&quot;&gt;Tom &amp; Jerry&#39;s&lt;/a&gt;");
+    std::string amps;
+    for (int i = 0; i < 18; ++i) {
+        amps += "&amp;";
+    }
+    EXPECT_EQ(escape(std::string(18, '&')), amps);
+    EXPECT_EQ(escape("中文<文本>"), "中文&lt;文本&gt;");
+    // 与特殊字符只差一位的字符不转义
+    EXPECT_EQ(escape("$%(=:;?~\x7f"), "$%(=:;?~\x7f");
+    EXPECT_EQ(escape(std::string("a\0b", 3)), std::string("a\0b", 3));
+}
+
+// 测试特殊字符位于块内任意位置、跨越块边界时与逐字符转义的结果一致
+TEST(HtmlEscapeTest, MatchesScalarReference) {
+    const std::string specials = "<>&\"'";
+    for (size_t length = 0; length <= 70; ++length) {
+        std::string base(length, 'x');
+        EXPECT_EQ(detail::findHtmlSpecial(base), length);
+        for (size_t pos = 0; pos < length; ++pos) {
+            for (char special : specials) {
+                std::string text = base;
+                text[pos] = special;
+                ASSERT_EQ(detail::findHtmlSpecial(text), pos) << length << " " << pos;
+                ASSERT_EQ(escape(text), referenceEscape(text)) << length << " " << pos;
+            }
+        }
+    }
+
+    std::mt19937 rng(42);
+    const std::string alphabet = "abc <>&\"'\xe4\xb8\xad=?";
+    for (int i = 0; i < 200; ++i) {
+        std::string text(rng() % 300, ' ');
+        for (char& c : text) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        ASSERT_EQ(escape(text), referenceEscape(text));
+    }
+}
+
+// 测试Base64编码
+TEST(HtmlEscapeTest, Base64) {
+    EXPECT_EQ(base64(""), "");
+    EXPECT_EQ(base64("f"), "Zg==");
+    EXPECT_EQ(base64("fo"), "Zm8=");
+    EXPECT_EQ(base64("foo"), "Zm9v");
+    EXPECT_EQ(base64("foobar"), "Zm9vYmFy");
+    EXPECT_EQ(base64(std::string("\xff\xfe\x00", 3)), "//4A");
+
+    // 超过一个编码块时结果与分段编码后拼接一致
+    std::string large(3 * 1024 * 3 + 2, '\0');
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<char>(i * 7);
+    }
+    std::string expected;
+    for (size_t i = 0; i < large.size(); i += 3) {
+        expected += base64(large.substr(i, 3));
+    }
+    EXPECT_EQ(base64(large), expected);
+}
+
+// 测试渲染标题、段落、列表、表格和嵌入的图片
+TEST(HtmlConverterTest, RendersElements) {
+    BasicDocument doc("A & B");
+    doc.addElement(std::make_shared<HeadingElement>("Intro <1>", 2));
+    doc.addElement(std::make_shared<HeadingElement>("Deep", 9));
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText("x < y");
+    para->addText(" && \"z\"");
+    doc.addElement(para);
+
+    auto item = [&doc](const std::string& text, int level, const std::string& format) {
+        auto p = std::make_shared<ParagraphElement>();
+        p->addText(text);
+        p->setListInfo(level, format);
+        doc.addElement(p);
+    };
+    item("one", 0, "bullet");
+    item("one.a", 1, "decimal");
+    item("one.b", 1, "decimal");
+    item("two", 0, "bullet");
+    item("first", 0, "decimal");
+
+    auto table = std::make_shared<TableElement>();
+    TableRow row;
+    row.addCell(TableCell("c1"));
+    row.addCell(TableCell("<c2>"));
+    table->addRow(std::move(row));
+    doc.addElement(table);
+    doc.addElement(std::make_shared<ImageElement>(std::vector<uint8_t>{'f', 'o', 'o'}, "PNG", 10, 20));
+    doc.addElement(std::make_shared<ImageElement>(std::vector<uint8_t>(), "png", 1, 1));
+    doc.addElement(std::make_shared<TextElement>("it's"));
+
+    HtmlConverter converter;
+    MemorySink sink(64);
+    ASSERT_TRUE(converter.convert(doc, sink));
+    EXPECT_EQ(sink.str(),
+              kHtmlHead + "A &amp; B</title>\n</head>\n<body>\n"
+              "<h2>Intro &lt;1&gt;</h2>\n"
+              "<h6>Deep</h6>\n"
+              "<p>x &lt; y &amp;&amp; &quot;z&quot;</p>\n"
+              "<ul>\n<li>one\n<ol>\n<li>one.a</li>\n<li>one.b</li>\n</ol>\n</li>\n<li>two</li>\n</ul>\n"
+              "<ol>\n<li>first</li>\n</ol>\n"
+              "<table>\n<tr><td>c1</td><td>&lt;c2&gt;</td></tr>\n</table>\n"
+              "<img src=\"data:image/png;base64,Zm9v\" width=\"10\" height=\"20\" alt=\"\">\n"
+              "<p>it&#39;s</p>\n"
+              "</body>\n</html>\n");
+}
+
+// 测试图片写入输出文件旁的目录，相同的图片只写一次
+TEST(HtmlConverterTest, ImageFiles) {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "doc_converter_html_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    BasicDocument doc("Images");
+    std::vector<uint8_t> data(100, 0x5a);
+    doc.addElement(std::make_shared<ImageElement>(data, "png", 0, 0));
+    doc.addElement(std::make_shared<ImageElement>(data, "png", 0, 0));
+
+    HtmlConverter converter;
+    EXPECT_EQ(converter.getImageMode(), ImageOutputMode::Embed);
+    converter.setImageMode(ImageOutputMode::Files);
+    std::string output = (dir / "report.html").string();
+    ASSERT_TRUE(converter.convert(doc, output));
+
+    std::string name = ImageStore::fileName(ImageStore::hash(data.data(), data.size()), "png");
+    EXPECT_TRUE(fs::exists(dir / "report_files" / name));
+    EXPECT_EQ(std::distance(fs::directory_iterator(dir / "report_files"), fs::directory_iterator()), 1);
+    std::string img = "<img src=\"report_files/" + name + "\" alt=\"\">\n";
+    EXPECT_EQ(readFile(output), kHtmlHead + "Images</title>\n</head>\n<body>\n" + img + img +
+                                "</body>\n</html>\n");
+
+    // 写入输出层时使用设置的目录，未设置时嵌入
+    MemorySink embedded;
+    ASSERT_TRUE(converter.convert(doc, embedded));
+    EXPECT_NE(embedded.str().find("data:image/png;base64,"), std::string::npos);
+
+    converter.setImageDirectory((dir / "shared").string());
+    MemorySink files;
+    ASSERT_TRUE(converter.convert(doc, files));
+    EXPECT_NE(files.str().find((dir / "shared").string() + "/" + name), std::string::npos);
+    EXPECT_TRUE(fs::exists(dir / "shared" / name));
+
+    EXPECT_FALSE(converter.convert(doc, (dir / "missing" / "out.html").string()));
+    fs::remove_all(dir);
+}
+
+// 测试边加载边转换与转换已加载的文档结果一致
+TEST(HtmlConverterTest, ConvertFromCursor) {
+    std::string path = "test_html_cursor.txt";
+    std::ofstream(path) << "Cursor <Title>\nline & one\n\nline two\n";
+
+    auto doc = std::make_shared<BasicDocument>();
+    ASSERT_TRUE(doc->loadFromFile(path));
+    HtmlConverter converter;
+    MemorySink expected;
+    ASSERT_TRUE(converter.convert(*doc, expected));
+    EXPECT_NE(expected.str().find("<title>Cursor &lt;Title&gt;</title>"), std::string::npos);
+
+    ElementCursor cursor(std::make_shared<BasicDocument>(), path, 1);
+    MemorySink streamed;
+    ASSERT_TRUE(converter.convert(cursor, streamed));
+    EXPECT_EQ(streamed.str(), expected.str());
+
+    std::remove(path.c_str());
+}
+
+// 测试从转换器工厂创建HTML转换器
+TEST(HtmlConverterTest, Factory) {
+    auto converter = ConverterFactory::createConverter("HTML");
+    ASSERT_NE(converter, nullptr);
+    EXPECT_EQ(converter->getName(), "HTML");
+    EXPECT_EQ(converter->getSupportedExtensions(), (std::vector<std::string>{"html", "htm"}));
+    EXPECT_NE(dynamic_cast<HtmlConverter*>(converter.get()), nullptr);
+    EXPECT_EQ(ConverterFactory::createConverter("NoSuchFormat"), nullptr);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file image_store_test.cpp
+ * @brief 图片存储的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/image_store.hpp"
+#include "doc_converter/document_elements.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace doc_converter;
+
+namespace {
+
+std::vector<uint8_t> bytes(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+} // namespace
+
+// 测试内容哈希
+TEST(ImageStoreTest, Hash) {
+    std::vector<uint8_t> logo = bytes(std::string(1000, 'L') + "tail");
+    EXPECT_EQ(ImageStore::hash(logo.data(), logo.size()), ImageStore::hash(logo.data(), logo.size()));
+
+    // 任意位置的改动和长度变化都改变哈希
+    std::vector<uint8_t> changed = logo;
+    changed[517] ^= 1;
+    EXPECT_NE(ImageStore::hash(changed.data(), changed.size()), ImageStore::hash(logo.data(), logo.size()));
+    EXPECT_NE(ImageStore::hash(logo.data(), logo.size() - 1), ImageStore::hash(logo.data(), logo.size()));
+    std::vector<uint8_t> zeros(3, 0);
+    EXPECT_NE(ImageStore::hash(zeros.data(), 2), ImageStore::hash(zeros.data(), 3));
+
+    EXPECT_EQ(ImageStore::fileName(0xabcULL, "png"), "0000000000000abc.png");
+    EXPECT_EQ(ImageStore::fileName(0xabcULL, ""), "0000000000000abc");
+}
+
+// 测试相同内容只保存一份，不再引用时释放
+TEST(ImageStoreTest, InternDeduplicates) {
+    ImageStore store;
+    StoredImage first = store.intern(bytes("letterhead"));
+    StoredImage second = store.intern(bytes("letterhead"));
+    StoredImage other = store.intern(bytes("signature"));
+    EXPECT_EQ(first.data.get(), second.data.get());
+    EXPECT_EQ(first.hash, second.hash);
+    EXPECT_NE(other.hash, first.hash);
+    EXPECT_EQ(store.size(), 2);
+    EXPECT_EQ(store.dedupedBytes(), 10);
+
+    other = StoredImage();
+    EXPECT_EQ(store.size(), 1);
+    StoredImage again = store.intern(bytes("signature"));
+    EXPECT_EQ(std::string(again.data->begin(), again.data->end()), "signature");
+}
+
+// 测试同一目录下相同的图片只写一次
+TEST(ImageStoreTest, WriteOnce) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "doc_converter_image_store_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    ImageStore store;
+    ImageElement image(bytes("logo bytes"), "png", 1, 1);
+    ImageElement copy(bytes("logo bytes"), "png", 1, 1);
+    EXPECT_EQ(image.getContentHash(), copy.getContentHash());
+
+    std::string name = store.writeOnce(image.getStoredImage(), "png", dir.string());
+    EXPECT_EQ(name, ImageStore::fileName(image.getContentHash(), "png"));
+    std::ifstream file(dir / name, std::ios::binary);
+    EXPECT_EQ(std::string(std::istreambuf_iterator<char>(file), {}), "logo bytes");
+
+    // 已写过的图片不再写文件
+    std::filesystem::remove(dir / name);
+    EXPECT_EQ(store.writeOnce(copy.getStoredImage(), "png", dir.string()), name);
+    EXPECT_FALSE(std::filesystem::exists(dir / name));
+
+    // 目录不存在时抛出异常，之后可以重试
+    std::filesystem::path missing = dir / "missing";
+    EXPECT_THROW(store.writeOnce(image.getStoredImage(), "png", missing.string()), std::runtime_error);
+    std::filesystem::create_directories(missing);
+    EXPECT_EQ(store.writeOnce(image.getStoredImage(), "png", missing.string()), name);
+    EXPECT_TRUE(std::filesystem::exists(missing / name));
+
+    std::filesystem::remove_all(dir);
+}
+
+// 测试写文件时清理格式、比较已有文件的内容，并发写同一图片时都等到文件写完
+TEST(ImageStoreTest, WriteOnceChecksFormatAndContent) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "doc_converter_image_store_write_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    auto readFile = [](const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), {});
+    };
+
+    ImageStore store;
+    // 不安全的格式改用 bin，文件只会写进输出目录
+    StoredImage image = store.intern(bytes("image bytes"));
+    EXPECT_EQ(store.writeOnce(image, "../x", dir.string()), ImageStore::fileName(image.hash, "bin"));
+    EXPECT_EQ(store.writeOnce(image, "", dir.string()), ImageStore::fileName(image.hash, "bin"));
+    EXPECT_EQ(store.writeOnce(image, "PNG", dir.string()), ImageStore::fileName(image.hash, "bin"));
+
+    // 目录中已有同名、同大小但内容不同的文件时重写
+    std::string name = ImageStore::fileName(image.hash, "png");
+    std::ofstream(dir / name, std::ios::binary) << "IMAGE BYTES";
+    EXPECT_EQ(store.writeOnce(image, "png", dir.string()), name);
+    EXPECT_EQ(readFile(dir / name), "image bytes");
+    EXPECT_FALSE(std::filesystem::exists(dir / (name + ".tmp")));
+
+    // 图片数据释放后不再认为文件已写出
+    ImageHash hash = image.hash;
+    image = StoredImage();
+    std::filesystem::remove(dir / name);
+    StoredImage again = store.intern(bytes("image bytes"));
+    ASSERT_EQ(again.hash, hash);
+    EXPECT_EQ(store.writeOnce(again, "png", dir.string()), name);
+    EXPECT_EQ(readFile(dir / name), "image bytes");
+
+    // 并发写同一图片：每个调用方返回时文件都已完整写出
+    StoredImage large = store.intern(std::vector<uint8_t>(1 << 20, 0x5a));
+    std::string largeName = ImageStore::fileName(large.hash, "png");
+    std::vector<std::thread> threads;
+    std::vector<size_t> sizes(8);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        threads.emplace_back([&, i] {
+            store.writeOnce(large, "png", dir.string());
+            sizes[i] = std::filesystem::file_size(dir / largeName);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t size : sizes) {
+        EXPECT_EQ(size, large.data->size());
+    }
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file mapped_file_test.cpp
+ * @brief 只读文件输入层的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/mapped_file.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace doc_converter;
+
+// 测试普通文件映射
+TEST(MappedFileTest, MapRegularFile) {
+    const std::string path = "test_mapped_file.bin";
+    std::string content(100000, '\0');
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i * 31);
+    }
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    MappedFile file(path);
+    EXPECT_TRUE(file.isMapped());
+    EXPECT_EQ(file.view(), content);
+
+    // 移动后数据仍然有效
+    MappedFile moved(std::move(file));
+    EXPECT_EQ(file.size(), 0);
+    EXPECT_EQ(moved.view(), content);
+
+    std::remove(path.c_str());
+}
+
+// 测试空文件和不存在的文件
+TEST(MappedFileTest, EmptyAndMissingFiles) {
+    const std::string path = "test_mapped_empty.bin";
+    { std::ofstream file(path); }
+    MappedFile empty(path);
+    EXPECT_EQ(empty.size(), 0);
+    std::remove(path.c_str());
+
+    EXPECT_THROW(MappedFile("nonexistent_mapped_file.bin"), std::runtime_error);
+}
+
+// 测试无法映射的管道输入
+TEST(MappedFileTest, ReadFromPipe) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::string content(3 * 1024 * 1024 + 17, 'p');
+    std::thread writer([&] {
+        size_t written = 0;
+        while (written < content.size()) {
+            ssize_t n = write(fds[1], content.data() + written, content.size() - written);
+            if (n <= 0) {
+                break;
+            }
+            written += static_cast<size_t>(n);
+        }
+        close(fds[1]);
+    });
+
+    MappedFile file("/proc/self/fd/" + std::to_string(fds[0]));
+    writer.join();
+    close(fds[0]);
+    EXPECT_FALSE(file.isMapped());
+    EXPECT_EQ(file.size(), content.size());
+    EXPECT_EQ(file.view(), content);
+}
+
+// 测试接管内存数据
+TEST(MappedFileTest, OwnBytes) {
+    MappedFile file(std::vector<uint8_t>{'a', 'b', 'c'});
+    EXPECT_FALSE(file.isMapped());
+    EXPECT_EQ(file.view(), "abc");
+
+    MappedFile other;
+    other = std::move(file);
+    EXPECT_EQ(other.view(), "abc");
+}
@@ -0,0 +1,286 @@
+/**
+ * @file markdown_converter_test.cpp
+ * @brief Markdown转换器和Markdown转义的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/markdown_converter.hpp"
+#include "doc_converter/basic_document.hpp"
+#include "doc_converter/document_elements.hpp"
+#include "text_escape.hpp"
+#include "test_util.hpp"
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace doc_converter;
+
+namespace {
+
+using doc_converter::testing::readFile;
+
+std::string escape(std::string_view text, detail::MarkdownContext context = detail::MarkdownContext::Paragraph) {
+    MemorySink sink(8);
+    detail::escapeMarkdown(text, context, sink);
+    return sink.str();
+}
+
+std::string escapeBlock(std::string_view text) {
+    MemorySink sink;
+    detail::escapeMarkdownBlockStart(text, sink);
+    detail::escapeMarkdown(text, detail::MarkdownContext::Paragraph, sink);
+    return sink.str();
+}
+
+std::shared_ptr<ParagraphElement> paragraph(const std::string& text) {
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText(text);
+    return para;
+}
+
+} // namespace
+
+// 测试成块扫描与逐字节查找的结果一致
+TEST(MarkdownEscapeTest, ByteScanner) {
+    const std::string bytes = "|*_\n";
+    detail::ByteScanner scanner(bytes);
+    std::mt19937 rng(7);
+    const std::string alphabet = "abcdefgh |*_\n\xe4\xb8";
+    for (int i = 0; i < 500; ++i) {
+        std::string text(rng() % 100, ' ');
+        for (char& c : text) {
+            c = alphabet[rng() % (i % 2 ? alphabet.size() : 8)];
+        }
+        size_t expected = text.find_first_of(bytes);
+        ASSERT_EQ(scanner.find(text), expected == std::string::npos ? text.size() : expected) << text;
+    }
+    EXPECT_EQ(detail::ByteScanner("").find("abc"), 3);
+}
+
+// 测试转义行内标记，以及标题和单元格中的换行
+TEST(MarkdownEscapeTest, EscapesInlineMarkers) {
+    EXPECT_EQ(escape("plain text"), "plain text");
+    EXPECT_EQ(escape("*bold* _em_ ~~del~~ `code`"), "\\*bold\\* \\_em\\_ \\~\\~del\\~\\~ \\`code\\`");
+    EXPECT_EQ(escape("[link](url) <tag> a|b AT&T \\"), "\\[link\\](url) \\<tag\\> a\\|b AT\\&T \\\\");
+    EXPECT_EQ(escape("中文*强调*"), "中文\\*强调\\*");
+
+    EXPECT_EQ(escape("line\nnext"), "line\nnext");
+    EXPECT_EQ(escape("line\r\nnext", detail::MarkdownContext::Heading), "line next");
+    EXPECT_EQ(escape("a|b\r\nc", detail::MarkdownContext::TableCell), "a\\|b<br>c");
+
+    std::string longText(100, 'x');
+    longText[37] = '|';
+    longText[99] = '_';
+    EXPECT_EQ(escape(longText), longText.substr(0, 37) + "\\|" + longText.substr(38, 61) + "\\_");
+}
+
+// 测试转义块开头会被当作块标记的前缀
+TEST(MarkdownEscapeTest, EscapesBlockStart) {
+    EXPECT_EQ(escapeBlock("# not a heading"), "\\# not a heading");
+    EXPECT_EQ(escapeBlock("- not a list"), "\\- not a list");
+    EXPECT_EQ(escapeBlock("+ x"), "\\+ x");
+    EXPECT_EQ(escapeBlock("==="), "\\===");
+    EXPECT_EQ(escapeBlock("2024. year"), "2024\\. year");
+    EXPECT_EQ(escapeBlock("1) item"), "1\\) item");
+    EXPECT_EQ(escapeBlock("12 items"), "12 items");
+    EXPECT_EQ(escapeBlock("C# code"), "C# code");
+    EXPECT_EQ(escapeBlock(""), "");
+    // 开头的空白不写出：否则 4 列缩进成为代码块，较少的缩进让块标记绕过检查
+    EXPECT_EQ(escapeBlock("  # indented"), "\\# indented");
+    EXPECT_EQ(escapeBlock("\t    code"), "code");
+    EXPECT_EQ(escapeBlock("   "), "");
+}
+
+// 测试渲染标题、段落、列表、表格和嵌入的图片
+TEST(MarkdownConverterTest, RendersElements) {
+    BasicDocument doc("Notes *draft*");
+    doc.addElement(std::make_shared<HeadingElement>("Intro", 2));
+    doc.addElement(std::make_shared<HeadingElement>("Deep", 9));
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText("# first run");
+    para->addText(" and snake_case");
+    doc.addElement(para);
+    doc.addElement(std::make_shared<ParagraphElement>());
+
+    auto item = [&doc](const std::string& text, int level, const std::string& format) {
+        auto p = paragraph(text);
+        p->setListInfo(level, format);
+        doc.addElement(p);
+    };
+    item("one", 0, "bullet");
+    item("one.a", 1, "decimal");
+    item("deeper", 2, "bullet");
+    item("one.b", 1, "decimal");
+    item("two", 0, "bullet");
+
+    auto table = std::make_shared<TableElement>();
+    TableRow header;
+    header.addCell(TableCell("Name"));
+    header.addCell(TableCell("Value"));
+    table->addRow(std::move(header));
+    TableRow row;
+    row.addCell(TableCell("a|b"));
+    row.addCell(TableCell("line1\nline2"));
+    table->addRow(std::move(row));
+    doc.addElement(table);
+    doc.addElement(std::make_shared<TableElement>());
+    doc.addElement(std::make_shared<ImageElement>(std::vector<uint8_t>{'f', 'o', 'o'}, "jpg", 10, 20));
+    doc.addElement(std::make_shared<TextElement>("- text"));
+
+    MarkdownConverter converter;
+    MemorySink sink(64);
+    ASSERT_TRUE(converter.convert(doc, sink));
+    EXPECT_EQ(sink.str(),
+              "# Notes \\*draft\\*\n\n"
+              "## Intro\n\n"
+              "###### Deep\n\n"
+              "\\# first run and snake\\_case\n\n"
+              "- one\n"
+              "  1. one.a\n"
+              "     - deeper\n"
+              "  1. one.b\n"
+              "- two\n"
+              "\n"
+              "| Name | Value |\n"
+              "| --- | --- |\n"
+              "| a\\|b | line1<br>line2 |\n"
+              "\n"
+              "![](data:image/jpeg;base64,Zm9v)\n\n"
+              "\\- text\n\n");
+}
+
+// 测试大表格逐行写出，输出大小与行数成线性关系
+TEST(MarkdownConverterTest, LargeTable) {
+    const size_t rows = 100000;
+    auto table = std::make_shared<TableElement>();
+    table->reserveRows(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        TableRow row;
+        row.addCell(TableCell(std::to_string(i)));
+        row.addCell(TableCell("v|" + std::to_string(i)));
+        table->addRow(std::move(row));
+    }
+    BasicDocument doc;
+    doc.addElement(table);
+
+    MarkdownConverter converter;
+    NullSink null;
+    ASSERT_TRUE(converter.convert(doc, null));
+
+    size_t expected = std::string("| --- | --- |\n\n").size();
+    for (size_t i = 0; i < rows; ++i) {
+        expected += ("| " + std::to_string(i) + " | v\\|" + std::to_string(i) + " |\n").size();
+    }
+    EXPECT_EQ(null.bytesWritten(), expected);
+
+    MemorySink memory;
+    ASSERT_TRUE(converter.convert(doc, memory));
+    const std::string& output = memory.str();
+    const std::string head = "| 0 | v\\|0 |\n| --- | --- |\n| 1 | v\\|1 |\n";
+    const std::string tail = "| 99999 | v\\|99999 |\n\n";
+    EXPECT_EQ(output.substr(0, head.size()), head);
+    EXPECT_EQ(output.substr(output.size() - tail.size()), tail);
+}
+
+// 测试各行单元格数不同时，表头和分隔行按最宽的一行补齐
+TEST(MarkdownConverterTest, RaggedTable) {
+    auto table = std::make_shared<TableElement>();
+    const std::vector<std::vector<std::string>> cells = {{"A"}, {"1", "2", "3"}, {"x", "y"}};
+    for (const auto& texts : cells) {
+        TableRow row;
+        for (const auto& text : texts) {
+            row.addCell(TableCell(text));
+        }
+        table->addRow(std::move(row));
+    }
+    BasicDocument doc;
+    doc.addElement(table);
+
+    MarkdownConverter converter;
+    MemorySink sink;
+    ASSERT_TRUE(converter.convert(doc, sink));
+    EXPECT_EQ(sink.str(),
+              "| A |  |  |\n"
+              "| --- | --- | --- |\n"
+              "| 1 | 2 | 3 |\n"
+              "| x | y |\n\n");
+}
+
+// 测试只含空白的运行之后，块开头的检查落在第一个含非空白字符的运行上
+TEST(MarkdownConverterTest, LeadingWhitespaceRuns) {
+    BasicDocument doc;
+    auto runs = [&doc](std::initializer_list<const char*> texts) {
+        auto para = std::make_shared<ParagraphElement>();
+        for (const char* text : texts) {
+            para->addText(text);
+        }
+        doc.addElement(para);
+    };
+    runs({" ", "# heading?"});
+    runs({"  ", "", "- item?"});
+    runs({"\t", "> quote?"});
+    runs({"    ", "code?"});
+    runs({"  ", "  ", "1. first?"});
+    runs({"   "});
+
+    MarkdownConverter converter;
+    MemorySink sink;
+    ASSERT_TRUE(converter.convert(doc, sink));
+    EXPECT_EQ(sink.str(),
+              "\\# heading?\n\n"
+              "\\- item?\n\n"
+              "\\> quote?\n\n"
+              "code?\n\n"
+              "1\\. first?\n\n"
+              "\n\n");
+}
+
+// 测试图片写入输出文件旁的目录，链接中编码空格和括号
+TEST(MarkdownConverterTest, ImageFiles) {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "doc_converter_markdown_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    BasicDocument doc;
+    std::vector<uint8_t> data(100, 0x3c);
+    doc.addElement(std::make_shared<ImageElement>(data, "png", 0, 0));
+
+    MarkdownConverter converter;
+    converter.setImageMode(ImageOutputMode::Files);
+    std::string output = (dir / "my notes (1).md").string();
+    ASSERT_TRUE(converter.convert(doc, output));
+
+    std::string name = ImageStore::fileName(ImageStore::hash(data.data(), data.size()), "png");
+    EXPECT_TRUE(fs::exists(dir / "my notes (1)_files" / name));
+    EXPECT_EQ(readFile(output), "![](my%20notes%20%281%29_files/" + name + ")\n\n");
+
+    fs::remove_all(dir);
+}
+
+// 测试边加载边转换与转换已加载的文档结果一致
+TEST(MarkdownConverterTest, ConvertFromCursor) {
+    std::string path = "test_markdown_cursor.txt";
+    std::ofstream(path) << "Cursor Title\nline * one\n\nline two\n";
+
+    auto doc = std::make_shared<BasicDocument>();
+    ASSERT_TRUE(doc->loadFromFile(path));
+    MarkdownConverter converter;
+    MemorySink expected;
+    ASSERT_TRUE(converter.convert(*doc, expected));
+
+    ElementCursor cursor(std::make_shared<BasicDocument>(), path, 1);
+    MemorySink streamed;
+    ASSERT_TRUE(converter.convert(cursor, streamed));
+    EXPECT_EQ(streamed.str(), expected.str());
+
+    std::remove(path.c_str());
+}
+
+// 测试从转换器工厂创建Markdown转换器
+TEST(MarkdownConverterTest, Factory) {
+    auto converter = ConverterFactory::createConverter("Markdown");
+    ASSERT_NE(converter, nullptr);
+    EXPECT_EQ(converter->getName(), "Markdown");
+    EXPECT_NE(dynamic_cast<MarkdownConverter*>(converter.get()), nullptr);
+}
@@ -0,0 +1,225 @@
+/**
+ * @file memory_usage_test.cpp
+ * @brief 文档内存统计和加载预算的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/memory_usage.hpp"
+#include "doc_converter/basic_document.hpp"
+#include "doc_converter/word_document.hpp"
+#include "doc_converter/zip_archive.hpp"
+#include "test_util.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace doc_converter;
+
+namespace {
+
+/**
+ * @brief 固定大小的延迟加载数据源
+ */
+class FixedSource : public ImageSource {
+public:
+    explicit FixedSource(size_t size) : size_(size) {}
+    std::vector<uint8_t> load() const override { return std::vector<uint8_t>(size_, 0x42); }
+    size_t size() const override { return size_; }
+
+private:
+    size_t size_;
+};
+
+using doc_converter::testing::writeDocx;
+
+} // namespace
+
+// 测试按类别统计元素的内存占用
+TEST(MemoryUsageTest, ElementBreakdown) {
+    BasicDocument doc("Usage");
+    const std::string longText(200, 'x');
+    doc.addElement(std::make_shared<HeadingElement>(longText, 1));
+
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText(longText);
+    const std::string external(50, 'e');
+    para->addTextView(external);
+    doc.addElement(para);
+
+    auto table = std::make_shared<TableElement>();
+    for (int r = 0; r < 2; ++r) {
+        TableRow row;
+        row.addCell(TableCell(longText));
+        row.addCell(TableCell(std::string_view("pooled"), TextViewTag{}));
+        table->addRow(std::move(row));
+    }
+    doc.addElement(table);
+
+    // 两个元素共用同一份图片数据，只计一次
+    StoredImage stored{1, std::make_shared<const std::vector<uint8_t>>(4096, 0x7f)};
+    doc.addElement(std::make_shared<ImageElement>(stored, "png", 1, 1));
+    doc.addElement(std::make_shared<ImageElement>(stored, "png", 1, 1));
+    auto lazy = std::make_shared<ImageElement>(std::make_shared<FixedSource>(1000), "png", 1, 1);
+    doc.addElement(lazy);
+
+    MemoryUsage usage = doc.getMemoryUsage();
+    EXPECT_EQ(usage.elementCount, 6);
+    EXPECT_GE(usage.elementBytes, sizeof(HeadingElement) + sizeof(ParagraphElement) + sizeof(TableElement));
+    EXPECT_GE(usage.textBytes, 2 * longText.size());
+    EXPECT_EQ(usage.sharedTextBytes, external.size() + 2 * std::string_view("pooled").size());
+    EXPECT_EQ(usage.tableCells, 4);
+    EXPECT_GE(usage.tableBytes, 2 * longText.size() + 4 * sizeof(TableCell));
+    EXPECT_GE(usage.imageBytes, 4096);
+    EXPECT_LT(usage.imageBytes, 2 * 4096);
+    EXPECT_EQ(usage.lazyImageBytes, 1000);
+    EXPECT_GE(usage.containerBytes, 6 * sizeof(std::shared_ptr<DocumentElement>));
+    EXPECT_EQ(usage.total(), usage.elementBytes + usage.textBytes + usage.tableBytes +
+                             usage.imageBytes + usage.containerBytes);
+
+    // 加载后的图片数据计入 imageBytes
+    lazy->getImageData();
+    MemoryUsage loaded = doc.getMemoryUsage();
+    EXPECT_EQ(loaded.lazyImageBytes, 0);
+    EXPECT_GE(loaded.imageBytes, usage.imageBytes + 1000);
+}
+
+// 测试预算累计和超出预算时的异常
+TEST(MemoryUsageTest, BudgetCharge) {
+    MemoryBudget budget(100, 40);
+    budget.charge(60);
+    EXPECT_EQ(budget.used(), 100);
+    try {
+        budget.charge(1);
+        FAIL() << "expected MemoryBudgetExceeded";
+    } catch (const MemoryBudgetExceeded& e) {
+        EXPECT_EQ(e.required(), 101);
+        EXPECT_EQ(e.budget(), 100);
+        EXPECT_NE(std::string(e.what()).find("budget is 100 bytes"), std::string::npos);
+    }
+}
+
+// 测试文本文档超出预算时中止加载
+TEST(MemoryUsageTest, BasicDocumentBudget) {
+    std::string path = "test_budget.txt";
+    {
+        std::ofstream file(path);
+        file << "Title\n";
+        for (int i = 0; i < 10000; ++i) {
+            file << "line " << i << " of a document that is larger than its budget\n";
+        }
+    }
+
+    BasicDocument unlimited;
+    ASSERT_TRUE(unlimited.loadFromFile(path));
+    size_t needed = unlimited.getMemoryUsage().total();
+
+    BasicDocument limited;
+    limited.setMemoryBudget(needed / 10);
+    EXPECT_EQ(limited.getMemoryBudget(), needed / 10);
+    EXPECT_FALSE(limited.loadFromFile(path));
+    // 超出预算后立即停止，不再继续解析
+    EXPECT_LT(limited.getElements().size(), unlimited.getElements().size() / 5);
+
+    BasicDocument generous;
+    generous.setMemoryBudget(needed * 4);
+    EXPECT_TRUE(generous.loadFromFile(path));
+    EXPECT_EQ(generous.getElements().size(), unlimited.getElements().size());
+
+    std::remove(path.c_str());
+}
+
+// 测试.docx在各种解析模式和存储方式下遵守预算
+TEST(MemoryUsageTest, WordDocumentBudget) {
+    std::string path = "test_budget.docx";
+    writeDocx(path, 3000);
+
+    WordDocument unlimited;
+    ASSERT_TRUE(unlimited.loadFromFile(path));
+    MemoryUsage usage = unlimited.getMemoryUsage();
+    EXPECT_EQ(usage.elementCount, 3000);
+    EXPECT_GT(usage.textBytes, 0);
+
+    WordDocument arenaDoc;
+    arenaDoc.setElementStorage(ElementStorage::Arena);
+    ASSERT_TRUE(arenaDoc.loadFromFile(path));
+    MemoryUsage arenaUsage = arenaDoc.getMemoryUsage();
+    EXPECT_EQ(arenaUsage.elementCount, 3000);
+    EXPECT_GT(arenaUsage.sharedTextBytes, 0);
+    EXPECT_GE(arenaUsage.containerBytes, arenaUsage.sharedTextBytes);
+
+    for (ParseMode mode : {ParseMode::Dom, ParseMode::Streaming, ParseMode::Parallel}) {
+        WordDocument limited;
+        limited.setParseMode(mode);
+        limited.setParseThreads(4);
+        limited.setMemoryBudget(usage.total() / 10);
+        EXPECT_FALSE(limited.loadFromFile(path));
+        EXPECT_LT(limited.getElements().size(), 3000);
+
+        WordDocument generous;
+        generous.setParseMode(mode);
+        generous.setParseThreads(4);
+        generous.setElementStorage(ElementStorage::Arena);
+        generous.setMemoryBudget(usage.total() * 4);
+        EXPECT_TRUE(generous.loadFromFile(path));
+        EXPECT_EQ(generous.getElements().size(), 3000);
+    }
+
+    std::filesystem::remove(path);
+}
+
+// 测试预算容纳不下解析时的XML树时，在输出任何元素之前失败
+TEST(MemoryUsageTest, WordDocumentBudgetCoversXmlTree) {
+    std::string path = "test_budget_xml.docx";
+    writeDocx(path, 3000);
+
+    size_t xmlSize = 0;
+    {
+        ZipArchive archive(path);
+        xmlSize = static_cast<size_t>(archive.openEntry("word/document.xml")->size());
+    }
+
+    for (ParseMode mode : {ParseMode::Dom, ParseMode::Parallel}) {
+        WordDocument limited;
+        limited.setParseMode(mode);
+        limited.setParseThreads(4);
+        limited.setMemoryBudget(xmlSize / 2);
+        EXPECT_FALSE(limited.loadFromFile(path));
+        EXPECT_TRUE(limited.getElements().empty());
+    }
+
+    std::filesystem::remove(path);
+}
+
+// 测试XML树在解析期间一直计入预算：元素和XML树各自都在预算内、合计超出时加载失败
+TEST(MemoryUsageTest, WordDocumentBudgetHoldsXmlTreeDuringParse) {
+    std::string path = "test_budget_transient.docx";
+    writeDocx(path, 3000);
+
+    size_t xmlSize = 0;
+    {
+        ZipArchive archive(path);
+        xmlSize = static_cast<size_t>(archive.openEntry("word/document.xml")->size());
+    }
+    WordDocument unlimited;
+    unlimited.setParseMode(ParseMode::Dom);
+    ASSERT_TRUE(unlimited.loadFromFile(path));
+    size_t elements = unlimited.getMemoryUsage().total();
+    size_t tree = xmlSize * 4;
+
+    // 预算比两者中较大的一个多出较小一个的一半
+    size_t budget = std::max(elements, tree) + std::min(elements, tree) / 2;
+    WordDocument limited;
+    limited.setParseMode(ParseMode::Dom);
+    limited.setMemoryBudget(budget);
+    EXPECT_FALSE(limited.loadFromFile(path));
+    EXPECT_LT(limited.getElements().size(), unlimited.getElements().size());
+
+    // 两者合计在预算内时加载成功，解析结束后临时占用不再计入
+    WordDocument enough;
+    enough.setParseMode(ParseMode::Dom);
+    enough.setMemoryBudget(elements + tree + elements / 2);
+    ASSERT_TRUE(enough.loadFromFile(path));
+    EXPECT_EQ(enough.getElements().size(), unlimited.getElements().size());
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,192 @@
+/**
+ * @file multi_target_converter_test.cpp
+ * @brief 一次解析、多个目标的转换的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/multi_target_converter.hpp"
+#include "doc_converter/basic_converter.hpp"
+#include "doc_converter/basic_document.hpp"
+#include "doc_converter/html_converter.hpp"
+#include "doc_converter/markdown_converter.hpp"
+#include "test_util.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+using namespace doc_converter;
+
+namespace {
+
+using doc_converter::testing::readFile;
+
+/**
+ * @brief 等待全部实例都开始转换后才返回的转换器，用于验证各目标并发执行
+ */
+class RendezvousConverter : public Converter {
+public:
+    struct Shared {
+        std::mutex mutex;
+        std::condition_variable arrived;
+        int waiting = 0;
+        int expected = 0;
+    };
+
+    explicit RendezvousConverter(Shared& shared) : shared_(shared) {}
+
+    using Converter::convert;
+
+    bool convert(const Document& /*doc*/, const std::string& /*outputPath*/) override {
+        std::unique_lock<std::mutex> lock(shared_.mutex);
+        ++shared_.waiting;
+        shared_.arrived.notify_all();
+        return shared_.arrived.wait_for(lock, std::chrono::seconds(10),
+                                        [this] { return shared_.waiting >= shared_.expected; });
+    }
+
+    std::string getName() const override { return "Rendezvous"; }
+    std::vector<std::string> getSupportedExtensions() const override { return {}; }
+
+private:
+    Shared& shared_;
+};
+
+/**
+ * @brief 统计加载次数的文档
+ */
+class CountingDocument : public BasicDocument {
+public:
+    bool loadFromFile(const std::string& filePath) override {
+        ++loads;
+        return BasicDocument::loadFromFile(filePath);
+    }
+
+    int loads = 0;
+};
+
+} // namespace
+
+// 测试同一个文档并发转换到多个目标，结果与逐个转换一致
+TEST(MultiTargetConverterTest, ConvertsAllTargets) {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "doc_converter_multi_target_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    BasicDocument doc("Report");
+    doc.addElement(std::make_shared<HeadingElement>("Summary", 1));
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText("Numbers & <notes>");
+    doc.addElement(para);
+
+    auto text = std::make_shared<BasicConverter>("Text", std::vector<std::string>{"txt"});
+    std::vector<ConversionTarget> targets = {
+        {text, (dir / "report.txt").string()},
+        {"HTML", (dir / "report.html").string()},
+        {"Markdown", (dir / "report.md").string()},
+    };
+    std::vector<ConversionResult> results = MultiTargetConverter::convert(doc, targets);
+    ASSERT_EQ(results.size(), 3);
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_TRUE(results[i].success) << results[i].error;
+        EXPECT_TRUE(results[i].error.empty());
+        EXPECT_EQ(results[i].outputPath, targets[i].outputPath);
+    }
+    EXPECT_EQ(results[0].converterName, "Text");
+    EXPECT_EQ(results[1].converterName, "HTML");
+    EXPECT_EQ(results[2].converterName, "Markdown");
+
+    MemorySink textOut;
+    ASSERT_TRUE(text->convert(doc, textOut));
+    EXPECT_EQ(readFile(targets[0].outputPath), textOut.str());
+    MemorySink htmlOut;
+    ASSERT_TRUE(HtmlConverter().convert(doc, htmlOut));
+    EXPECT_EQ(readFile(targets[1].outputPath), htmlOut.str());
+    MemorySink markdownOut;
+    ASSERT_TRUE(MarkdownConverter().convert(doc, markdownOut));
+    EXPECT_EQ(readFile(targets[2].outputPath), markdownOut.str());
+
+    fs::remove_all(dir);
+}
+
+// 测试各目标的失败分别报告，不影响其他目标
+TEST(MultiTargetConverterTest, ReportsPerTargetFailures) {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "doc_converter_multi_target_failures";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    BasicDocument doc("Failures");
+    doc.addElement(std::make_shared<TextElement>("body"));
+
+    std::string html = (dir / "out.html").string();
+    std::vector<ConversionTarget> targets = {
+        {"NoSuchFormat", (dir / "out.none").string()},
+        {"HTML", html},
+        {"Markdown", (dir / "." / "out.html").string()},
+        {"Markdown", (dir / "missing" / "out.md").string()},
+    };
+    std::vector<ConversionResult> results = MultiTargetConverter::convert(doc, targets);
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_FALSE(results[0].success);
+    EXPECT_EQ(results[0].error, "Unknown converter: NoSuchFormat");
+    EXPECT_TRUE(results[1].success);
+    EXPECT_FALSE(results[2].success);
+    EXPECT_NE(results[2].error.find("already used"), std::string::npos);
+    EXPECT_FALSE(results[3].success);
+    EXPECT_EQ(results[3].error, "Converter Markdown failed");
+
+    // 路径重复的目标没有覆盖前一个目标的输出
+    EXPECT_EQ(readFile(html).compare(0, 15, "<!DOCTYPE html>"), 0);
+    EXPECT_TRUE(MultiTargetConverter::convert(doc, {}).empty());
+
+    fs::remove_all(dir);
+}
+
+// 测试各目标在不同的线程上同时转换
+TEST(MultiTargetConverterTest, RunsTargetsConcurrently) {
+    BasicDocument doc;
+    RendezvousConverter::Shared shared;
+    shared.expected = 4;
+    std::vector<ConversionTarget> targets;
+    for (int i = 0; i < shared.expected; ++i) {
+        targets.emplace_back(std::make_shared<RendezvousConverter>(shared), "target" + std::to_string(i));
+    }
+    // 顺序执行时第一个目标会一直等到超时
+    for (const ConversionResult& result : MultiTargetConverter::convert(doc, targets)) {
+        EXPECT_TRUE(result.success);
+        EXPECT_EQ(result.converterName, "Rendezvous");
+    }
+}
+
+// 测试只加载一次文件，加载失败时全部目标失败
+TEST(MultiTargetConverterTest, ConvertFileLoadsOnce) {
+    std::string input = "test_multi_target.txt";
+    std::ofstream(input) << "Title\nline one\n";
+    std::vector<ConversionTarget> targets = {
+        {"HTML", "test_multi_target.html"},
+        {"Markdown", "test_multi_target.md"},
+    };
+
+    CountingDocument doc;
+    std::vector<ConversionResult> results = MultiTargetConverter::convertFile(doc, input, targets);
+    EXPECT_EQ(doc.loads, 1);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_TRUE(results[1].success);
+    EXPECT_NE(readFile("test_multi_target.md").find("line one"), std::string::npos);
+
+    CountingDocument missing;
+    results = MultiTargetConverter::convertFile(missing, "no_such_input.txt", targets);
+    ASSERT_EQ(results.size(), 2);
+    for (const ConversionResult& result : results) {
+        EXPECT_FALSE(result.success);
+        EXPECT_EQ(result.error, "Failed to load document: no_such_input.txt");
+    }
+
+    std::remove(input.c_str());
+    std::remove("test_multi_target.html");
+    std::remove("test_multi_target.md");
+}
@@ -0,0 +1,65 @@
+/**
+ * @file ooxml_tags_test.cpp
+ * @brief WordprocessingML标签表的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "ooxml_tags.hpp"
+#include <libxml/parser.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace doc_converter::detail;
+
+namespace {
+
+const std::string kDocument =
+    "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\""
+    " xmlns:s=\"http://purl.oclc.org/ooxml/wordprocessingml/main\""
+    " xmlns:m=\"http://schemas.openxmlformats.org/officeDocument/2006/math\""
+    " xmlns:a=\"http://schemas.openxmlformats.org/drawingml/2006/main\">"
+    "<w:body><w:p/><s:tbl/><m:r/><p/><a:blip/><w:unknown/></w:body></w:document>";
+
+std::vector<OoxmlTag> bodyTags(int options) {
+    xmlDocPtr doc = xmlReadMemory(kDocument.data(), static_cast<int>(kDocument.size()),
+                                  nullptr, nullptr, options);
+    EXPECT_NE(doc, nullptr);
+    std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> guard(doc, xmlFreeDoc);
+
+    TagTable tags;
+    xmlNodePtr body = xmlDocGetRootElement(doc)->children;
+    EXPECT_EQ(tags.tagOf(body), OoxmlTag::Body);
+    std::vector<OoxmlTag> result;
+    for (xmlNodePtr node = body->children; node; node = node->next) {
+        result.push_back(tags.tagOf(node));
+    }
+    return result;
+}
+
+} // namespace
+
+// 测试按命名空间区分同名元素
+TEST(OoxmlTagsTest, NamespaceAwareDispatch) {
+    std::vector<OoxmlTag> expected = {
+        OoxmlTag::Paragraph,  // w:p
+        OoxmlTag::Table,      // Strict命名空间的tbl
+        OoxmlTag::Unknown,    // 数学公式中的m:r不是文本运行
+        OoxmlTag::Unknown,    // 无命名空间的p
+        OoxmlTag::Blip,       // a:blip
+        OoxmlTag::Unknown,    // 未识别的w:元素
+    };
+    EXPECT_EQ(bodyTags(0), expected);
+    // 不使用字典时结果相同
+    EXPECT_EQ(bodyTags(XML_PARSE_NODICT), expected);
+}
+
+// 测试命名空间URI识别
+TEST(OoxmlTagsTest, NamespaceFromUri) {
+    EXPECT_EQ(namespaceFromUri((const xmlChar*)"http://schemas.openxmlformats.org/drawingml/2006/wordprocessingDrawing"),
+              OoxmlNamespace::WordprocessingDrawing);
+    EXPECT_EQ(namespaceFromUri((const xmlChar*)"http://purl.oclc.org/ooxml/officeDocument/relationships"),
+              OoxmlNamespace::Relationships);
+    EXPECT_EQ(namespaceFromUri((const xmlChar*)"urn:other"), OoxmlNamespace::Other);
+    EXPECT_EQ(namespaceFromUri(nullptr), OoxmlNamespace::Other);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file output_sink_test.cpp
+ * @brief 转换器输出层的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/output_sink.hpp"
+#include "doc_converter/basic_converter.hpp"
+#include "doc_converter/basic_document.hpp"
+#include "test_util.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <unistd.h>
+
+using namespace doc_converter;
+
+namespace {
+
+using doc_converter::testing::readFile;
+
+/**
+ * @brief 按固定顺序写入小段、单个字符、重复字符和大段文本
+ */
+std::string writePattern(OutputSink& sink) {
+    std::string expected;
+    const std::string large(100, 'L');
+    for (int i = 0; i < 20; ++i) {
+        std::string small = "item" + std::to_string(i);
+        sink << small << ',';
+        sink.fill('#', static_cast<size_t>(i));
+        sink.write(large);
+        expected += small + "," + std::string(static_cast<size_t>(i), '#') + large;
+    }
+    return expected;
+}
+
+} // namespace
+
+// 测试内存输出层在缓冲区很小时保持写入顺序
+TEST(OutputSinkTest, MemorySinkPreservesOrder) {
+    MemorySink sink(16);
+    std::string expected = writePattern(sink);
+    EXPECT_EQ(sink.bytesWritten(), expected.size());
+    EXPECT_EQ(sink.str(), expected);
+
+    sink << "tail";
+    EXPECT_EQ(sink.str(), expected + "tail");
+}
+
+// 测试文件输出层的写入、关闭和错误处理
+TEST(OutputSinkTest, FileSink) {
+    std::string path = "test_output_sink.txt";
+    std::string expected;
+    {
+        FileSink sink(path, 7);
+        expected = writePattern(sink);
+        sink.close();
+        sink.close();
+    }
+    EXPECT_EQ(readFile(path), expected);
+
+    // 析构时写出剩余内容
+    {
+        FileSink sink(path);
+        sink << "buffered";
+    }
+    EXPECT_EQ(readFile(path), "buffered");
+
+    // 写入已打开的文件描述符时不关闭它
+    int fd = ::open(path.c_str(), O_WRONLY | O_TRUNC);
+    ASSERT_GE(fd, 0);
+    {
+        FileSink sink(fd, 4);
+        sink << "descriptor " << 'x';
+    }
+    EXPECT_EQ(::write(fd, "!", 1), 1);
+    ::close(fd);
+    EXPECT_EQ(readFile(path), "descriptor x!");
+
+    EXPECT_THROW(FileSink("/nonexistent/dir/out.txt"), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+// 测试空输出层只统计字节数
+TEST(OutputSinkTest, NullSinkCountsBytes) {
+    NullSink sink(32);
+    std::string expected = writePattern(sink);
+    sink.flush();
+    EXPECT_EQ(sink.bytesWritten(), expected.size());
+}
+
+// 测试转换器写入不同输出层的结果一致
+TEST(OutputSinkTest, ConverterSinks) {
+    BasicDocument doc("Sinks");
+    doc.addElement(std::make_shared<HeadingElement>("Heading", 3));
+    auto para = std::make_shared<ParagraphElement>();
+    para->addText("first");
+    para->addText("second");
+    doc.addElement(para);
+    doc.addElement(std::make_shared<TextElement>("text"));
+
+    BasicConverter converter("Text", {"txt"});
+    MemorySink memory;
+    ASSERT_TRUE(converter.convert(doc, memory));
+    EXPECT_EQ(memory.str(), "Sinks\n\n### Heading\n\nfirst second \n\ntext\n\n");
+
+    std::string path = "test_output_sink_convert.txt";
+    ASSERT_TRUE(converter.convert(doc, path));
+    EXPECT_EQ(readFile(path), memory.str());
+
+    NullSink null;
+    ASSERT_TRUE(converter.convert(doc, null));
+    EXPECT_EQ(null.bytesWritten(), memory.str().size());
+
+    MemorySink flatMemory;
+    ASSERT_TRUE(converter.convert(FlatDocument(doc), flatMemory));
+    EXPECT_EQ(flatMemory.str(), memory.str());
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,55 @@
+/**
+ * @file string_pool_test.cpp
+ * @brief 文本驻留池的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/string_pool.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace doc_converter;
+
+// 测试相同文本只保存一份
+TEST(StringPoolTest, InternDeduplicates) {
+    StringPool pool(16);
+    std::string_view first = pool.intern(std::string("Total"));
+    std::string_view second = pool.intern("Total");
+    EXPECT_EQ(first, "Total");
+    EXPECT_EQ(first.data(), second.data());
+    EXPECT_NE(pool.intern("Subtotal").data(), first.data());
+    EXPECT_TRUE(pool.intern("").empty());
+
+    // 缓冲区扩容后之前驻留的文本仍然有效
+    for (int i = 0; i < 1000; ++i) {
+        pool.intern("row " + std::to_string(i));
+    }
+    EXPECT_EQ(pool.intern("Total").data(), first.data());
+    EXPECT_EQ(pool.size(), 1002);
+    EXPECT_EQ(pool.bytesStored(), 5 + 8 + 10 * 5 + 90 * 6 + 900 * 7);
+}
+
+// 测试多线程同时驻留
+TEST(StringPoolTest, ConcurrentIntern) {
+    StringPool pool;
+    std::vector<std::vector<std::string_view>> results(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&pool, &results, t] {
+            for (int i = 0; i < 2000; ++i) {
+                results[t].push_back(pool.intern("cell " + std::to_string(i % 500)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(pool.size(), 500);
+    for (size_t t = 1; t < results.size(); ++t) {
+        for (size_t i = 0; i < results[t].size(); ++i) {
+            EXPECT_EQ(results[t][i].data(), results[0][i].data());
+        }
+    }
+}
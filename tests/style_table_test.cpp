@@ -0,0 +1,88 @@
+/**
+ * @file style_table_test.cpp
+ * @brief 样式表和编号表的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "style_table.hpp"
+#include <libxml/parser.h>
+#include <memory>
+#include <string>
+
+using namespace doc_converter::detail;
+
+namespace {
+
+const char* kWordNamespace = "xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\"";
+
+std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> parseXml(const std::string& xml) {
+    return std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)>(
+        xmlReadMemory(xml.data(), static_cast<int>(xml.size()), nullptr, nullptr, 0), xmlFreeDoc);
+}
+
+} // namespace
+
+// 测试从样式名识别标题级别
+TEST(StyleTableTest, HeadingLevelFromName) {
+    EXPECT_EQ(headingLevelFromName("heading 1"), 1);
+    EXPECT_EQ(headingLevelFromName("Heading2"), 2);
+    EXPECT_EQ(headingLevelFromName("HEADING  9"), 9);
+    EXPECT_EQ(headingLevelFromName("Heading"), 0);
+    EXPECT_EQ(headingLevelFromName("Heading 1 Char"), 0);
+    EXPECT_EQ(headingLevelFromName("Heading 0"), 0);
+    EXPECT_EQ(headingLevelFromName("Normal"), 0);
+    EXPECT_EQ(headingLevelFromName(""), 0);
+}
+
+// 测试大纲级别、内置样式名和basedOn继承
+TEST(StyleTableTest, ResolveBasedOnChain) {
+    auto doc = parseXml(std::string("<w:styles ") + kWordNamespace + ">"
+        "<w:style w:type=\"paragraph\" w:styleId=\"Normal\"><w:name w:val=\"Normal\"/></w:style>"
+        "<w:style w:type=\"paragraph\" w:styleId=\"Titre2\"><w:name w:val=\"heading 2\"/>"
+        "<w:basedOn w:val=\"Normal\"/></w:style>"
+        "<w:style w:type=\"paragraph\" w:styleId=\"Chapter\"><w:name w:val=\"Chapter\"/>"
+        "<w:pPr><w:outlineLvl w:val=\"0\"/></w:pPr></w:style>"
+        "<w:style w:type=\"paragraph\" w:styleId=\"MySection\"><w:basedOn w:val=\"Titre2\"/></w:style>"
+        "<w:style w:type=\"paragraph\" w:styleId=\"Plain\"><w:basedOn w:val=\"Chapter\"/>"
+        "<w:pPr><w:outlineLvl w:val=\"9\"/></w:pPr></w:style>"
+        "<w:style w:type=\"paragraph\" w:styleId=\"LoopA\"><w:basedOn w:val=\"LoopB\"/></w:style>"
+        "<w:style w:type=\"paragraph\" w:styleId=\"LoopB\"><w:basedOn w:val=\"LoopA\"/></w:style>"
+        "<w:style w:type=\"character\" w:styleId=\"Heading1Char\"><w:name w:val=\"heading 1\"/></w:style>"
+        "</w:styles>");
+    ASSERT_TRUE(doc);
+
+    TagTable tags;
+    StyleTable styles = StyleTable::parse(doc.get(), tags);
+    EXPECT_EQ(styles.size(), 7);
+    EXPECT_EQ(styles.headingLevel("Normal"), 0);
+    EXPECT_EQ(styles.headingLevel("Titre2"), 2);     // 本地化的样式ID，内置名称
+    EXPECT_EQ(styles.headingLevel("Chapter"), 1);    // 大纲级别
+    EXPECT_EQ(styles.headingLevel("MySection"), 2);  // 继承自Titre2
+    EXPECT_EQ(styles.headingLevel("Plain"), 0);      // 大纲级别9覆盖基础样式
+    EXPECT_EQ(styles.headingLevel("LoopA"), 0);      // 循环引用
+    EXPECT_FALSE(styles.contains("Heading1Char"));   // 字符样式不参与
+    EXPECT_FALSE(styles.contains("Missing"));
+}
+
+// 测试编号格式查找
+TEST(NumberingTableTest, ResolveFormats) {
+    auto doc = parseXml(std::string("<w:numbering ") + kWordNamespace + ">"
+        "<w:abstractNum w:abstractNumId=\"0\">"
+        "<w:lvl w:ilvl=\"0\"><w:numFmt w:val=\"bullet\"/></w:lvl>"
+        "<w:lvl w:ilvl=\"1\"><w:numFmt w:val=\"decimal\"/></w:lvl>"
+        "</w:abstractNum>"
+        "<w:num w:numId=\"3\"><w:abstractNumId w:val=\"0\"/></w:num>"
+        "<w:num w:numId=\"4\"><w:abstractNumId w:val=\"7\"/></w:num>"
+        "</w:numbering>");
+    ASSERT_TRUE(doc);
+
+    TagTable tags;
+    NumberingTable numbering = NumberingTable::parse(doc.get(), tags);
+    ASSERT_NE(numbering.format(3, 0), nullptr);
+    EXPECT_EQ(*numbering.format(3, 0), "bullet");
+    ASSERT_NE(numbering.format(3, 1), nullptr);
+    EXPECT_EQ(*numbering.format(3, 1), "decimal");
+    EXPECT_EQ(numbering.format(3, 2), nullptr);
+    EXPECT_EQ(numbering.format(4, 0), nullptr);  // 抽象编号不存在
+    EXPECT_EQ(numbering.format(1, 0), nullptr);
+}
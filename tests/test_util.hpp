@@ -0,0 +1,50 @@
+/**
+ * @file test_util.hpp
+ * @brief 测试共用的文件读写工具
+ */
+
+#pragma once
+
+#include "zip_test_util.hpp"
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace doc_converter {
+namespace testing {
+
+/**
+ * @brief 读取整个文件
+ * @param path 文件路径
+ * @return string 文件内容，文件不存在时为空
+ */
+inline std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+/**
+ * @brief 写出含 count 个段落的.docx文件
+ * @param path 文件路径
+ * @param count 段落数
+ * @param tableEvery 大于0时每隔这么多个段落插入一个单行单列的表格
+ */
+inline void writeDocx(const std::string& path, int count, int tableEvery = 0) {
+    std::string body;
+    for (int i = 0; i < count; ++i) {
+        body += "<w:p><w:r><w:t>Paragraph number " + std::to_string(i) + " with some text</w:t></w:r></w:p>";
+        if (tableEvery > 0 && i % tableEvery == tableEvery - 1) {
+            body += "<w:tbl><w:tr><w:tc><w:p><w:r><w:t>T" + std::to_string(i) +
+                    "</w:t></w:r></w:p></w:tc></w:tr></w:tbl>";
+        }
+    }
+    ZipWriter writer;
+    writer.add("word/document.xml",
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:body>" + body + "<w:sectPr/></w:body></w:document>");
+    writer.writeTo(path);
+}
+
+} // namespace testing
+} // namespace doc_converter
@@ -9,6 +9,8 @@
 #include "doc_converter/word_document.hpp"
 #include "doc_converter/document_elements.hpp"
 #include "doc_converter/logger.hpp"
+#include "cfb_test_util.hpp"
+#include "zip_test_util.hpp"
 #include <filesystem>
 #include <fstream>
 
@@ -163,7 +165,7 @@ TEST_F(WordDocumentTest, LoadFromFile) {
     auto para = std::dynamic_pointer_cast<ParagraphElement>(elements[1]);
     ASSERT_TRUE(para);
     ASSERT_EQ(para->getTexts().size(), 1);
-    EXPECT_EQ(para->getTexts()[0]->getText(), std::string("This is a test paragraph."));
+    EXPECT_EQ(para->getTexts()[0], std::string("This is a test paragraph."));
 
     // 验证表格
     auto table = std::dynamic_pointer_cast<TableElement>(elements[2]);
@@ -193,7 +195,7 @@ TEST_F(WordDocumentTest, AddElement) {
     auto paraElement = std::dynamic_pointer_cast<ParagraphElement>(elements[1]);
     ASSERT_TRUE(paraElement);
     ASSERT_EQ(paraElement->getTexts().size(), 1);
-    EXPECT_EQ(paraElement->getTexts()[0]->getText(), std::string("Test paragraph"));
+    EXPECT_EQ(paraElement->getTexts()[0], std::string("Test paragraph"));
 }
 
 // 测试空文档
@@ -215,7 +217,7 @@ TEST_F(WordDocumentTest, LoadDocFormat) {
     auto para = std::dynamic_pointer_cast<ParagraphElement>(elements[0]);
     ASSERT_TRUE(para);
     ASSERT_FALSE(para->getTexts().empty());
-    EXPECT_EQ(para->getTexts()[0]->getText(), std::string("Test Document"));
+    EXPECT_EQ(para->getTexts()[0], std::string("Test Document"));
 }
 
 // 测试.doc格式错误处理
@@ -227,6 +229,27 @@ TEST_F(WordDocumentTest, DocFormatErrorHandling) {
     EXPECT_FALSE(doc->loadFromFile("test.txt"));
 }
 
+// 测试进程内解析.doc文件
+TEST_F(WordDocumentTest, LoadDocBinary) {
+    std::string docPath = "test binary.doc";  // 路径中包含空格
+    doc_converter::testing::WordBinaryWriter writer;
+    writer.addCompressed("First paragraph\r");
+    writer.addUnicode(u"Second paragraph\r");
+    writer.writeTo(docPath);
+
+    WordDocument doc;
+    ASSERT_TRUE(doc.loadFromFile(docPath));
+    const auto& elements = doc.getElements();
+    ASSERT_EQ(elements.size(), 2);
+    auto first = std::dynamic_pointer_cast<ParagraphElement>(elements[0]);
+    auto second = std::dynamic_pointer_cast<ParagraphElement>(elements[1]);
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(first->getTexts()[0], "First paragraph");
+    EXPECT_EQ(second->getTexts()[0], "Second paragraph");
+
+    std::filesystem::remove(docPath);
+}
+
 // 测试表格解析
 TEST_F(WordDocumentTest, TableParsing) {
     // 测试加载包含表格的文档
@@ -393,4 +416,539 @@ TEST_F(WordDocumentTest, ParseTable) {
 
     // 清理测试文件
     std::filesystem::remove(docxPath);
-}
\ No newline at end of file
+}
+// 测试从ZIP容器加载.docx
+TEST_F(WordDocumentTest, LoadDocxContainer) {
+    std::string docxPath = "test_container.docx";
+    doc_converter::testing::ZipWriter writer;
+    writer.add("[Content_Types].xml", "<Types/>");
+    writer.add("word/document.xml",
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:body><w:tbl>"
+        "<w:tr><w:tc><w:p><w:r><w:t>A1</w:t></w:r></w:p></w:tc>"
+        "<w:tc><w:p><w:r><w:t>B1</w:t></w:r></w:p></w:tc></w:tr>"
+        "</w:tbl></w:body></w:document>");
+    writer.add("word/styles.xml", "<w:styles/>", false);
+    writer.writeTo(docxPath);
+
+    WordDocument doc;
+    ASSERT_TRUE(doc.loadFromFile(docxPath));
+    EXPECT_TRUE(doc.hasPart("word/styles.xml"));
+    EXPECT_FALSE(doc.hasPart("word/numbering.xml"));
+    auto styles = doc.readPart("word/styles.xml");
+    EXPECT_EQ(std::string(styles.begin(), styles.end()), "<w:styles/>");
+
+    const auto& elements = doc.getElements();
+    ASSERT_EQ(elements.size(), 1);
+    auto table = std::dynamic_pointer_cast<TableElement>(elements[0]);
+    ASSERT_TRUE(table);
+    ASSERT_EQ(table->getRows().size(), 1);
+    ASSERT_EQ(table->getRows()[0].getCells().size(), 2);
+    EXPECT_EQ(table->getRows()[0].getCells()[0].getText(), "A1");
+    EXPECT_EQ(table->getRows()[0].getCells()[1].getText(), "B1");
+
+    std::filesystem::remove(docxPath);
+}
+
+// 测试损坏的.docx容器
+TEST_F(WordDocumentTest, LoadCorruptDocxContainer) {
+    std::string docxPath = "test_corrupt.docx";
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/other.xml", "<x/>");
+    writer.writeTo(docxPath);
+
+    WordDocument doc;
+    EXPECT_FALSE(doc.loadFromFile(docxPath));  // 缺少word/document.xml
+
+    std::filesystem::remove(docxPath);
+}
+
+// 测试流式解析与DOM解析结果一致
+TEST_F(WordDocumentTest, StreamingParseMatchesDom) {
+    std::string docxPath = "test_streaming.docx";
+    std::string body;
+    for (int i = 0; i < 500; ++i) {
+        body += "<w:p style=\"Heading 2\"><w:r><w:t>Section " + std::to_string(i) + "</w:t></w:r></w:p>";
+        body += "<w:tbl><w:tr><w:tc><w:p><w:r><w:t>R" + std::to_string(i) +
+                "</w:t></w:r></w:p></w:tc></w:tr></w:tbl>";
+    }
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/document.xml",
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:body>" + body + "<w:sectPr/></w:body></w:document>");
+    writer.writeTo(docxPath);
+
+    WordDocument domDoc;
+    ASSERT_TRUE(domDoc.loadFromFile(docxPath));
+
+    WordDocument streamDoc;
+    streamDoc.setParseMode(ParseMode::Streaming);
+    EXPECT_EQ(streamDoc.getParseMode(), ParseMode::Streaming);
+    ASSERT_TRUE(streamDoc.loadFromFile(docxPath));
+
+    const auto& expected = domDoc.getElements();
+    const auto& actual = streamDoc.getElements();
+    ASSERT_EQ(expected.size(), 1000);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(actual[i]->getType(), expected[i]->getType());
+    }
+    auto heading = std::dynamic_pointer_cast<HeadingElement>(actual[998]);
+    ASSERT_TRUE(heading);
+    EXPECT_EQ(heading->getText(), "Section 499");
+    EXPECT_EQ(heading->getLevel(), 2);
+    auto table = std::dynamic_pointer_cast<TableElement>(actual[999]);
+    ASSERT_TRUE(table);
+    EXPECT_EQ(table->getRows()[0].getCells()[0].getText(), "R499");
+
+    std::filesystem::remove(docxPath);
+}
+
+// 测试流式解析的错误处理
+TEST_F(WordDocumentTest, StreamingParseMalformedXml) {
+    std::string docxPath = "test_streaming_bad.docx";
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/document.xml", "<w:document><w:body><w:p>unterminated");
+    writer.writeTo(docxPath);
+
+    WordDocument doc;
+    doc.setParseMode(ParseMode::Streaming);
+    EXPECT_FALSE(doc.loadFromFile(docxPath));
+
+    std::filesystem::remove(docxPath);
+}
+
+// 测试从容器中延迟加载图片
+TEST_F(WordDocumentTest, LazyContainerImage) {
+    std::string docxPath = "test_lazy_image.docx";
+    std::string pixels = std::string("\x89PNG\r\n\x1a\n", 8) + std::string(1000, 'x');
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/document.xml",
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\""
+        " xmlns:wp=\"http://schemas.openxmlformats.org/drawingml/2006/wordprocessingDrawing\""
+        " xmlns:a=\"http://schemas.openxmlformats.org/drawingml/2006/main\""
+        " xmlns:pic=\"http://schemas.openxmlformats.org/drawingml/2006/picture\""
+        " xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+        "<w:body><w:p><w:r><w:drawing><wp:inline>"
+        "<wp:extent cx=\"7620000\" cy=\"5715000\"/>"
+        "<a:graphic><a:graphicData><pic:pic><pic:blipFill><a:blip r:embed=\"rId7\"/>"
+        "</pic:blipFill></pic:pic></a:graphicData></a:graphic>"
+        "</wp:inline></w:drawing></w:r></w:p></w:body></w:document>");
+    writer.add("word/_rels/document.xml.rels",
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+        "<Relationship Id=\"rId7\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/image\""
+        " Target=\"media/image1.PNG\"/>"
+        "<Relationship Id=\"rId8\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/hyperlink\""
+        " Target=\"http://example.com\" TargetMode=\"External\"/>"
+        "</Relationships>");
+    writer.add("word/media/image1.PNG", pixels);
+    writer.writeTo(docxPath);
+
+    WordDocument doc;
+    ASSERT_TRUE(doc.loadFromFile(docxPath));
+    std::filesystem::remove(docxPath);
+
+    const auto& elements = doc.getElements();
+    ASSERT_EQ(elements.size(), 1);
+    auto image = std::dynamic_pointer_cast<ImageElement>(elements[0]);
+    ASSERT_TRUE(image);
+
+    // 格式、尺寸和大小无需加载图片数据
+    EXPECT_EQ(image->getFormat(), "png");
+    EXPECT_EQ(image->getWidth(), 800);
+    EXPECT_EQ(image->getHeight(), 600);
+    EXPECT_EQ(image->getDataSize(), pixels.size());
+
+    // 源文件已删除，数据仍从内存中的容器解压
+    const auto& data = image->getImageData();
+    EXPECT_EQ(std::string(data.begin(), data.end()), pixels);
+    EXPECT_EQ(&image->getImageData(), &data);
+}
+
+// 测试图片格式只取部件名中合法的扩展名
+TEST_F(WordDocumentTest, ImageFormatFromPartName) {
+    std::string docxPath = "test_image_format.docx";
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"media/image1.JPEG", "jpg"},
+        {"media/x./a/b", "bin"},
+        {"media/image3.toolongext", "bin"},
+        {"media/image4.p-g", "bin"},
+        {"media/image5.", "bin"},
+    };
+    std::string body;
+    std::string rels;
+    doc_converter::testing::ZipWriter writer;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        std::string id = "rId" + std::to_string(i + 1);
+        body += "<w:p><w:r><w:drawing><wp:inline><a:graphic><a:graphicData><pic:pic><pic:blipFill>"
+                "<a:blip r:embed=\"" + id + "\"/></pic:blipFill></pic:pic></a:graphicData></a:graphic>"
+                "</wp:inline></w:drawing></w:r></w:p>";
+        rels += "<Relationship Id=\"" + id + "\" Type=\"http://schemas.openxmlformats.org/officeDocument/"
+                "2006/relationships/image\" Target=\"" + cases[i].first + "\"/>";
+        writer.add("word/" + cases[i].first, "data");
+    }
+    writer.add("word/document.xml",
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\""
+        " xmlns:wp=\"http://schemas.openxmlformats.org/drawingml/2006/wordprocessingDrawing\""
+        " xmlns:a=\"http://schemas.openxmlformats.org/drawingml/2006/main\""
+        " xmlns:pic=\"http://schemas.openxmlformats.org/drawingml/2006/picture\""
+        " xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+        "<w:body>" + body + "</w:body></w:document>");
+    writer.add("word/_rels/document.xml.rels",
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">" + rels +
+        "</Relationships>");
+    writer.writeTo(docxPath);
+
+    WordDocument doc;
+    ASSERT_TRUE(doc.loadFromFile(docxPath));
+    std::filesystem::remove(docxPath);
+
+    const auto& elements = doc.getElements();
+    ASSERT_EQ(elements.size(), cases.size());
+    for (size_t i = 0; i < cases.size(); ++i) {
+        auto image = std::dynamic_pointer_cast<ImageElement>(elements[i]);
+        ASSERT_TRUE(image);
+        EXPECT_EQ(image->getFormat(), cases[i].second) << cases[i].first;
+    }
+}
+
+// 测试并行解析与DOM解析结果一致
+TEST_F(WordDocumentTest, ParallelParseMatchesDom) {
+    std::string docxPath = "test_parallel.docx";
+    std::string body;
+    for (int i = 0; i < 3000; ++i) {
+        if (i % 3 == 0) {
+            body += "<w:p style=\"Heading 1\"><w:r><w:t>H" + std::to_string(i) + "</w:t></w:r></w:p>";
+        } else if (i % 3 == 1) {
+            // 属性值中的'>'和注释不能影响块边界的识别
+            body += "<!-- <w:p> --><w:tbl><w:tblPr w:caption=\"a>b\"/><w:tr><w:tc><w:p><w:r><w:t>T" +
+                    std::to_string(i) + "</w:t></w:r></w:p></w:tc></w:tr></w:tbl>";
+        } else {
+            body += "<w:p/>";
+        }
+    }
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/document.xml",
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:body>" + body + "<w:sectPr/></w:body></w:document>");
+    writer.writeTo(docxPath);
+
+    WordDocument domDoc;
+    ASSERT_TRUE(domDoc.loadFromFile(docxPath));
+
+    WordDocument parallelDoc;
+    parallelDoc.setParseMode(ParseMode::Parallel);
+    parallelDoc.setParseThreads(4);
+    ASSERT_TRUE(parallelDoc.loadFromFile(docxPath));
+
+    const auto& expected = domDoc.getElements();
+    const auto& actual = parallelDoc.getElements();
+    ASSERT_EQ(expected.size(), 2000);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(actual[i]->getType(), expected[i]->getType());
+        if (auto heading = std::dynamic_pointer_cast<HeadingElement>(actual[i])) {
+            EXPECT_EQ(heading->getText(),
+                      std::dynamic_pointer_cast<HeadingElement>(expected[i])->getText());
+        } else {
+            auto table = std::dynamic_pointer_cast<TableElement>(actual[i]);
+            ASSERT_TRUE(table);
+            EXPECT_EQ(table->getRows()[0].getCells()[0].getText(),
+                      std::dynamic_pointer_cast<TableElement>(expected[i])->getRows()[0].getCells()[0].getText());
+        }
+    }
+
+    std::filesystem::remove(docxPath);
+}
+
+// 测试段落文本运行的提取和文本存储区模式
+TEST_F(WordDocumentTest, RunTextAndArenaStorage) {
+    std::string docxPath = "test_runs.docx";
+    std::string body;
+    for (int i = 0; i < 1200; ++i) {
+        body += "<w:p><w:pPr><w:pStyle w:val=\"Normal\"/></w:pPr>\n  "
+                "<w:r><w:t>Plain " + std::to_string(i) + "</w:t></w:r>"
+                "<w:hyperlink><w:r><w:t>link</w:t><w:tab/><w:t xml:space=\"preserve\"> tail</w:t></w:r></w:hyperlink>"
+                "<w:del><w:r><w:delText>removed</w:delText></w:r></w:del>"
+                "<w:r><w:instrText>PAGE</w:instrText></w:r></w:p>";
+    }
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/document.xml",
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:body>" + body + "</w:body></w:document>");
+    writer.writeTo(docxPath);
+
+    std::vector<std::vector<std::string>> baseline;
+    for (ParseMode mode : {ParseMode::Dom, ParseMode::Streaming, ParseMode::Parallel}) {
+        for (int config = 0; config < 3; ++config) {
+            WordDocument doc;
+            doc.setParseMode(mode);
+            doc.setParseThreads(4);
+            doc.setTextStorage(config == 1 ? TextStorage::Arena : TextStorage::Owned);
+            doc.setElementStorage(config == 2 ? ElementStorage::Arena : ElementStorage::Shared);
+            ASSERT_TRUE(doc.loadFromFile(docxPath));
+
+            std::vector<std::vector<std::string>> texts;
+            for (const auto& element : doc.getElements()) {
+                auto paragraph = std::dynamic_pointer_cast<ParagraphElement>(element);
+                ASSERT_TRUE(paragraph);
+                texts.emplace_back();
+                for (const auto& text : paragraph->getTexts()) {
+                    texts.back().emplace_back(text);
+                }
+            }
+            ASSERT_EQ(texts.size(), 1200);
+            EXPECT_EQ(texts[7], (std::vector<std::string>{"Plain 7", "link\t tail"}));
+            if (baseline.empty()) {
+                baseline = texts;
+            } else {
+                EXPECT_EQ(texts, baseline);
+            }
+        }
+    }
+
+    std::filesystem::remove(docxPath);
+}
+
+// 测试按styles.xml识别标题、编号列表以及页眉和脚注部件
+TEST_F(WordDocumentTest, StylesNumberingAndAuxiliaryParts) {
+    std::string docxPath = "test_styles.docx";
+    const std::string ns = "xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\"";
+    const std::string relsNs = "xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\"";
+    const std::string relType = "http://schemas.openxmlformats.org/officeDocument/2006/relationships/";
+    std::string body;
+    for (int i = 0; i < 600; ++i) {
+        body += "<w:p><w:pPr><w:pStyle w:val=\"Custom\"/></w:pPr><w:r><w:t>Chapter " +
+                std::to_string(i) + "</w:t></w:r></w:p>"
+                "<w:p><w:pPr><w:pStyle w:val=\"Custom\"/><w:outlineLvl w:val=\"9\"/></w:pPr>"
+                "<w:r><w:t>Body</w:t></w:r></w:p>"
+                "<w:p><w:pPr><w:pStyle w:val=\"Heading3\"/></w:pPr><w:r><w:t>Undefined</w:t></w:r></w:p>"
+                "<w:p style=\"Heading\"><w:r><w:t>Legacy</w:t></w:r></w:p>"
+                "<w:p><w:pPr><w:numPr><w:ilvl w:val=\"1\"/><w:numId w:val=\"5\"/></w:numPr></w:pPr>"
+                "<w:r><w:t>Item</w:t></w:r></w:p>";
+    }
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/document.xml", "<w:document " + ns + "><w:body>" + body + "</w:body></w:document>");
+    writer.add("word/_rels/document.xml.rels",
+        "<Relationships " + relsNs + ">"
+        "<Relationship Id=\"rId1\" Type=\"" + relType + "styles\" Target=\"styles.xml\"/>"
+        "<Relationship Id=\"rId2\" Type=\"" + relType + "header\" Target=\"header1.xml\"/>"
+        "<Relationship Id=\"rId3\" Type=\"" + relType + "footnotes\" Target=\"footnotes.xml\"/>"
+        "<Relationship Id=\"rId4\" Type=\"" + relType + "footer\" Target=\"missing.xml\"/>"
+        "</Relationships>");
+    writer.add("word/styles.xml",
+        "<w:styles " + ns + ">"
+        "<w:style w:type=\"paragraph\" w:styleId=\"Kop1\"><w:name w:val=\"heading 1\"/></w:style>"
+        "<w:style w:type=\"paragraph\" w:styleId=\"Custom\"><w:name w:val=\"Custom\"/>"
+        "<w:basedOn w:val=\"Kop1\"/></w:style>"
+        "</w:styles>");
+    writer.add("word/numbering.xml",
+        "<w:numbering " + ns + ">"
+        "<w:abstractNum w:abstractNumId=\"2\"><w:lvl w:ilvl=\"1\"><w:numFmt w:val=\"lowerLetter\"/></w:lvl>"
+        "</w:abstractNum><w:num w:numId=\"5\"><w:abstractNumId w:val=\"2\"/></w:num>"
+        "</w:numbering>");
+    writer.add("word/header1.xml",
+        "<w:hdr " + ns + "><w:p><w:pPr><w:pStyle w:val=\"Custom\"/></w:pPr>"
+        "<w:r><w:t>Header</w:t></w:r></w:p></w:hdr>");
+    writer.add("word/footnotes.xml",
+        "<w:footnotes " + ns + ">"
+        "<w:footnote w:type=\"separator\" w:id=\"-1\"><w:p><w:r><w:separator/></w:r></w:p></w:footnote>"
+        "<w:footnote w:id=\"1\"><w:p><w:r><w:t>Note</w:t></w:r></w:p></w:footnote>"
+        "</w:footnotes>");
+    writer.writeTo(docxPath);
+
+    for (ParseMode mode : {ParseMode::Dom, ParseMode::Streaming, ParseMode::Parallel}) {
+        WordDocument doc;
+        doc.setParseMode(mode);
+        doc.setParseThreads(4);
+        ASSERT_TRUE(doc.loadFromFile(docxPath));
+
+        const auto& elements = doc.getElements();
+        ASSERT_EQ(elements.size(), 3000);
+        for (size_t i = 0; i < elements.size(); i += 5) {
+            auto chapter = std::dynamic_pointer_cast<HeadingElement>(elements[i]);
+            ASSERT_TRUE(chapter);
+            EXPECT_EQ(chapter->getLevel(), 1);  // Custom → Kop1 → "heading 1"
+            EXPECT_TRUE(std::dynamic_pointer_cast<ParagraphElement>(elements[i + 1]));
+            auto undefined = std::dynamic_pointer_cast<HeadingElement>(elements[i + 2]);
+            ASSERT_TRUE(undefined);
+            EXPECT_EQ(undefined->getLevel(), 3);
+            auto legacy = std::dynamic_pointer_cast<HeadingElement>(elements[i + 3]);
+            ASSERT_TRUE(legacy);
+            EXPECT_EQ(legacy->getLevel(), 1);
+            auto item = std::dynamic_pointer_cast<ParagraphElement>(elements[i + 4]);
+            ASSERT_TRUE(item);
+            EXPECT_TRUE(item->isListItem());
+            EXPECT_EQ(item->getListLevel(), 1);
+            EXPECT_EQ(item->getListFormat(), "lowerLetter");
+        }
+
+        // 缺失的页脚部件被跳过；分隔线脚注不产生元素
+        EXPECT_EQ(doc.getAuxiliaryParts(),
+                  (std::vector<std::string>{"word/footnotes.xml", "word/header1.xml"}));
+        const auto& header = doc.getAuxiliaryElements("word/header1.xml");
+        ASSERT_EQ(header.size(), 1);
+        auto headerHeading = std::dynamic_pointer_cast<HeadingElement>(header[0]);
+        ASSERT_TRUE(headerHeading);
+        EXPECT_EQ(headerHeading->getText(), "Header");
+        const auto& notes = doc.getAuxiliaryElements("word/footnotes.xml");
+        ASSERT_EQ(notes.size(), 1);
+        auto note = std::dynamic_pointer_cast<ParagraphElement>(notes[0]);
+        ASSERT_TRUE(note);
+        EXPECT_EQ(note->getTexts()[0], "Note");
+        EXPECT_TRUE(doc.getAuxiliaryElements("word/footer1.xml").empty());
+    }
+
+    std::filesystem::remove(docxPath);
+}
+
+// 测试在多个文档之间共享文本驻留池
+TEST_F(WordDocumentTest, SharedStringPool) {
+    std::string docxPath = "test_string_pool.docx";
+    std::string body;
+    for (int i = 0; i < 200; ++i) {
+        body += "<w:tr><w:tc><w:p><w:r><w:t>Item</w:t></w:r></w:p></w:tc>"
+                "<w:tc><w:p><w:r><w:t>" + std::to_string(i % 10) + "</w:t></w:r></w:p></w:tc></w:tr>";
+    }
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/document.xml",
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:body><w:p><w:r><w:t>Item</w:t></w:r></w:p><w:tbl>" + body + "</w:tbl></w:body></w:document>");
+    writer.writeTo(docxPath);
+
+    auto pool = std::make_shared<StringPool>();
+    WordDocument first;
+    WordDocument second;
+    first.setStringPool(pool);
+    second.setStringPool(pool);
+    second.setParseMode(ParseMode::Streaming);
+    ASSERT_TRUE(first.loadFromFile(docxPath));
+    ASSERT_TRUE(second.loadFromFile(docxPath));
+    EXPECT_EQ(pool->size(), 11);
+
+    auto para = std::dynamic_pointer_cast<ParagraphElement>(first.getElements()[0]);
+    auto table = std::dynamic_pointer_cast<TableElement>(first.getElements()[1]);
+    auto otherTable = std::dynamic_pointer_cast<TableElement>(second.getElements()[1]);
+    ASSERT_TRUE(para && table && otherTable);
+    ASSERT_EQ(table->getRows().size(), 200);
+    std::string_view item = table->getRows()[0].getCells()[0].getText();
+    EXPECT_EQ(item, "Item");
+    EXPECT_EQ(para->getTexts()[0].data(), item.data());
+    EXPECT_EQ(table->getRows()[199].getCells()[0].getText().data(), item.data());
+    EXPECT_EQ(otherTable->getRows()[13].getCells()[1].getText().data(),
+              table->getRows()[3].getCells()[1].getText().data());
+
+    // 文档持有池的引用，外部释放后文本仍然有效
+    pool.reset();
+    EXPECT_EQ(first.getStringPool()->size(), 11);
+    EXPECT_EQ(table->getRows()[199].getCells()[1].getText(), "9");
+
+    std::filesystem::remove(docxPath);
+}
+
+// 测试元素存储区持有驻留池：文档和外部引用都释放后元素文本仍然有效
+TEST_F(WordDocumentTest, ArenaElementsRetainStringPool) {
+    std::string docxPath = "test_arena_pool.docx";
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/document.xml",
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:body><w:p><w:r><w:t>pooled text</w:t></w:r></w:p>"
+        "<w:tbl><w:tr><w:tc><w:p><w:r><w:t>cell</w:t></w:r></w:p></w:tc></w:tr></w:tbl></w:body></w:document>");
+    writer.writeTo(docxPath);
+
+    for (ParseMode mode : {ParseMode::Dom, ParseMode::Streaming, ParseMode::Parallel}) {
+        std::vector<std::shared_ptr<DocumentElement>> elements;
+        std::weak_ptr<StringPool> weakPool;
+        {
+            auto pool = std::make_shared<StringPool>();
+            weakPool = pool;
+            WordDocument doc;
+            doc.setParseMode(mode);
+            doc.setElementStorage(ElementStorage::Arena);
+            doc.setStringPool(std::move(pool));
+            ASSERT_TRUE(doc.loadFromFile(docxPath));
+            elements = doc.getElements();
+        }
+        EXPECT_FALSE(weakPool.expired());
+        ASSERT_EQ(elements.size(), 2);
+        auto para = std::dynamic_pointer_cast<ParagraphElement>(elements[0]);
+        auto table = std::dynamic_pointer_cast<TableElement>(elements[1]);
+        ASSERT_TRUE(para && table);
+        EXPECT_EQ(para->getTexts()[0], "pooled text");
+        EXPECT_EQ(table->getRows()[0].getCells()[0].getText(), "cell");
+
+        elements.clear();
+        para.reset();
+        table.reset();
+        EXPECT_TRUE(weakPool.expired());
+    }
+
+    std::filesystem::remove(docxPath);
+}
+
+// 测试图片在文档内和文档之间去重
+TEST_F(WordDocumentTest, SharedImageStore) {
+    std::string docxPath = "test_image_store.docx";
+    std::string logo = std::string("\x89PNG\r\n\x1a\n", 8) + std::string(2000, 'L');
+    std::string drawing = "<w:p><w:r><w:drawing><wp:inline><a:graphic><a:graphicData><pic:pic><pic:blipFill>"
+                          "<a:blip r:embed=\"%\"/></pic:blipFill></pic:pic></a:graphicData></a:graphic>"
+                          "</wp:inline></w:drawing></w:r></w:p>";
+    std::string body;
+    for (const char* id : {"rId1", "rId2", "rId3"}) {
+        std::string p = drawing;
+        body += p.replace(p.find('%'), 1, id);
+    }
+    doc_converter::testing::ZipWriter writer;
+    writer.add("word/document.xml",
+        "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\""
+        " xmlns:wp=\"http://schemas.openxmlformats.org/drawingml/2006/wordprocessingDrawing\""
+        " xmlns:a=\"http://schemas.openxmlformats.org/drawingml/2006/main\""
+        " xmlns:pic=\"http://schemas.openxmlformats.org/drawingml/2006/picture\""
+        " xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+        "<w:body>" + body + "</w:body></w:document>");
+    std::string type = "http://schemas.openxmlformats.org/officeDocument/2006/relationships/image";
+    writer.add("word/_rels/document.xml.rels",
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+        "<Relationship Id=\"rId1\" Type=\"" + type + "\" Target=\"media/image1.png\"/>"
+        "<Relationship Id=\"rId2\" Type=\"" + type + "\" Target=\"media/image2.png\"/>"
+        "<Relationship Id=\"rId3\" Type=\"" + type + "\" Target=\"media/image3.png\"/>"
+        "</Relationships>");
+    writer.add("word/media/image1.png", logo);
+    writer.add("word/media/image2.png", logo);
+    writer.add("word/media/image3.png", logo + "x");
+    writer.writeTo(docxPath);
+
+    // 未设置存储时在文档内去重
+    WordDocument single;
+    ASSERT_TRUE(single.loadFromFile(docxPath));
+    ASSERT_EQ(single.getElements().size(), 3);
+    auto a = std::dynamic_pointer_cast<ImageElement>(single.getElements()[0]);
+    auto b = std::dynamic_pointer_cast<ImageElement>(single.getElements()[1]);
+    auto c = std::dynamic_pointer_cast<ImageElement>(single.getElements()[2]);
+    ASSERT_TRUE(a && b && c);
+    EXPECT_EQ(&a->getImageData(), &b->getImageData());
+    EXPECT_NE(&a->getImageData(), &c->getImageData());
+    EXPECT_EQ(a->getContentHash(), b->getContentHash());
+    EXPECT_NE(a->getContentHash(), c->getContentHash());
+
+    // 共享存储时跨文档去重
+    auto store = std::make_shared<ImageStore>();
+    WordDocument first;
+    WordDocument second;
+    first.setImageStore(store);
+    second.setImageStore(store);
+    second.setParseMode(ParseMode::Parallel);
+    ASSERT_TRUE(first.loadFromFile(docxPath));
+    ASSERT_TRUE(second.loadFromFile(docxPath));
+    std::filesystem::remove(docxPath);
+
+    auto firstImage = std::dynamic_pointer_cast<ImageElement>(first.getElements()[0]);
+    auto secondImage = std::dynamic_pointer_cast<ImageElement>(second.getElements()[1]);
+    ASSERT_TRUE(firstImage && secondImage);
+    EXPECT_EQ(&firstImage->getImageData(), &secondImage->getImageData());
+    EXPECT_EQ(std::string(firstImage->getImageData().begin(), firstImage->getImageData().end()), logo);
+    EXPECT_EQ(store->size(), 1);
+    EXPECT_EQ(store->dedupedBytes(), logo.size());
+}
@@ -0,0 +1,144 @@
+/**
+ * @file zip_archive_test.cpp
+ * @brief ZIP容器读取器的单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "doc_converter/zip_archive.hpp"
+#include "zip_test_util.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace doc_converter;
+
+class ZipArchiveTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        largeText_.reserve(300000);
+        for (int i = 0; i < 10000; ++i) {
+            largeText_ += "<w:p><w:r><w:t>Paragraph " + std::to_string(i) + "</w:t></w:r></w:p>";
+        }
+        doc_converter::testing::ZipWriter writer;
+        writer.add("[Content_Types].xml", "<Types/>", false);
+        writer.add("word/document.xml", largeText_);
+        writer.add("word/media/image1.png", std::string("\x89PNG\r\n\x1a\n", 8), false);
+        data_ = writer.finish();
+    }
+
+    std::string largeText_;
+    std::vector<uint8_t> data_;
+};
+
+// 测试中央目录解析
+TEST_F(ZipArchiveTest, ParseCentralDirectory) {
+    EXPECT_TRUE(ZipArchive::isZipData(data_.data(), data_.size()));
+
+    ZipArchive archive(data_);
+    ASSERT_EQ(archive.getEntries().size(), 3);
+    EXPECT_TRUE(archive.hasEntry("word/document.xml"));
+    EXPECT_TRUE(archive.hasEntry("/word/document.xml"));  // OPC部件名带前导'/'
+    EXPECT_FALSE(archive.hasEntry("word/styles.xml"));
+
+    const ZipEntry* entry = archive.findEntry("word/document.xml");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->method, 8);
+    EXPECT_EQ(entry->uncompressedSize, largeText_.size());
+    EXPECT_LT(entry->compressedSize, entry->uncompressedSize);
+}
+
+// 测试读取存储和压缩条目
+TEST_F(ZipArchiveTest, ReadEntry) {
+    ZipArchive archive(data_);
+
+    auto xml = archive.readEntry("word/document.xml");
+    EXPECT_EQ(std::string(xml.begin(), xml.end()), largeText_);
+
+    auto png = archive.readEntry("word/media/image1.png");
+    ASSERT_EQ(png.size(), 8);
+    EXPECT_EQ(png[1], 'P');
+}
+
+// 测试流式读取
+TEST_F(ZipArchiveTest, StreamEntry) {
+    ZipArchive archive(data_);
+
+    std::string streamed;
+    archive.readEntry("word/document.xml", [&](const char* data, size_t size) {
+        streamed.append(data, size);
+    });
+    EXPECT_EQ(streamed, largeText_);
+
+    // 小缓冲区逐块读取
+    auto reader = archive.openEntry("word/document.xml");
+    std::string chunked;
+    char buffer[100];
+    size_t n;
+    while ((n = reader->read(buffer, sizeof(buffer))) > 0) {
+        chunked.append(buffer, n);
+    }
+    EXPECT_EQ(chunked, largeText_);
+}
+
+// 测试错误处理
+TEST_F(ZipArchiveTest, ErrorHandling) {
+    ZipArchive archive(data_);
+    EXPECT_THROW(archive.openEntry("missing.xml"), std::runtime_error);
+
+    std::vector<uint8_t> notZip = {'<', 'x', 'm', 'l', '/', '>'};
+    EXPECT_FALSE(ZipArchive::isZipData(notZip.data(), notZip.size()));
+    EXPECT_THROW(ZipArchive{notZip}, std::runtime_error);
+
+    EXPECT_THROW(ZipArchive("nonexistent.zip"), std::runtime_error);
+
+    // 篡改存储条目内容，CRC校验应失败
+    std::vector<uint8_t> corrupted = data_;
+    const ZipEntry* entry = archive.findEntry("[Content_Types].xml");
+    ASSERT_NE(entry, nullptr);
+    corrupted[entry->localHeaderOffset + 30 + 19 + 1] ^= 0xFF;
+    ZipArchive corruptedArchive(corrupted);
+    EXPECT_THROW(corruptedArchive.readEntry("[Content_Types].xml"), std::runtime_error);
+}
+
+// 测试ZIP64定位记录指向文件之外时报错而不越界读取
+TEST_F(ZipArchiveTest, Zip64LocatorOutOfBounds) {
+    for (uint64_t offset : std::vector<uint64_t>{0xFFFFFFFFFFFFFFF0ull, data_.size(), 0}) {
+        // 中央目录结束记录的条目数改为0xFFFF，并在它之前插入ZIP64定位记录
+        std::vector<uint8_t> bytes = data_;
+        size_t eocd = bytes.size() - 22;
+        bytes[eocd + 8] = bytes[eocd + 9] = bytes[eocd + 10] = bytes[eocd + 11] = 0xFF;
+        std::vector<uint8_t> locator = {0x50, 0x4b, 0x06, 0x07, 0, 0, 0, 0};
+        for (int i = 0; i < 8; ++i) {
+            locator.push_back(static_cast<uint8_t>(offset >> (8 * i)));
+        }
+        locator.insert(locator.end(), {1, 0, 0, 0});
+        bytes.insert(bytes.begin() + static_cast<std::ptrdiff_t>(eocd), locator.begin(), locator.end());
+        EXPECT_THROW(ZipArchive{bytes}, std::runtime_error) << offset;
+    }
+}
+
+// 测试拒绝声明的解压大小超出压缩方法上限的条目（不按该大小分配缓冲区）
+TEST_F(ZipArchiveTest, ImplausibleEntrySize) {
+    // 改写中央目录中条目的解压大小字段
+    auto withUncompressedSize = [this](const std::string& name, uint32_t size) {
+        std::vector<uint8_t> bytes = data_;
+        for (size_t pos = 0; pos + 46 + name.size() <= bytes.size(); ++pos) {
+            if (bytes[pos] == 0x50 && bytes[pos + 1] == 0x4b && bytes[pos + 2] == 0x01 && bytes[pos + 3] == 0x02 &&
+                std::equal(name.begin(), name.end(), bytes.begin() + pos + 46)) {
+                for (int i = 0; i < 4; ++i) {
+                    bytes[pos + 24 + i] = static_cast<uint8_t>(size >> (8 * i));
+                }
+            }
+        }
+        return bytes;
+    };
+
+    ZipArchive inflated(withUncompressedSize("word/document.xml", 0xF0000000));
+    EXPECT_EQ(inflated.findEntry("word/document.xml")->uncompressedSize, 0xF0000000);
+    EXPECT_THROW(inflated.openEntry("word/document.xml"), std::runtime_error);
+    EXPECT_THROW(inflated.readEntry("word/document.xml"), std::runtime_error);
+
+    ZipArchive stored(withUncompressedSize("word/media/image1.png", 9));
+    EXPECT_THROW(stored.readEntry("word/media/image1.png"), std::runtime_error);
+    EXPECT_EQ(stored.readEntry("[Content_Types].xml").size(), 8);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file zip_test_util.hpp
+ * @brief 测试用的最小ZIP写入工具
+ *
+ * 用于在测试中生成.docx容器，避免依赖外部测试文件。
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+namespace doc_converter {
+namespace testing {
+
+/**
+ * @brief 最小ZIP写入器，支持存储和deflate两种方法
+ */
+class ZipWriter {
+public:
+    /**
+     * @brief 添加条目
+     * @param name 条目名
+     * @param content 条目内容
+     * @param compress 是否使用deflate压缩
+     */
+    void add(const std::string& name, const std::string& content, bool compress = true) {
+        std::string payload = content;
+        uint16_t method = 0;
+        if (compress) {
+            payload = deflateRaw(content);
+            method = 8;
+        }
+        uint32_t crc = static_cast<uint32_t>(
+            crc32(0, reinterpret_cast<const Bytef*>(content.data()), static_cast<uInt>(content.size())));
+
+        Entry entry{name, method, crc, static_cast<uint32_t>(payload.size()),
+                    static_cast<uint32_t>(content.size()), static_cast<uint32_t>(data_.size())};
+        put32(data_, 0x04034b50);
+        put16(data_, 20);
+        put16(data_, 0);
+        put16(data_, method);
+        put32(data_, 0);
+        put32(data_, crc);
+        put32(data_, entry.compressedSize);
+        put32(data_, entry.uncompressedSize);
+        put16(data_, static_cast<uint16_t>(name.size()));
+        put16(data_, 0);
+        data_.insert(data_.end(), name.begin(), name.end());
+        data_.insert(data_.end(), payload.begin(), payload.end());
+        entries_.push_back(entry);
+    }
+
+    /**
+     * @brief 生成完整的ZIP字节
+     * @return vector<uint8_t> ZIP数据
+     */
+    std::vector<uint8_t> finish() const {
+        std::vector<uint8_t> out = data_;
+        uint32_t cdOffset = static_cast<uint32_t>(out.size());
+        for (const auto& e : entries_) {
+            put32(out, 0x02014b50);
+            put16(out, 20);
+            put16(out, 20);
+            put16(out, 0);
+            put16(out, e.method);
+            put32(out, 0);
+            put32(out, e.crc);
+            put32(out, e.compressedSize);
+            put32(out, e.uncompressedSize);
+            put16(out, static_cast<uint16_t>(e.name.size()));
+            put16(out, 0);
+            put16(out, 0);
+            put16(out, 0);
+            put16(out, 0);
+            put32(out, 0);
+            put32(out, e.offset);
+            out.insert(out.end(), e.name.begin(), e.name.end());
+        }
+        uint32_t cdSize = static_cast<uint32_t>(out.size()) - cdOffset;
+        put32(out, 0x06054b50);
+        put16(out, 0);
+        put16(out, 0);
+        put16(out, static_cast<uint16_t>(entries_.size()));
+        put16(out, static_cast<uint16_t>(entries_.size()));
+        put32(out, cdSize);
+        put32(out, cdOffset);
+        put16(out, 0);
+        return out;
+    }
+
+    /**
+     * @brief 写入文件
+     * @param filePath 文件路径
+     */
+    void writeTo(const std::string& filePath) const {
+        std::vector<uint8_t> bytes = finish();
+        std::ofstream file(filePath, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+private:
+    struct Entry {
+        std::string name;
+        uint16_t method;
+        uint32_t crc;
+        uint32_t compressedSize;
+        uint32_t uncompressedSize;
+        uint32_t offset;
+    };
+
+    static void put16(std::vector<uint8_t>& out, uint16_t v) {
+        out.push_back(static_cast<uint8_t>(v));
+        out.push_back(static_cast<uint8_t>(v >> 8));
+    }
+
+    static void put32(std::vector<uint8_t>& out, uint32_t v) {
+        put16(out, static_cast<uint16_t>(v));
+        put16(out, static_cast<uint16_t>(v >> 16));
+    }
+
+    static std::string deflateRaw(const std::string& input) {
+        z_stream stream{};
+        deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+        std::string out(deflateBound(&stream, static_cast<uLong>(input.size())), '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+        stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        stream.avail_out = static_cast<uInt>(out.size());
+        deflate(&stream, Z_FINISH);
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        return out;
+    }
+
+    std::vector<uint8_t> data_;
+    std::vector<Entry> entries_;
+};
+
+} // namespace testing
+} // namespace doc_converter